@@ -0,0 +1,114 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include "pdmath/Animation.hpp"
+#include "pdmath/TransformHierarchy.hpp"
+
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+/*------------------------------------------------------------------------------
+    A character sized rig: joint_count joints with key_count keys each over
+    a two second clip, and a parent chain five joints deep. Ops are joints,
+    so ops/s reads as joints per second. Playback advances a 60Hz frame per
+    call and wraps, the way a looping clip is played, so the samplers step
+    keys forward and take the seek back at the loop point.
+------------------------------------------------------------------------------*/
+static constexpr std::size_t joint_count = 64;
+static constexpr std::size_t key_count   = 30;
+
+static AnimationClip make_clip() {
+    Lcg lcg(7);
+    AnimationClip clip;
+
+    std::vector<float> times(key_count);
+    std::vector<Vec3>  translations(key_count);
+    std::vector<Quat>  rotations(key_count);
+    std::vector<Vec3>  scales(key_count);
+
+    for(std::size_t joint = 0; joint < joint_count; ++joint) {
+        for(std::size_t key = 0; key < key_count; ++key) {
+            times[key] = 2.0f * static_cast<float>(key) /
+                         static_cast<float>(key_count - 1);
+            translations[key] = Vec3(lcg.uniform(-1.0f, 1.0f),
+                                     lcg.uniform(-1.0f, 1.0f),
+                                     lcg.uniform(-1.0f, 1.0f));
+            rotations[key] = Quat(lcg.uniform(-3.0f, 3.0f),
+                                  Vec3(lcg.uniform(-1.0f, 1.0f),
+                                       lcg.uniform(-1.0f, 1.0f),
+                                       lcg.uniform(0.1f, 1.0f)).normalized());
+            float scale = lcg.uniform(0.9f, 1.1f);
+            scales[key] = Vec3(scale, scale, scale);
+        }
+        clip.add_track(times, translations, rotations, scales);
+    }
+
+    return clip;
+}
+
+static float next_frame(float &time, const float duration) {
+    time += 1.0f / 60.0f;
+    if(time > duration) {
+        time = 0.0f;
+    }
+    return time;
+}
+
+PDMATH_BENCHMARK("animation", "AnimationSampler::sample") {
+    AnimationClip    clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    std::vector<Vec3> translations(joint_count);
+    std::vector<Quat> rotations(joint_count);
+    std::vector<Vec3> scales(joint_count);
+    float time = 0.0f;
+
+    run.measure(joint_count, [&] {
+        sampler.sample(next_frame(time, clip.duration()), translations,
+                       rotations, scales);
+        keep(rotations);
+    });
+}
+
+PDMATH_BENCHMARK("animation", "AnimationSampler::sample(Mat4)") {
+    AnimationClip    clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    std::vector<Mat4> locals(joint_count);
+    float time = 0.0f;
+
+    run.measure(joint_count, [&] {
+        sampler.sample(next_frame(time, clip.duration()), locals);
+        keep(locals);
+    });
+}
+
+PDMATH_BENCHMARK("animation", "TransformHierarchy::update") {
+    AnimationClip    clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    std::vector<Vec3> translations(joint_count);
+    std::vector<Quat> rotations(joint_count);
+    std::vector<Vec3> scales(joint_count);
+
+    TransformHierarchy hierarchy(1);
+    for(std::size_t joint = 0; joint < joint_count; ++joint) {
+        uint32_t parent = joint % 5 == 0
+                        ? TransformHierarchy::no_parent
+                        : static_cast<uint32_t>(joint - 1);
+        hierarchy.add_node(parent, Vec3::zero, Quat::identity, Vec3::one);
+    }
+    sampler.sample(0.5f, translations, rotations, scales);
+
+    // Every joint moves every frame, as it does during playback.
+    run.measure(joint_count, [&] {
+        for(uint32_t joint = 0; joint < joint_count; ++joint) {
+            hierarchy.set_local(joint, translations[joint], rotations[joint],
+                                scales[joint]);
+        }
+        hierarchy.update();
+        keep(hierarchy.world(joint_count - 1));
+    });
+}
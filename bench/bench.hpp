@@ -0,0 +1,151 @@
+#ifndef PDMATH_BENCH_HPP
+#define PDMATH_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PDMATH_BENCH_RDTSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PDMATH_BENCH_RDTSC 1
+#endif
+
+namespace pdm::bench {
+
+// Time stamp counter ticks, or 0 where there's no cheap cycle counter.
+inline uint64_t cycles() {
+#if defined(PDMATH_BENCH_RDTSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Makes value look used so the work that produced it isn't optimized away.
+template<typename T>
+inline void keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+struct Result {
+    std::string group;
+    std::string name;
+    std::size_t ops_per_call;
+    std::size_t calls_per_sample;
+
+    std::vector<double> ns_per_op;      // one entry per sample
+    std::vector<double> cycles_per_op;
+
+    double median_ns() const;
+    double median_cycles() const;
+    double ops_per_second() const { return 1e9 / median_ns(); }
+};
+
+/*------------------------------------------------------------------------------
+    Handed to every benchmark. Setup happens in the benchmark body; then
+    measure() takes a callable that does `ops` operations per call. The
+    call count per sample is grown until a sample lasts at least
+    min_sample_time, so short operations aren't lost in timer overhead.
+------------------------------------------------------------------------------*/
+class Run {
+public:
+    template<typename F>
+    void measure(const std::size_t ops, F &&body) {
+        using clock = std::chrono::steady_clock;
+
+        body();
+
+        std::size_t calls = 1;
+        for(;;) {
+            auto start = clock::now();
+            for(std::size_t i = 0; i < calls; ++i) {
+                body();
+            }
+            if(clock::now() - start >= _min_sample_time || calls >= max_calls) {
+                break;
+            }
+            calls *= 2;
+        }
+
+        _result.ops_per_call     = ops;
+        _result.calls_per_sample = calls;
+
+        double total_ops = static_cast<double>(calls * ops);
+
+        for(std::size_t s = 0; s < _samples; ++s) {
+            uint64_t first_cycle = cycles();
+            auto     start       = clock::now();
+
+            for(std::size_t i = 0; i < calls; ++i) {
+                body();
+            }
+
+            auto     end        = clock::now();
+            uint64_t last_cycle = cycles();
+
+            std::chrono::duration<double, std::nano> ns = end - start;
+            _result.ns_per_op.push_back(ns.count() / total_ops);
+            _result.cycles_per_op.push_back(
+                static_cast<double>(last_cycle - first_cycle) / total_ops);
+        }
+    }
+
+    const Result& result() const { return _result; }
+
+    Run(const std::string &group, const std::string &name,
+        const std::size_t samples,
+        const std::chrono::nanoseconds min_sample_time) :
+        _result{group, name, 0, 0, {}, {}},
+        _samples{samples},
+        _min_sample_time{min_sample_time}
+    { }
+
+private:
+    static constexpr std::size_t max_calls = std::size_t(1) << 24;
+
+    Result                   _result;
+    std::size_t              _samples;
+    std::chrono::nanoseconds _min_sample_time;
+};
+
+using Function = void (*)(Run &run);
+
+struct Benchmark {
+    const char *group;
+    const char *name;
+    Function    function;
+};
+
+std::vector<Benchmark>& registry();
+
+struct Registrar {
+    Registrar(const char *group, const char *name, Function function) {
+        registry().push_back({group, name, function});
+    }
+};
+
+} // namespace pdm::bench
+
+#define PDMATH_BENCH_CONCAT_(a, b) a##b
+#define PDMATH_BENCH_CONCAT(a, b)  PDMATH_BENCH_CONCAT_(a, b)
+
+// PDMATH_BENCHMARK("group", "name") { ...setup...; run.measure(n, [&] {}); }
+#define PDMATH_BENCHMARK(group, name)                                         \
+    static void PDMATH_BENCH_CONCAT(pdmath_bench_, __LINE__)(                 \
+        pdm::bench::Run &run);                                                \
+    static pdm::bench::Registrar PDMATH_BENCH_CONCAT(pdmath_reg_, __LINE__)(  \
+        group, name, &PDMATH_BENCH_CONCAT(pdmath_bench_, __LINE__));          \
+    static void PDMATH_BENCH_CONCAT(pdmath_bench_, __LINE__)(                 \
+        [[maybe_unused]] pdm::bench::Run &run)
+
+#endif // PDMATH_BENCH_HPP
@@ -0,0 +1,92 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+PDMATH_BENCHMARK("camera", "Camera::view") {
+    const Scene &s = scene();
+    std::size_t  n = s.point4s.size();
+    std::vector<Point4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.camera.view(s.point4s[i]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::persp_ndc") {
+    const Scene &s = scene();
+    std::size_t  n = s.point4s.size();
+    std::vector<Point4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.camera.persp_ndc(s.point4s[i]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::persp_screen") {
+    const Scene &s = scene();
+    std::size_t  n = s.point4s.size();
+    std::vector<Point4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.camera.persp_screen(s.point4s[i]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::ortho_screen") {
+    const Scene &s = scene();
+    std::size_t  n = s.point4s.size();
+    std::vector<Point4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.camera.ortho_screen(s.point4s[i]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::projected_bounds sphere") {
+    const Scene &s = scene();
+    std::vector<ScreenBounds> out(s.spheres.size());
+
+    run.measure(out.size(), [&] {
+        s.camera.projected_bounds(std::span<const BSphere>(s.spheres), out);
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::projected_bounds box") {
+    const Scene &s = scene();
+    std::vector<ScreenBounds> out(s.aabbs.size());
+
+    run.measure(out.size(), [&] {
+        s.camera.projected_bounds(std::span<const AABBox>(s.aabbs), out);
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("camera", "Camera::pick_ray") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            const Vec3 &v = s.vectors[i];
+            keep(s.camera.pick_ray((v._x + 1.0f) * 960.0f,
+                                   (v._y + 1.0f) * 540.0f));
+        }
+    });
+}
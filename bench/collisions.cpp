@@ -0,0 +1,296 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+using namespace pdm;
+using namespace pdm::bench;
+
+/*------------------------------------------------------------------------------
+    One benchmark per collides() overload. Each tests object i against
+    object i + 1 of the other kind, so the pairs are scattered over the
+    scene and hit and miss about as often as they would in a real frame.
+------------------------------------------------------------------------------*/
+
+PDMATH_BENCHMARK("collisions", "AABBox::collides(AABBox)") {
+    const Scene &s = scene();
+    std::size_t  n = s.aabbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.aabbs[i].collides(s.aabbs[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "AABBox::collides(BSphere)") {
+    const Scene &s = scene();
+    std::size_t  n = s.aabbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.aabbs[i].collides(s.spheres[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "AABBox::collides(Point3)") {
+    const Scene &s = scene();
+    std::size_t  n = s.aabbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.aabbs[i].collides(s.points[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "AABBox::collides(Point4)") {
+    const Scene &s = scene();
+    std::size_t  n = s.aabbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.aabbs[i].collides(s.point4s[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "AABBox::collides(Line)") {
+    const Scene &s = scene();
+    std::size_t  n = s.aabbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.aabbs[i].collides(s.lines[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(BSphere)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.spheres[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(Point3)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.points[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(Point4)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.point4s[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(AABBox)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.aabbs[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(OBBox)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.obbs[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(Plane)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.planes[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "BSphere::collides(Line)") {
+    const Scene &s = scene();
+    std::size_t  n = s.spheres.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.spheres[i].collides(s.lines[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "OBBox::collides(OBBox)") {
+    const Scene &s = scene();
+    std::size_t  n = s.obbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.obbs[i].collides(s.obbs[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "OBBox::collides(Point3)") {
+    const Scene &s = scene();
+    std::size_t  n = s.obbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.obbs[i].collides(s.points[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "OBBox::collides(BSphere)") {
+    const Scene &s = scene();
+    std::size_t  n = s.obbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.obbs[i].collides(s.spheres[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "OBBox::collides(Line)") {
+    const Scene &s = scene();
+    std::size_t  n = s.obbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.obbs[i].collides(s.lines[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "OBBox::collides(Plane)") {
+    const Scene &s = scene();
+    std::size_t  n = s.obbs.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.obbs[i].collides(s.planes[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "Line::collides(Line)") {
+    const Scene &s = scene();
+    std::size_t  n = s.lines.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.lines[i].collides(s.lines[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
+
+PDMATH_BENCHMARK("collisions", "Line::collides(Plane)") {
+    const Scene &s = scene();
+    std::size_t  n = s.lines.size();
+
+    run.measure(n - 1, [&] {
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            if(s.lines[i].collides(s.planes[i + 1])) {
+                ++hits;
+            }
+        }
+        keep(hits);
+    });
+}
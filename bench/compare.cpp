@@ -0,0 +1,371 @@
+#include "json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*------------------------------------------------------------------------------
+    bench_compare base.json head.json [--alpha p] [--threshold fraction]
+        Compares two runs of bench --json. Each benchmark's samples are put
+        through a two-sided Mann-Whitney U test; a change is flagged only if
+        it is significant at alpha (default 0.01) and the medians moved by
+        more than threshold (default 0.05). Exits with 1 if anything got
+        slower, so it can gate a build.
+
+    bench_compare --record history.jsonl run.json [--label text]
+        Appends the run's medians to a history file, one JSON object per
+        line. The label defaults to the one given to bench --label.
+
+    bench_compare --history history.jsonl [--filter text]
+        Prints every recorded median for the matching benchmarks and marks
+        the largest step between consecutive entries, which is where to
+        start bisecting.
+------------------------------------------------------------------------------*/
+namespace {
+
+using pdm::bench::Json;
+
+struct Series {
+    std::string         name;
+    double              median;
+    std::vector<double> samples;
+};
+
+bool read_file(const std::string &path, std::string &text) {
+    std::ifstream in(path);
+    if(!in) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+bool load_run(const std::string &path, std::string &label,
+              std::vector<Series> &series) {
+    std::string text;
+    if(!read_file(path, text)) {
+        std::cerr << "could not read " << path << "\n";
+        return false;
+    }
+
+    Json run = Json::parse(text);
+    const Json *benchmarks = run.find("benchmarks");
+    if(!benchmarks || benchmarks->type != Json::Type::array) {
+        std::cerr << path << " is not a bench --json file\n";
+        return false;
+    }
+
+    if(const Json *l = run.find("label")) {
+        label = l->string;
+    }
+
+    for(const Json &b : benchmarks->array) {
+        const Json *name    = b.find("name");
+        const Json *median  = b.find("ns_per_op");
+        const Json *samples = b.find("samples");
+        if(!name || !median) {
+            continue;
+        }
+
+        Series s{name->string, median->number, {}};
+        if(samples) {
+            for(const Json &v : samples->array) {
+                s.samples.push_back(v.number);
+            }
+        }
+        series.push_back(s);
+    }
+    return true;
+}
+
+/*------------------------------------------------------------------------------
+    Two-sided Mann-Whitney U with the normal approximation, average ranks
+    for ties, the tie correction on the variance and a continuity
+    correction. Fine from about eight samples a side, and bench takes 25
+    by default. Returns the p-value.
+------------------------------------------------------------------------------*/
+double mann_whitney(const std::vector<double> &a,
+                    const std::vector<double> &b) {
+    std::size_t n1 = a.size();
+    std::size_t n2 = b.size();
+    if(n1 == 0 || n2 == 0) {
+        return 1.0;
+    }
+
+    std::vector<std::pair<double, int>> all;
+    for(double v : a) {
+        all.emplace_back(v, 0);
+    }
+    for(double v : b) {
+        all.emplace_back(v, 1);
+    }
+    std::sort(all.begin(), all.end());
+
+    double rank_sum_a = 0.0;
+    double tie_term   = 0.0;
+    std::size_t n = all.size();
+
+    for(std::size_t i = 0; i < n;) {
+        std::size_t j = i;
+        while(j < n && all[j].first == all[i].first) {
+            ++j;
+        }
+        // Ranks i+1 .. j share their average.
+        double rank = 0.5 * static_cast<double>(i + 1 + j);
+        for(std::size_t k = i; k < j; ++k) {
+            if(all[k].second == 0) {
+                rank_sum_a += rank;
+            }
+        }
+        double t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double dn1 = static_cast<double>(n1);
+    double dn2 = static_cast<double>(n2);
+    double dn  = static_cast<double>(n);
+
+    double u     = rank_sum_a - dn1 * (dn1 + 1.0) / 2.0;
+    double mean  = dn1 * dn2 / 2.0;
+    double var   = dn1 * dn2 / 12.0 *
+                   ((dn + 1.0) - tie_term / (dn * (dn - 1.0)));
+    if(var <= 0.0) {
+        return 1.0;
+    }
+
+    double diff = std::abs(u - mean) - 0.5;
+    double z    = std::max(diff, 0.0) / std::sqrt(var);
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+int compare(const std::string &base_path, const std::string &head_path,
+            const double alpha, const double threshold) {
+    std::string base_label;
+    std::string head_label;
+    std::vector<Series> base;
+    std::vector<Series> head;
+
+    if(!load_run(base_path, base_label, base) ||
+       !load_run(head_path, head_label, head)) {
+        return 2;
+    }
+
+    std::printf("%-40s %12s %12s %9s %10s\n",
+                "benchmark", "base ns/op", "head ns/op", "change", "p");
+
+    int  regressions = 0;
+    bool few_samples = false;
+    for(const Series &h : head) {
+        auto b = std::find_if(base.begin(), base.end(),
+                              [&](const Series &s) {
+                                  return s.name == h.name;
+                              });
+        if(b == base.end()) {
+            std::printf("%-40s %12s %12.3f\n", h.name.c_str(), "-",
+                        h.median);
+            continue;
+        }
+
+        few_samples = few_samples || b->samples.size() < 8 ||
+                      h.samples.size() < 8;
+
+        double change = b->median > 0.0 ? h.median / b->median - 1.0 : 0.0;
+        double p      = mann_whitney(b->samples, h.samples);
+
+        const char *verdict = "";
+        if(p < alpha && std::abs(change) > threshold) {
+            verdict = change > 0.0 ? "  SLOWER" : "  faster";
+            regressions += change > 0.0 ? 1 : 0;
+        }
+
+        std::printf("%-40s %12.3f %12.3f %+8.1f%% %10.2g%s\n",
+                    h.name.c_str(), b->median, h.median, change * 100.0, p,
+                    verdict);
+    }
+
+    if(few_samples) {
+        std::printf("\nfewer than 8 samples on a side; p is only a rough "
+                    "guide, rerun with --samples 25\n");
+    }
+    std::printf("\n%d regression%s\n", regressions,
+                regressions == 1 ? "" : "s");
+    return regressions > 0 ? 1 : 0;
+}
+
+std::string escaped(const std::string &s) {
+    std::string out;
+    for(char c : s) {
+        if(c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+int record(const std::string &history_path, const std::string &run_path,
+           std::string label) {
+    std::string run_label;
+    std::vector<Series> series;
+    if(!load_run(run_path, run_label, series)) {
+        return 2;
+    }
+    if(label.empty()) {
+        label = run_label;
+    }
+
+    std::ofstream out(history_path, std::ios::app);
+    if(!out) {
+        std::cerr << "could not open " << history_path << "\n";
+        return 2;
+    }
+
+    out.precision(9);
+    out << "{\"label\": \"" << escaped(label) << "\", \"time\": "
+        << static_cast<long long>(std::time(nullptr)) << ", \"medians\": {";
+    for(std::size_t i = 0; i < series.size(); ++i) {
+        out << (i ? ", " : "") << "\"" << escaped(series[i].name)
+            << "\": " << series[i].median;
+    }
+    out << "}}\n";
+
+    std::printf("recorded %zu benchmarks as \"%s\"\n", series.size(),
+                label.c_str());
+    return 0;
+}
+
+int history(const std::string &history_path, const std::string &filter) {
+    std::ifstream in(history_path);
+    if(!in) {
+        std::cerr << "could not read " << history_path << "\n";
+        return 2;
+    }
+
+    std::vector<Json> entries;
+    std::string line;
+    while(std::getline(in, line)) {
+        Json entry = Json::parse(line);
+        if(entry.find("medians")) {
+            entries.push_back(entry);
+        }
+    }
+
+    // Benchmark names in the order they first appear.
+    std::vector<std::string> names;
+    for(const Json &e : entries) {
+        for(const auto &[name, value] : e.find("medians")->object) {
+            if(name.find(filter) != std::string::npos &&
+               std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(name);
+            }
+        }
+    }
+
+    for(const std::string &name : names) {
+        std::printf("%s\n", name.c_str());
+
+        double      previous    = 0.0;
+        double      worst_step  = 0.0;
+        std::size_t worst_entry = 0;
+        std::vector<std::pair<std::string, double>> rows;
+
+        for(const Json &e : entries) {
+            const Json *median = e.find("medians")->find(name);
+            if(!median) {
+                continue;
+            }
+            const Json *label = e.find("label");
+            rows.emplace_back(label ? label->string : "", median->number);
+
+            if(previous > 0.0) {
+                double step = std::abs(median->number / previous - 1.0);
+                if(step > worst_step) {
+                    worst_step  = step;
+                    worst_entry = rows.size() - 1;
+                }
+            }
+            previous = median->number;
+        }
+
+        for(std::size_t i = 0; i < rows.size(); ++i) {
+            std::printf("    %-24s %12.3f ns/op%s\n", rows[i].first.c_str(),
+                        rows[i].second,
+                        i == worst_entry && worst_step > 0.0
+                            ? "  <- largest step" : "");
+        }
+    }
+    return 0;
+}
+
+void usage(const char *program) {
+    std::cerr << "usage: " << program
+              << " base.json head.json [--alpha p] [--threshold fraction]\n"
+              << "       " << program
+              << " --record history.jsonl run.json [--label text]\n"
+              << "       " << program
+              << " --history history.jsonl [--filter text]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<std::string> positional;
+    std::string mode;
+    std::string history_path;
+    std::string label;
+    std::string filter;
+    double      alpha     = 0.01;
+    double      threshold = 0.05;
+
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value  = i + 1 < argc;
+
+        if((arg == "--record" || arg == "--history") && has_value) {
+            mode         = arg;
+            history_path = argv[++i];
+        }
+        else if(arg == "--label" && has_value) {
+            label = argv[++i];
+        }
+        else if(arg == "--filter" && has_value) {
+            filter = argv[++i];
+        }
+        else if(arg == "--alpha" && has_value) {
+            alpha = std::strtod(argv[++i], nullptr);
+        }
+        else if(arg == "--threshold" && has_value) {
+            threshold = std::strtod(argv[++i], nullptr);
+        }
+        else if(arg.rfind("--", 0) == 0) {
+            usage(argv[0]);
+            return 2;
+        }
+        else {
+            positional.push_back(arg);
+        }
+    }
+
+    if(mode == "--record" && positional.size() == 1) {
+        return record(history_path, positional[0], label);
+    }
+    if(mode == "--history" && positional.empty()) {
+        return history(history_path, filter);
+    }
+    if(mode.empty() && positional.size() == 2) {
+        return compare(positional[0], positional[1], alpha, threshold);
+    }
+
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,156 @@
+#ifndef PDMATH_BENCH_JSON_HPP
+#define PDMATH_BENCH_JSON_HPP
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pdm::bench {
+
+/*------------------------------------------------------------------------------
+    Just enough JSON to read back what bench writes: objects, arrays,
+    strings, numbers and literals, no \u escapes. parse() gives a null
+    value on malformed input rather than failing halfway.
+------------------------------------------------------------------------------*/
+struct Json {
+    enum class Type {
+        null,
+        boolean,
+        number,
+        string,
+        array,
+        object
+    };
+
+    Type        type = Type::null;
+    bool        boolean = false;
+    double      number = 0.0;
+    std::string string;
+
+    std::vector<Json>           array;
+    std::map<std::string, Json> object;
+
+    const Json* find(const std::string &key) const {
+        auto it = object.find(key);
+        return it == object.end() ? nullptr : &it->second;
+    }
+
+    static Json parse(const std::string &text) {
+        std::size_t pos = 0;
+        bool ok = true;
+        Json value = parse_value(text, pos, ok);
+        skip_space(text, pos);
+        return ok && pos == text.size() ? value : Json();
+    }
+
+private:
+    static void skip_space(const std::string &t, std::size_t &pos) {
+        while(pos < t.size() &&
+              std::isspace(static_cast<unsigned char>(t[pos]))) {
+            ++pos;
+        }
+    }
+
+    static bool consume(const std::string &t, std::size_t &pos,
+                        const char c) {
+        skip_space(t, pos);
+        if(pos < t.size() && t[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    static std::string parse_string(const std::string &t, std::size_t &pos,
+                                    bool &ok) {
+        std::string s;
+        if(!consume(t, pos, '"')) {
+            ok = false;
+            return s;
+        }
+        while(pos < t.size() && t[pos] != '"') {
+            if(t[pos] == '\\' && pos + 1 < t.size()) {
+                ++pos;
+                char e = t[pos];
+                s += e == 'n' ? '\n' : e == 't' ? '\t' : e;
+            }
+            else {
+                s += t[pos];
+            }
+            ++pos;
+        }
+        ok = ok && pos < t.size();
+        ++pos;
+        return s;
+    }
+
+    static Json parse_value(const std::string &t, std::size_t &pos,
+                            bool &ok) {
+        Json v;
+        skip_space(t, pos);
+        if(!ok || pos >= t.size()) {
+            ok = false;
+            return v;
+        }
+
+        char c = t[pos];
+        if(c == '{') {
+            v.type = Type::object;
+            ++pos;
+            if(consume(t, pos, '}')) {
+                return v;
+            }
+            do {
+                std::string key = parse_string(t, pos, ok);
+                if(!consume(t, pos, ':')) {
+                    ok = false;
+                    return v;
+                }
+                v.object[key] = parse_value(t, pos, ok);
+            } while(ok && consume(t, pos, ','));
+            ok = ok && consume(t, pos, '}');
+        }
+        else if(c == '[') {
+            v.type = Type::array;
+            ++pos;
+            if(consume(t, pos, ']')) {
+                return v;
+            }
+            do {
+                v.array.push_back(parse_value(t, pos, ok));
+            } while(ok && consume(t, pos, ','));
+            ok = ok && consume(t, pos, ']');
+        }
+        else if(c == '"') {
+            v.type   = Type::string;
+            v.string = parse_string(t, pos, ok);
+        }
+        else if(t.compare(pos, 4, "true") == 0 ||
+                t.compare(pos, 5, "false") == 0) {
+            v.type    = Type::boolean;
+            v.boolean = c == 't';
+            pos += v.boolean ? 4 : 5;
+        }
+        else if(t.compare(pos, 4, "null") == 0) {
+            pos += 4;
+        }
+        else {
+            const char *start = t.c_str() + pos;
+            char *end = nullptr;
+            v.type   = Type::number;
+            v.number = std::strtod(start, &end);
+            if(end == start) {
+                ok = false;
+            }
+            pos += static_cast<std::size_t>(end - start);
+        }
+        return v;
+    }
+};
+
+} // namespace pdm::bench
+
+#endif // PDMATH_BENCH_JSON_HPP
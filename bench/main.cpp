@@ -0,0 +1,172 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*------------------------------------------------------------------------------
+    bench [--filter text] [--samples n] [--min-time ms] [--json file]
+          [--label text] [--list]
+
+    Runs every registered benchmark whose "group/name" contains the filter
+    and prints median ns/op, throughput and cycles/op. With --json the
+    per-sample timings are written too, which is what bench_compare reads.
+------------------------------------------------------------------------------*/
+namespace pdm::bench {
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+static double median(std::vector<double> values) {
+    if(values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    std::size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid]
+                             : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+double Result::median_ns() const     { return median(ns_per_op);     }
+double Result::median_cycles() const { return median(cycles_per_op); }
+
+static std::string escaped(const std::string &s) {
+    std::string out;
+    for(char c : s) {
+        if(c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+static void write_samples(std::ostream &os, const std::vector<double> &v) {
+    os << "[";
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        os << (i ? ", " : "") << v[i];
+    }
+    os << "]";
+}
+
+static bool write_json(const std::string &path, const std::string &label,
+                       const std::vector<Result> &results) {
+    std::ofstream os(path);
+    if(!os) {
+        return false;
+    }
+
+    os.precision(9);
+    os << "{\n"
+       << "  \"label\": \"" << escaped(label) << "\",\n"
+       << "  \"threads\": " << std::thread::hardware_concurrency() << ",\n"
+#if defined(__VERSION__)
+       << "  \"compiler\": \"" << escaped(__VERSION__) << "\",\n"
+#endif
+       << "  \"benchmarks\": [\n";
+
+    for(std::size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        os << "    {\n"
+           << "      \"name\": \"" << escaped(r.group + "/" + r.name)
+           << "\",\n"
+           << "      \"ns_per_op\": " << r.median_ns() << ",\n"
+           << "      \"ops_per_second\": " << r.ops_per_second() << ",\n"
+           << "      \"cycles_per_op\": " << r.median_cycles() << ",\n"
+           << "      \"ops_per_sample\": "
+           << r.ops_per_call * r.calls_per_sample << ",\n"
+           << "      \"samples\": ";
+        write_samples(os, r.ns_per_op);
+        os << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    os << "  ]\n}\n";
+    return static_cast<bool>(os);
+}
+
+} // namespace pdm::bench
+
+int main(int argc, char **argv) {
+    using namespace pdm::bench;
+
+    std::string filter;
+    std::string json_path;
+    std::string label;
+    std::size_t samples     = 25;
+    double      min_time_ms = 2.0;
+    bool        list_only   = false;
+
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value  = i + 1 < argc;
+
+        if(arg == "--filter" && has_value) {
+            filter = argv[++i];
+        }
+        else if(arg == "--samples" && has_value) {
+            samples = std::max<std::size_t>(
+                1, std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if(arg == "--min-time" && has_value) {
+            min_time_ms = std::strtod(argv[++i], nullptr);
+        }
+        else if(arg == "--json" && has_value) {
+            json_path = argv[++i];
+        }
+        else if(arg == "--label" && has_value) {
+            label = argv[++i];
+        }
+        else if(arg == "--list") {
+            list_only = true;
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--filter text]"
+                      << " [--samples n] [--min-time ms] [--json file]"
+                      << " [--label text] [--list]\n";
+            return 1;
+        }
+    }
+
+    auto min_time = std::chrono::nanoseconds(
+        static_cast<long long>(min_time_ms * 1e6));
+
+    std::vector<Result> results;
+
+    std::printf("%-40s %12s %14s %12s\n",
+                "benchmark", "ns/op", "ops/s", "cycles/op");
+
+    for(const Benchmark &b : registry()) {
+        std::string full_name = std::string(b.group) + "/" + b.name;
+        if(full_name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if(list_only) {
+            std::printf("%s\n", full_name.c_str());
+            continue;
+        }
+
+        Run run(b.group, b.name, samples, min_time);
+        b.function(run);
+
+        const Result &r = run.result();
+        std::printf("%-40s %12.3f %14.4g %12.2f\n", full_name.c_str(),
+                    r.median_ns(), r.ops_per_second(), r.median_cycles());
+        results.push_back(r);
+    }
+
+    if(!json_path.empty() && !write_json(json_path, label, results)) {
+        std::cerr << "could not write " << json_path << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+PDMATH_BENCHMARK("matrices", "Mat3 * Mat3") {
+    const Scene &s = scene();
+    std::size_t  n = s.rotations.size();
+    std::vector<Mat3> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.rotations[i] * s.rotations[i + 1];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat3::inverted") {
+    const Scene &s = scene();
+    std::size_t  n = s.rotations.size();
+    std::vector<Mat3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.rotations[i].inverted();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat3::populate_rotation") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+    std::vector<Mat3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            const Vec3 &a = s.vectors[i];
+            out[i] = Mat3::populate_rotation(a._x, a._y, a._z);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat3::populate_rotations batch") {
+    const Scene &s = scene();
+    std::vector<Mat3> out(s.vectors.size());
+
+    run.measure(out.size(), [&] {
+        Mat3::populate_rotations(s.vectors, out);
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4 * Mat4") {
+    const Scene &s = scene();
+    std::size_t  n = s.transforms.size();
+    std::vector<Mat4> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.transforms[i] * s.transforms[i + 1];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4::inverted") {
+    const Scene &s = scene();
+    std::size_t  n = s.transforms.size();
+    std::vector<Mat4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.transforms[i].inverted();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4::inverted_trs") {
+    const Scene &s = scene();
+    std::size_t  n = s.transforms.size();
+    std::vector<Mat4> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.transforms[i].inverted_trs();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4 * Point4") {
+    const Scene &s = scene();
+    std::size_t  n = s.point4s.size();
+    std::vector<Point4> out(n);
+    const Mat4 &m = s.transforms[0];
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = m * s.point4s[i];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4::transform batch") {
+    const Scene &s = scene();
+    std::vector<Point4> out(s.point4s.size());
+    const Mat4 &m = s.transforms[0];
+
+    run.measure(out.size(), [&] {
+        m.transform(s.point4s, out);
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Mat4 * Point3") {
+    const Scene &s = scene();
+    std::size_t  n = s.points.size();
+    std::vector<Point3> out(n);
+    const Mat4 &m = s.transforms[0];
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = m * s.points[i];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Affine3 * Affine3") {
+    const Scene &s = scene();
+    std::size_t  n = s.affines.size();
+    std::vector<Affine3> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.affines[i] * s.affines[i + 1];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Affine3::inverted") {
+    const Scene &s = scene();
+    std::size_t  n = s.affines.size();
+    std::vector<Affine3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.affines[i].inverted();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("matrices", "Affine3 * Point3") {
+    const Scene &s = scene();
+    std::size_t  n = s.points.size();
+    std::vector<Point3> out(n);
+    const Affine3 &m = s.affines[0];
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = m * s.points[i];
+        }
+        keep(out);
+    });
+}
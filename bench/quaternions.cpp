@@ -0,0 +1,95 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+PDMATH_BENCHMARK("quaternions", "Quat * Quat") {
+    const Scene &s = scene();
+    std::size_t  n = s.quats.size();
+    std::vector<Quat> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.quats[i] * s.quats[i + 1];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::rotate") {
+    const Scene &s = scene();
+    std::size_t  n = s.quats.size();
+    std::vector<Vec3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.quats[i].rotate(s.vectors[i]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::rotate batch") {
+    const Scene &s = scene();
+    std::vector<Vec3> out(s.quats.size());
+
+    run.measure(out.size(), [&] {
+        Quat::rotate(s.quats, s.vectors, out);
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::slerp") {
+    const Scene &s = scene();
+    std::size_t  n = s.quats.size();
+    std::vector<Quat> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = Quat::slerp(s.quats[i], s.quats[i + 1], 0.3f);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::nlerp") {
+    const Scene &s = scene();
+    std::size_t  n = s.quats.size();
+    std::vector<Quat> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = Quat::nlerp(s.quats[i], s.quats[i + 1], 0.3f);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::to_mat3") {
+    const Scene &s = scene();
+    std::size_t  n = s.quats.size();
+    std::vector<Mat3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.quats[i].to_mat3();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("quaternions", "Quat::from_mat3") {
+    const Scene &s = scene();
+    std::size_t  n = s.rotations.size();
+    std::vector<Quat> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = Quat::from_mat3(s.rotations[i]);
+        }
+        keep(out);
+    });
+}
@@ -0,0 +1,128 @@
+#ifndef PDMATH_BENCH_SCENE_HPP
+#define PDMATH_BENCH_SCENE_HPP
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Vector4.hpp"
+#include "pdmath/Point3.hpp"
+#include "pdmath/Point4.hpp"
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Affine3.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/OBBox.hpp"
+#include "pdmath/Plane.hpp"
+#include "pdmath/Line.hpp"
+#include "pdmath/Camera.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+namespace pdm::bench {
+
+// Numerical Recipes LCG. Not a good generator, but the same on every
+// platform and standard library, which <random> distributions aren't.
+class Lcg {
+public:
+    uint32_t next() {
+        _state = _state * 1664525u + 1013904223u;
+        return _state;
+    }
+
+    // Uniform in [lo, hi), from the top 24 bits.
+    float uniform(const float lo, const float hi) {
+        float unit = static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+        return lo + (hi - lo) * unit;
+    }
+
+    explicit Lcg(const uint32_t seed) : _state{seed} { }
+
+private:
+    uint32_t _state;
+};
+
+/*------------------------------------------------------------------------------
+    Inputs for every benchmark, generated from a fixed seed so two runs
+    (or two machines) always measure the same data. Objects are spread
+    over a 200 unit cube around the camera, so the collision tests see a
+    realistic mix of hits and misses instead of always taking one branch.
+------------------------------------------------------------------------------*/
+struct Scene {
+    static constexpr std::size_t default_count = 1024;
+
+    std::vector<Vec3>    vectors;
+    std::vector<Vec4>    vector4s;
+    std::vector<Point3>  points;
+    std::vector<Point4>  point4s;
+    std::vector<Mat3>    rotations;
+    std::vector<Mat4>    transforms;
+    std::vector<Affine3> affines;
+    std::vector<Quat>    quats;
+    std::vector<BSphere> spheres;
+    std::vector<AABBox>  aabbs;
+    std::vector<OBBox>   obbs;
+    std::vector<Plane>   planes;
+    std::vector<Line>    lines;
+
+    Camera camera;
+
+    explicit Scene(const std::size_t count = default_count,
+                   const uint32_t seed = 42) {
+        Lcg lcg(seed);
+        auto coordinate = [&lcg] { return lcg.uniform(-100.0f, 100.0f); };
+        auto angle = [&lcg] {
+            return lcg.uniform(-std::numbers::pi_v<float>,
+                                std::numbers::pi_v<float>);
+        };
+
+        for(std::size_t i = 0; i < count; ++i) {
+            Point3 p(coordinate(), coordinate(), coordinate());
+            Vec3   v(lcg.uniform(-1.0f, 1.0f), lcg.uniform(-1.0f, 1.0f),
+                     lcg.uniform(0.1f, 1.0f));
+
+            Mat3 rotation = Mat3::populate_rotation(angle(), angle(),
+                                                    angle());
+            Mat4 world(rotation);
+            float scale = lcg.uniform(0.5f, 4.0f);
+            world.apply_scale(Vec3(scale, scale, scale));
+            world.set_translation(Vec3(p));
+
+            float  half = lcg.uniform(1.0f, 10.0f);
+            Point3 min(p._x - half, p._y - half, p._z - half);
+            Point3 max(p._x + half, p._y + half, p._z + half);
+
+            vectors.push_back(v);
+            vector4s.emplace_back(v._x, v._y, v._z, 0.0f);
+            points.push_back(p);
+            point4s.emplace_back(p._x, p._y, p._z, 1.0f);
+            rotations.push_back(rotation);
+            transforms.push_back(world);
+            affines.emplace_back(world);
+            quats.push_back(Quat(angle(), v.normalized()));
+            spheres.emplace_back(Point3(0.0f, 0.0f, 0.0f), half, world);
+            aabbs.emplace_back(min, max);
+            obbs.emplace_back(Point3(-half, -half, -half),
+                              Point3(half, half, half), world);
+            planes.emplace_back(p, v.normalized());
+            lines.emplace_back(p, v);
+        }
+
+        camera = Camera(Vec3(0.0f, 0.0f, 150.0f), Vec3(0.0f, 0.0f, 0.0f),
+                        Vec3(0.0f, 1.0f, 0.0f));
+        camera.set_persp(1.0f, 1000.0f, 1920.0f, 1080.0f,
+                         std::numbers::pi_v<float> / 3.0f, 1.0f);
+    }
+};
+
+// Built on first use and shared, so every benchmark sees the same data.
+inline const Scene& scene() {
+    static const Scene s;
+    return s;
+}
+
+} // namespace pdm::bench
+
+#endif // PDMATH_BENCH_SCENE_HPP
@@ -0,0 +1,107 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include "pdmath/Skinning.hpp"
+#include "pdmath/DualQuaternion.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+/*------------------------------------------------------------------------------
+    A mesh of vertex_count vertices bound to a bone_count bone palette with
+    all four influences in use, which is the most work a vertex can take.
+    Ops are vertices; joints/s for the palette side is what the animation
+    benchmarks report.
+------------------------------------------------------------------------------*/
+namespace {
+
+constexpr std::size_t vertex_count = 4096;
+constexpr std::size_t bone_count   = 64;
+
+struct Mesh {
+    std::vector<float>    x, y, z;
+    std::vector<uint16_t> bones[max_influences];
+    std::vector<float>    weights[max_influences];
+
+    std::vector<float> out_x, out_y, out_z;
+
+    std::vector<Mat4>     matrices;
+    std::vector<DualQuat> dual_quats;
+
+    Mesh() {
+        Lcg lcg(11);
+
+        for(std::size_t i = 0; i < vertex_count; ++i) {
+            x.push_back(lcg.uniform(-1.0f, 1.0f));
+            y.push_back(lcg.uniform(0.0f, 2.0f));
+            z.push_back(lcg.uniform(-1.0f, 1.0f));
+
+            float total = 0.0f;
+            float w[max_influences];
+            for(std::size_t j = 0; j < max_influences; ++j) {
+                w[j] = lcg.uniform(0.1f, 1.0f);
+                total += w[j];
+            }
+            for(std::size_t j = 0; j < max_influences; ++j) {
+                bones[j].push_back(
+                    static_cast<uint16_t>(lcg.next() % bone_count));
+                weights[j].push_back(w[j] / total);
+            }
+        }
+
+        out_x.resize(vertex_count);
+        out_y.resize(vertex_count);
+        out_z.resize(vertex_count);
+
+        for(std::size_t i = 0; i < bone_count; ++i) {
+            Quat rotation(lcg.uniform(-1.0f, 1.0f),
+                          Vec3(lcg.uniform(-1.0f, 1.0f),
+                               lcg.uniform(-1.0f, 1.0f),
+                               lcg.uniform(0.1f, 1.0f)).normalized());
+            Vec3 translation(lcg.uniform(-0.5f, 0.5f),
+                             lcg.uniform(-0.5f, 0.5f),
+                             lcg.uniform(-0.5f, 0.5f));
+
+            Mat4 matrix = rotation.to_mat4();
+            matrix.set_translation(translation);
+            matrices.push_back(matrix);
+            dual_quats.emplace_back(rotation, translation);
+        }
+    }
+
+    SkinStream in() const {
+        return SkinStream{x, y, z,
+                          {bones[0], bones[1], bones[2], bones[3]},
+                          {weights[0], weights[1], weights[2], weights[3]}};
+    }
+
+    SkinnedStream out() {
+        return SkinnedStream{out_x, out_y, out_z};
+    }
+};
+
+} // namespace
+
+PDMATH_BENCHMARK("skinning", "skin_linear") {
+    Mesh mesh;
+
+    run.measure(vertex_count, [&] {
+        AABBox bounds = skin_linear(mesh.in(), mesh.matrices, mesh.out());
+        keep(bounds);
+        keep(mesh.out_x);
+    });
+}
+
+PDMATH_BENCHMARK("skinning", "skin_dual_quat") {
+    Mesh mesh;
+
+    run.measure(vertex_count, [&] {
+        AABBox bounds = skin_dual_quat(mesh.in(), mesh.dual_quats,
+                                       mesh.out());
+        keep(bounds);
+        keep(mesh.out_x);
+    });
+}
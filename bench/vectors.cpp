@@ -0,0 +1,135 @@
+#include "bench.hpp"
+#include "scene.hpp"
+
+#include "pdmath/Vector.hpp"
+#include "pdmath/Vec3Stream.hpp"
+
+#include <vector>
+
+using namespace pdm;
+using namespace pdm::bench;
+
+PDMATH_BENCHMARK("vectors", "Vec3::dot") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+
+    run.measure(n - 1, [&] {
+        float sum = 0.0f;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            sum += s.vectors[i].dot(s.vectors[i + 1]);
+        }
+        keep(sum);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3::cross") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+    std::vector<Vec3> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.vectors[i].cross(s.vectors[i + 1]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3::length") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+
+    run.measure(n, [&] {
+        float sum = 0.0f;
+        for(const Vec3 &v : s.vectors) {
+            sum += v.length();
+        }
+        keep(sum);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3::normalized") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+    std::vector<Vec3> out(n);
+
+    run.measure(n, [&] {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = s.vectors[i].normalized();
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3::normalize high") {
+    const Scene &s = scene();
+    std::vector<Vec3> v = s.vectors;
+
+    run.measure(v.size(), [&] {
+        Vec3::normalize(v, Accuracy::high);
+        keep(v);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3::project_onto") {
+    const Scene &s = scene();
+    std::size_t  n = s.vectors.size();
+    std::vector<Vec3> out(n);
+
+    run.measure(n - 1, [&] {
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            out[i] = s.vectors[i].project_onto(s.vectors[i + 1]);
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec4::dot") {
+    const Scene &s = scene();
+    std::size_t  n = s.vector4s.size();
+
+    run.measure(n - 1, [&] {
+        float sum = 0.0f;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            sum += s.vector4s[i].dot(s.vector4s[i + 1]);
+        }
+        keep(sum);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec4f add") {
+    const Scene &s = scene();
+    std::vector<Vec4f> v;
+    for(const Vec4 &u : s.vector4s) {
+        v.emplace_back(u._x, u._y, u._z, u._w);
+    }
+    std::vector<Vec4f> out(v.size());
+
+    run.measure(v.size() - 1, [&] {
+        for(std::size_t i = 0; i + 1 < v.size(); ++i) {
+            out[i] = v[i] + v[i + 1];
+        }
+        keep(out);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3Stream::normalize") {
+    const Scene &s = scene();
+    Vec3Stream stream(s.vectors);
+
+    run.measure(stream.size(), [&] {
+        stream.normalize();
+        keep(stream);
+    });
+}
+
+PDMATH_BENCHMARK("vectors", "Vec3Stream::transform_points") {
+    const Scene &s = scene();
+    Vec3Stream stream(s.vectors);
+    const Mat4 &m = s.transforms[0];
+
+    run.measure(stream.size(), [&] {
+        stream.transform_points(m);
+        keep(stream);
+    });
+}
@@ -0,0 +1,74 @@
+#ifndef PDMATH_AFFINE3_HPP
+#define PDMATH_AFFINE3_HPP
+
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include <iostream>
+
+namespace pdm {
+class Point3;
+class Point4;
+class Vec3;
+
+/*------------------------------------------------------------------------------
+    The top three rows of an affine Mat4: a 3x3 linear part in columns 0-2
+    and the translation in column 3. The bottom row is always 0 0 0 1, so
+    it isn't stored and no product ever touches it, which makes this 48
+    bytes against 64 and saves a quarter of the work in every compose or
+    transform. Rows use the same layout as Mat4's, so converting either
+    way is a copy of the first twelve floats.
+------------------------------------------------------------------------------*/
+class alignas(16) Affine3 {
+public:
+    static const Affine3 identity;
+
+    Affine3 inverted() const;
+    Affine3 inverted_trs() const;
+
+    Mat4 to_mat4() const;
+    Mat3 linear()  const;
+
+    Vec3  get_world_position() const;
+    Vec3  get_x_vec() const;
+    float get_x_scale() const;
+    float get_y_scale() const;
+    float get_z_scale() const;
+
+    const Affine3& set_translation(const Vec3 &v);
+    const Affine3& apply_scale(const Vec3 &v);
+
+    float _m[3][4];
+
+    Affine3() noexcept:
+        _m{{0}, {0}, {0}}
+    { }
+
+    Affine3(const float x1, const float y1, const float z1, const float w1,
+            const float x2, const float y2, const float z2, const float w2,
+            const float x3, const float y3, const float z3, const float w3)
+            noexcept;
+
+    Affine3(const Mat3 &linear, const Vec3 &translation) noexcept;
+
+    // Drops the bottom row, so only pass a Mat4 that is affine.
+    explicit Affine3(const Mat4 &m) noexcept;
+
+    bool operator==(const Affine3 &a) const;
+
+    const Affine3& operator*=(const Affine3 &a);
+};
+
+Affine3 operator*(const Affine3 &a, const Affine3 &b);
+
+Point3 operator*(const Affine3 &a, const Point3 &p);
+Vec3   operator*(const Affine3 &a, const Vec3 &v);
+Point4 operator*(const Affine3 &a, const Point4 &p);
+
+std::ostream& operator<<(std::ostream &os, const Affine3 &a);
+
+static_assert(sizeof(Affine3) == 12 * sizeof(float),
+              "Affine3 must stay twelve packed floats");
+} // namespace pdm
+
+#endif // PDMATH_AFFINE3_HPP
@@ -0,0 +1,103 @@
+#ifndef PDMATH_ANIMATION_HPP
+#define PDMATH_ANIMATION_HPP
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    Keyframes for a set of tracks (usually one per joint). Each track keys
+    translation, rotation and scale together at the same times. All tracks
+    are packed end to end in one structure-of-arrays block, one array per
+    component. A track added with no keys gets a single identity key, so
+    every track has something to sample.
+------------------------------------------------------------------------------*/
+class AnimationClip {
+public:
+    uint32_t add_track(std::span<const float> times,
+                       std::span<const Vec3>  translations,
+                       std::span<const Quat>  rotations,
+                       std::span<const Vec3>  scales);
+
+    inline std::size_t track_count() const { return _tracks.size(); }
+    inline std::size_t key_count()   const { return _times.size();  }
+    inline float       duration()    const { return _duration;      }
+
+    AnimationClip() noexcept;
+
+private:
+    friend class AnimationSampler;
+
+    struct Track {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    std::vector<Track> _tracks;
+    std::vector<float> _times;
+
+    std::vector<float> _tx;
+    std::vector<float> _ty;
+    std::vector<float> _tz;
+
+    std::vector<float> _rw;
+    std::vector<float> _rx;
+    std::vector<float> _ry;
+    std::vector<float> _rz;
+
+    std::vector<float> _sx;
+    std::vector<float> _sy;
+    std::vector<float> _sz;
+
+    float _duration;
+};
+
+/*------------------------------------------------------------------------------
+    Samples every track of a clip at once. Each track remembers the key pair
+    it used last, so playing forward only ever steps a key or two; jumping
+    backward falls back to a binary search. Scratch space follows the clip's
+    track count, so sample() only allocates on the first call after tracks
+    were added. The output spans need room for every track.
+------------------------------------------------------------------------------*/
+class AnimationSampler {
+public:
+    void sample(const float time, std::span<Vec3> translations,
+                std::span<Quat> rotations, std::span<Vec3> scales);
+    void sample(const float time, std::span<Mat4> locals);
+
+    void reset();
+
+    explicit AnimationSampler(const AnimationClip &clip);
+    AnimationSampler() = delete;
+
+private:
+    void find_keys(const float time);
+    void interpolate(std::span<Vec3> translations, std::span<Quat> rotations,
+                     std::span<Vec3> scales) const;
+    void interpolate(const std::size_t track, Vec3 &translation,
+                     Quat &rotation, Vec3 &scale) const;
+
+    const AnimationClip *_clip;
+
+    std::vector<uint32_t> _cursors;
+    std::vector<uint32_t> _keys;
+    std::vector<uint32_t> _next_keys;
+    std::vector<float>    _alphas;
+
+    // For sample() into matrices.
+    std::vector<Vec3> _translations;
+    std::vector<Quat> _rotations;
+    std::vector<Vec3> _scales;
+
+    float _last_time;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_ANIMATION_HPP
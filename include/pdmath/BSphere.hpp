@@ -3,6 +3,8 @@
 
 #include "pdmath/Point3.hpp"
 #include "pdmath/Matrix4.hpp"
+#include "pdmath/Affine3.hpp"
+#include "pdmath/instrument.hpp"
 
 namespace pdm {
 
@@ -31,8 +33,8 @@ public:
     Point3 to_world(const Point3 &p) const;
     Point3 to_local(const Point3 &p) const;
 
-    inline Mat4   world()          const { return _world; }
-    inline Mat4   local()          const { return _local; }
+    inline Mat4   world()          const { return _world.to_mat4(); }
+    inline Mat4   local()          const { return _local.to_mat4(); }
     inline float  scale()          const { return _world.get_x_scale(); }
     inline Point3 center_world()   const { return _center_world; }
     inline Point3 center()         const { return _center; }
@@ -45,6 +47,18 @@ public:
         _world{world},
         _local{world.inverted()}
     {
+        PDMATH_COUNT(bsphere_constructed);
+        _center_world   = _world  * _center;
+        _scaled_radius  = _radius * scale();
+    }
+
+    BSphere(const Point3 &center, const float radius, const Affine3 &world) :
+        _center{center},
+        _radius{radius},
+        _world{world},
+        _local{world.inverted()}
+    {
+        PDMATH_COUNT(bsphere_constructed);
         _center_world   = _world  * _center;
         _scaled_radius  = _radius * scale();
     }
@@ -56,8 +70,8 @@ private:
     Point3 _center_world;
     float  _radius;
     float  _scaled_radius;
-    Mat4   _world;
-    Mat4   _local;
+    Affine3 _world;
+    Affine3 _local;
 };
 
 } // namespace pdm
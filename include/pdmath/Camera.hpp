@@ -3,15 +3,44 @@
 
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Matrix4.hpp"
+#include "pdmath/Line.hpp"
+#include "pdmath/Point3d.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
 
 namespace pdm {
 class Point4;
+class Mat4d;
+class AABBox;
+class BSphere;
+
+struct ScreenBounds {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    float min_depth;
+
+    // false when the volume reaches the near plane and can't be bounded
+    bool  valid;
+};
 
 class Camera {
 public:
 
     void set_view(const Vec3 &pos, const Vec3 &target, const Vec3 &up);
 
+    // The float view is relative to this double precision world position.
+    void    set_origin(const Point3d &origin) { _origin = origin; }
+    Point3d origin() const { return _origin; }
+
+    Point3 rebase(const Point3d &point) const;
+    Mat4   rebase(const Mat4d &world)   const;
+    void   rebase(std::span<const Mat4d> worlds,
+                  std::span<Mat4>        relative) const;
+
     void set_ortho(const float left,  const float right,
                    const float top,   const float bottom,
                    const float near,  const float far,
@@ -28,6 +57,17 @@ public:
     Mat4 persp_ndc()     const { return _persp_ndc;     }
     Mat4 screen()        const { return _screen;        }
 
+    // Through whichever projection was set last; the identity until one is.
+    Mat4 world_to_screen() const { return _world_to_screen; }
+    Mat4 screen_to_world() const { return _screen_to_world; }
+
+    float near_plane() const { return _near;    }
+    float far_plane()  const { return _far;     }
+    float fov()        const { return _fov;     }
+    float x_res()      const { return _x_res;   }
+    float y_res()      const { return _y_res;   }
+    float z_depth()    const { return _z_depth; }
+
     Point4 view(const Point4 &point) const;
 
     Point4 ortho_ndc(const Point4 &point) const;
@@ -36,6 +76,25 @@ public:
     Point4 persp_ndc(const Point4 &point) const;
     Point4 persp_screen(const Point4 &point) const;
 
+    ScreenBounds projected_bounds(const BSphere &sphere) const;
+    ScreenBounds projected_bounds(const AABBox  &box)    const;
+
+    void projected_bounds(std::span<const BSphere> spheres,
+                          std::span<ScreenBounds>  bounds) const;
+    void projected_bounds(std::span<const AABBox>  boxes,
+                          std::span<ScreenBounds>  bounds) const;
+
+    float projected_size(const BSphere &sphere) const;
+    void  projected_size(std::span<const BSphere> spheres,
+                         std::span<float>         sizes) const;
+
+    Line pick_ray(const float x, const float y) const;
+    void pick_rays(std::span<const float> xs, std::span<const float> ys,
+                   std::span<Line> rays) const;
+
+    std::array<Point3, 8> frustum_corners(const float near,
+                                          const float far) const;
+
     static Vec3 face_normal(const Point3 &a, const Point3 &b,
                             const Point3 &c);
 
@@ -45,6 +104,17 @@ public:
     Camera(const Vec3 &pos, const Vec3 &target, const Vec3 &up) noexcept;
 
 private:
+    // Which of set_ortho() and set_persp() was called last, if either.
+    enum class Projection : uint8_t {
+        none,
+        ortho,
+        persp
+    };
+
+    void update_world_to_screen();
+
+    Point3d _origin;
+
     Vec3 _position;
     Vec3 _target;
     Vec3 _gaze;
@@ -56,6 +126,18 @@ private:
 
     Mat4 _ortho_ndc;
     Mat4 _persp_ndc;
+
+    Mat4 _world_to_screen;
+    Mat4 _screen_to_world;
+
+    float _near;
+    float _far;
+    float _fov;
+    float _x_res;
+    float _y_res;
+    float _z_depth;
+
+    Projection _projection;
 };
 } // namespace pdm
 
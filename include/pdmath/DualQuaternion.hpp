@@ -0,0 +1,41 @@
+#ifndef PDMATH_DUALQUATERNION_HPP
+#define PDMATH_DUALQUATERNION_HPP
+
+#include "pdmath/Point3.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Quaternion.hpp"
+
+#include <iostream>
+
+namespace pdm {
+class Mat4;
+
+/*------------------------------------------------------------------------------
+    A rigid transform as real + dual quaternion. The real part is the
+    rotation and the dual part is half the translation times the rotation,
+    so rotation and translation blend together without the volume loss of
+    blending matrices. Scale isn't representable.
+------------------------------------------------------------------------------*/
+class DualQuat {
+public:
+    DualQuat normalized() const;
+
+    Vec3   translation()                  const;
+    Point3 transform(const Point3 &point) const;
+    Mat4   to_mat4()                      const;
+
+    static const DualQuat identity;
+
+    Quat _real;
+    Quat _dual;
+
+    DualQuat() noexcept = default;
+    DualQuat(const Quat &rotation, const Vec3 &translation) noexcept;
+
+    bool operator==(const DualQuat &d) const;
+};
+
+std::ostream& operator<<(std::ostream &os, const DualQuat &d);
+} // namespace pdm
+
+#endif // PDMATH_DUALQUATERNION_HPP
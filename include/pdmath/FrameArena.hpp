@@ -0,0 +1,115 @@
+#ifndef PDMATH_FRAMEARENA_HPP
+#define PDMATH_FRAMEARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    A bump allocator for results that only live until the end of a frame:
+    pair lists, hit lists, scratch arrays. Allocating moves a pointer and
+    nothing is ever freed on its own; reset() hands the whole arena back at
+    once.
+
+    When a frame needs more than the arena holds, another block is taken
+    from the heap. The next reset() swaps all of them for one block big
+    enough for everything, so after a frame or two of warming up the
+    arena stops touching the heap at all.
+
+    Only trivially destructible types go in here, since nothing runs their
+    destructors. One arena per thread; it isn't synchronized.
+------------------------------------------------------------------------------*/
+class FrameArena {
+public:
+    static constexpr std::size_t default_capacity = 64 * 1024;
+    static constexpr std::size_t block_alignment  = 64;
+
+    // align is a power of two, at most block_alignment.
+    void* allocate(const std::size_t bytes,
+                   const std::size_t align = alignof(std::max_align_t));
+
+    // count default-initialized Ts; for plain structs that leaves the
+    // memory as it was.
+    template<typename T>
+    std::span<T> allocate(const std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "FrameArena never runs destructors");
+        T *first = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        std::uninitialized_default_construct_n(first, count);
+        return std::span<T>(first, count);
+    }
+
+    void reset();
+
+    inline std::size_t used()        const { return _used + _offset; }
+    inline std::size_t capacity()    const { return _capacity;       }
+    inline std::size_t block_count() const { return _blocks.size();  }
+
+    explicit FrameArena(const std::size_t capacity = default_capacity);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+private:
+    struct Block {
+        std::byte   *data;
+        std::size_t  size;
+    };
+
+    void add_block(const std::size_t size);
+    void release();
+
+    std::vector<Block> _blocks;
+
+    // Bytes in the blocks before the current one, and the bump offset
+    // into the current one.
+    std::size_t _used;
+    std::size_t _offset;
+    std::size_t _capacity;
+};
+
+/*------------------------------------------------------------------------------
+    Lets standard containers live in a FrameArena, so a query can grow a
+    list of unknown length without the heap:
+
+        ArenaVector<Pair> pairs{ArenaAllocator<Pair>(arena)};
+
+    Growing leaves the old buffer behind in the arena until the next reset,
+    so reserve() up front when the size can be guessed.
+------------------------------------------------------------------------------*/
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    T* allocate(const std::size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, const std::size_t) noexcept { }
+
+    explicit ArenaAllocator(FrameArena &arena) noexcept : _arena{&arena} { }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept :
+        _arena{other._arena}
+    { }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return _arena == other._arena;
+    }
+
+    FrameArena *_arena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace pdm
+
+#endif // PDMATH_FRAMEARENA_HPP
@@ -0,0 +1,207 @@
+#ifndef PDMATH_JOBSYSTEM_HPP
+#define PDMATH_JOBSYSTEM_HPP
+
+#include "pdmath/FrameArena.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pdm {
+
+class JobSystem;
+
+/*------------------------------------------------------------------------------
+    Tasks with dependencies between them, built once and run as many times
+    as needed. A task starts once every task added before it with
+    precede(before, it) has finished; tasks with nothing in between may run
+    at the same time on different threads.
+------------------------------------------------------------------------------*/
+class TaskGraph {
+public:
+    using Node = uint32_t;
+
+    template<typename F>
+    Node add(F &&task) {
+        _tasks.emplace_back(std::forward<F>(task));
+        _successors.emplace_back();
+        _predecessors.push_back(0);
+        return static_cast<Node>(_tasks.size() - 1);
+    }
+
+    void precede(const Node before, const Node after);
+
+    inline std::size_t size() const { return _tasks.size(); }
+
+private:
+    friend class JobSystem;
+
+    std::vector<std::function<void()>> _tasks;
+    std::vector<std::vector<Node>>     _successors;
+    std::vector<uint32_t>              _predecessors;
+
+    // Per-run state, sized on the first run() after the graph changes.
+    std::unique_ptr<std::atomic<uint32_t>[]> _pending;
+    std::size_t                              _pending_size = 0;
+    std::atomic<std::size_t>                 _remaining{0};
+};
+
+/*------------------------------------------------------------------------------
+    A small work-stealing pool for the batch work in this library: every
+    thread has its own queue, pushes and pops its newest task at the back
+    and, when it runs dry, takes the oldest task from the front of someone
+    else's. parallel_for hands out a range as one task and each thread that
+    picks part of it up splits it in half, again and again, down to the
+    grain; idle threads steal the big halves, so the work spreads out
+    without being chopped up front.
+
+    The thread that calls parallel_for() or run() works too, and waits by
+    running tasks, so nested calls from inside a task are fine. Threads are
+    numbered from 0, the thread that made the system, to thread_count() - 1,
+    and each number comes with its own FrameArena. Number 0 has no lock
+    around it, so from outside the system's own threads only the thread
+    that made it may call in; debug builds assert this. For shared() that's
+    whichever thread called it first.
+
+    An engine that already has a thread pool can hand one to the system as
+    an Executor instead of letting it start threads. Nothing is then
+    spawned; when work comes in, helpers are submitted to the executor, no
+    more than thread_count() - 1 outstanding at once, each one working
+    through tasks until none are left and then returning its thread. The
+    cores stay the engine's to schedule.
+------------------------------------------------------------------------------*/
+class JobSystem {
+public:
+    static constexpr std::size_t queue_capacity = 256;
+
+    struct Executor {
+        // Runs run(data) on one of the engine's threads, soon.
+        void (*submit)(void *context, void (*run)(void *data), void *data);
+        void *context;
+
+        // How many threads may work at once, the submitting one included.
+        uint32_t thread_count;
+    };
+
+    // Calls body(first, last) over [first, last) split into ranges of at
+    // least grain items, and returns when all of them are done.
+    template<typename F>
+    void parallel_for(const std::size_t first, const std::size_t last,
+                      const std::size_t grain, F &&body) {
+        using Body = std::remove_reference_t<F>;
+        RangeJob job{
+            [](void *f, std::size_t a, std::size_t b) {
+                (*static_cast<Body*>(f))(a, b);
+            },
+            const_cast<void*>(static_cast<const void*>(&body)),
+            grain == 0 ? 1 : grain,
+            {0}
+        };
+        run_range_job(job, first, last);
+    }
+
+    void run(TaskGraph &graph);
+
+    // The calling thread's number and arena. Outside the system's threads,
+    // only its owner may ask, and gets number 0.
+    uint32_t    thread_index() const;
+    FrameArena& arena();
+
+    // Resets every thread's arena; only while no work is running.
+    void reset_arenas();
+
+    inline uint32_t thread_count() const { return _thread_count; }
+
+    // The system the library's own types use unless given another one,
+    // with a thread per core.
+    static JobSystem& shared();
+
+    // thread_count includes the calling thread; 0 means one per core.
+    // Pinned workers stay on core i for worker i.
+    explicit JobSystem(uint32_t thread_count = 0, bool pin_threads = false);
+    explicit JobSystem(const Executor &executor);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    struct Task {
+        void (*run)(JobSystem &system, void *data, std::size_t first,
+                    std::size_t last, uint32_t slot);
+        void        *data;
+        std::size_t  first;
+        std::size_t  last;
+    };
+
+    struct RangeJob {
+        void (*body)(void *f, std::size_t first, std::size_t last);
+        void                     *f;
+        std::size_t               grain;
+        std::atomic<std::size_t>  remaining;
+    };
+
+    // One per thread number: its task queue, arena and, with an executor,
+    // whether a helper has been handed the number and not given it back.
+    struct Slot {
+        std::mutex        lock;
+        Task              tasks[queue_capacity];
+        std::size_t       head  = 0;
+        std::size_t       count = 0;
+        FrameArena        arena;
+        std::atomic<bool> occupied{false};
+    };
+
+    static void run_range(JobSystem &system, void *data, std::size_t first,
+                          std::size_t last, uint32_t slot);
+    static void run_node(JobSystem &system, void *data, std::size_t node,
+                         std::size_t, uint32_t slot);
+    static void help(void *data);
+
+    void run_range_job(RangeJob &job, std::size_t first, std::size_t last);
+
+    bool push(const uint32_t slot, const Task &task);
+    bool pop(const uint32_t slot, Task &task);
+    bool steal(const uint32_t thief, Task &task);
+    bool run_one(const uint32_t slot);
+
+    void start_threads(const bool pin_threads);
+    void worker(const uint32_t slot);
+    void wake();
+    void enter(const uint32_t slot);
+    uint32_t current_slot() const;
+
+    uint32_t _thread_count;
+    bool     _external;
+    Executor _executor;
+
+    // Only asserts look at it.
+    [[maybe_unused]] std::thread::id _owner;
+
+    std::unique_ptr<Slot[]>  _slots;
+    std::vector<std::thread> _threads;
+
+    // Workers sleep on _epoch; anything that publishes work bumps it.
+    std::atomic<uint32_t> _epoch{0};
+    std::atomic<uint32_t> _sleeping{0};
+    std::atomic<bool>     _stop{false};
+
+    // Per helper: the system and the number it's meant to take.
+    struct Helper {
+        JobSystem *system;
+        uint32_t   slot;
+    };
+    std::unique_ptr<Helper[]> _helpers;
+    std::atomic<uint32_t>     _helpers_pending{0};
+};
+
+} // namespace pdm
+
+#endif // PDMATH_JOBSYSTEM_HPP
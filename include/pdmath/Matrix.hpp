@@ -0,0 +1,360 @@
+#ifndef PDMATH_MATRIX_HPP
+#define PDMATH_MATRIX_HPP
+
+#include "pdmath/Vector.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+namespace pdm {
+class Mat3;
+class Mat4;
+class Mat4d;
+
+/*------------------------------------------------------------------------------
+    R x C matrix over any arithmetic T, stored row-major in _m[row][col] and
+    multiplied against column vectors. All of it is constexpr; 4x4 float
+    products use SSE outside constant evaluation.
+
+    The arithmetic lives in the detail:: kernels below, which work on plain
+    row arrays. Mat3 and Mat4 store the same float rows and run the same
+    kernels on them, so there's one copy of each.
+------------------------------------------------------------------------------*/
+template<std::size_t R, std::size_t C, typename T>
+struct alignas(detail::vec_align<C, T>) Mat {
+    T _m[R][C];
+
+    static constexpr std::size_t rows() { return R; }
+    static constexpr std::size_t cols() { return C; }
+
+    static constexpr Mat identity() requires (R == C) {
+        Mat m;
+        for(std::size_t i = 0; i < R; ++i) {
+            m._m[i][i] = T(1);
+        }
+        return m;
+    }
+
+    constexpr Vec<C, T> row(std::size_t r) const {
+        Vec<C, T> v;
+        for(std::size_t c = 0; c < C; ++c) {
+            v._e[c] = _m[r][c];
+        }
+        return v;
+    }
+
+    constexpr Vec<R, T> col(std::size_t c) const {
+        Vec<R, T> v;
+        for(std::size_t r = 0; r < R; ++r) {
+            v._e[r] = _m[r][c];
+        }
+        return v;
+    }
+
+    constexpr Mat<C, R, T> transposed() const;
+    constexpr T            determinant() const requires (R == C);
+    constexpr Mat          inverted() const requires (R == C);
+
+    constexpr Mat() noexcept : _m{} { }
+
+    template<typename U>
+    constexpr explicit Mat(const Mat<R, C, U> &m) noexcept : _m{} {
+        for(std::size_t r = 0; r < R; ++r) {
+            for(std::size_t c = 0; c < C; ++c) {
+                _m[r][c] = static_cast<T>(m._m[r][c]);
+            }
+        }
+    }
+
+    constexpr bool operator==(const Mat &m) const;
+};
+
+// Mat4d is already the double precision transform class, so the generic
+// double matrices spell out their size.
+using Mat3f   = Mat<3, 3, float>;
+using Mat4f   = Mat<4, 4, float>;
+using Mat3x4f = Mat<3, 4, float>;
+using Mat3x3d = Mat<3, 3, double>;
+using Mat4x4d = Mat<4, 4, double>;
+
+namespace detail {
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr void transpose(const T (*m)[C], T (*t)[R]) {
+    for(std::size_t c = 0; c < C; ++c) {
+        for(std::size_t r = 0; r < R; ++r) {
+            t[c][r] = m[r][c];
+        }
+    }
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr void add(const T (*m)[C], const T (*n)[C], T (*s)[C]) {
+    for(std::size_t r = 0; r < R; ++r) {
+        for(std::size_t c = 0; c < C; ++c) {
+            s[r][c] = static_cast<T>(m[r][c] + n[r][c]);
+        }
+    }
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr void sub(const T (*m)[C], const T (*n)[C], T (*s)[C]) {
+    for(std::size_t r = 0; r < R; ++r) {
+        for(std::size_t c = 0; c < C; ++c) {
+            s[r][c] = static_cast<T>(m[r][c] - n[r][c]);
+        }
+    }
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr void scale(const T (*m)[C], const T s, T (*p)[C]) {
+    for(std::size_t r = 0; r < R; ++r) {
+        for(std::size_t c = 0; c < C; ++c) {
+            p[r][c] = static_cast<T>(m[r][c] * s);
+        }
+    }
+}
+
+/*------------------------------------------------------------------------------
+    Row i of a product is the rows of n weighted by row i of m, which keeps
+    every access contiguous in the row-major layout. For 4x4 floats that's
+    four broadcasts and four multiply-adds per row.
+
+    Sums start from the first product and add the rest in order, and both
+    SSE paths keep that order in every lane, so the SIMD and scalar code
+    give the same bits and deterministic builds can use either. The rows
+    may belong to a Mat4 rather than a Mat, so loads are unaligned, which
+    costs nothing when they happen to be aligned.
+------------------------------------------------------------------------------*/
+template<std::size_t R, std::size_t K, std::size_t C, typename T>
+constexpr void mul(const T (*m)[K], const T (*n)[C], T (*p)[C]) {
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_SSE2)
+        if constexpr(R == 4 && K == 4 && is_float4<C, T>) {
+            __m128 n0 = _mm_loadu_ps(n[0]);
+            __m128 n1 = _mm_loadu_ps(n[1]);
+            __m128 n2 = _mm_loadu_ps(n[2]);
+            __m128 n3 = _mm_loadu_ps(n[3]);
+
+            for(std::size_t r = 0; r < 4; ++r) {
+                __m128 row = _mm_mul_ps(_mm_set1_ps(m[r][0]), n0);
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m[r][1]), n1));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m[r][2]), n2));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(m[r][3]), n3));
+                _mm_storeu_ps(p[r], row);
+            }
+            return;
+        }
+#endif
+    }
+    for(std::size_t r = 0; r < R; ++r) {
+        T row[C];
+        for(std::size_t c = 0; c < C; ++c) {
+            row[c] = static_cast<T>(m[r][0] * n[0][c]);
+        }
+        for(std::size_t k = 1; k < K; ++k) {
+            for(std::size_t c = 0; c < C; ++c) {
+                row[c] = static_cast<T>(row[c] + m[r][k] * n[k][c]);
+            }
+        }
+        for(std::size_t c = 0; c < C; ++c) {
+            p[r][c] = row[c];
+        }
+    }
+}
+
+// r = m * v over the first R rows of m, so a 4x4 matrix can also be used
+// as its upper 3x4 block.
+template<std::size_t R, std::size_t C, typename T>
+constexpr void mul(const T (*m)[C], const T *v, T *r) {
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_SSE2)
+        if constexpr(R == 4 && is_float4<C, T>) {
+            __m128 x  = _mm_loadu_ps(v);
+            __m128 r0 = _mm_mul_ps(_mm_loadu_ps(m[0]), x);
+            __m128 r1 = _mm_mul_ps(_mm_loadu_ps(m[1]), x);
+            __m128 r2 = _mm_mul_ps(_mm_loadu_ps(m[2]), x);
+            __m128 r3 = _mm_mul_ps(_mm_loadu_ps(m[3]), x);
+
+            // Transposed, lane i holds row i's products, so adding the four
+            // in order is every row's dot product at once.
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(r, _mm_add_ps(_mm_add_ps(_mm_add_ps(r0, r1), r2),
+                                        r3));
+            return;
+        }
+#endif
+    }
+    T out[R];
+    for(std::size_t i = 0; i < R; ++i) {
+        out[i] = static_cast<T>(m[i][0] * v[0]);
+        for(std::size_t c = 1; c < C; ++c) {
+            out[i] = static_cast<T>(out[i] + m[i][c] * v[c]);
+        }
+    }
+    for(std::size_t i = 0; i < R; ++i) {
+        r[i] = out[i];
+    }
+}
+
+} // namespace detail
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr Mat<C, R, T> Mat<R, C, T>::transposed() const {
+    Mat<C, R, T> t;
+    detail::transpose<R, C>(_m, t._m);
+    return t;
+}
+
+// Laplace expansion along the first row; fine for the sizes we use.
+template<std::size_t R, std::size_t C, typename T>
+constexpr T Mat<R, C, T>::determinant() const requires (R == C) {
+    if constexpr(R == 1) {
+        return _m[0][0];
+    }
+    else if constexpr(R == 2) {
+        return _m[0][0] * _m[1][1] - _m[0][1] * _m[1][0];
+    }
+    else {
+        T det  = T(0);
+        T sign = T(1);
+
+        for(std::size_t skip = 0; skip < C; ++skip) {
+            Mat<R - 1, C - 1, T> minor;
+            for(std::size_t r = 1; r < R; ++r) {
+                for(std::size_t c = 0, mc = 0; c < C; ++c) {
+                    if(c != skip) {
+                        minor._m[r - 1][mc++] = _m[r][c];
+                    }
+                }
+            }
+
+            det += sign * _m[0][skip] * minor.determinant();
+            sign = -sign;
+        }
+
+        return det;
+    }
+}
+
+/*------------------------------------------------------------------------------
+    Gauss-Jordan with partial pivoting. A singular matrix comes back as all
+    zeros. Mat3::inverted() and Mat4::inverted() don't check: they scale by
+    1 / determinant, so theirs fill with infinities and NaNs instead.
+------------------------------------------------------------------------------*/
+template<std::size_t R, std::size_t C, typename T>
+constexpr Mat<R, C, T> Mat<R, C, T>::inverted() const requires (R == C) {
+    Mat a   = *this;
+    Mat inv = identity();
+
+    for(std::size_t col = 0; col < C; ++col) {
+        std::size_t pivot = col;
+        for(std::size_t r = col + 1; r < R; ++r) {
+            T candidate = a._m[r][col] < T(0) ? -a._m[r][col] : a._m[r][col];
+            T best = a._m[pivot][col] < T(0) ? -a._m[pivot][col]
+                                             :  a._m[pivot][col];
+            if(candidate > best) {
+                pivot = r;
+            }
+        }
+
+        if(a._m[pivot][col] == T(0)) {
+            return Mat();
+        }
+
+        for(std::size_t c = 0; c < C; ++c) {
+            std::swap(a._m[col][c],   a._m[pivot][c]);
+            std::swap(inv._m[col][c], inv._m[pivot][c]);
+        }
+
+        T scale = T(1) / a._m[col][col];
+        for(std::size_t c = 0; c < C; ++c) {
+            a._m[col][c]   *= scale;
+            inv._m[col][c] *= scale;
+        }
+
+        for(std::size_t r = 0; r < R; ++r) {
+            if(r == col) {
+                continue;
+            }
+
+            T factor = a._m[r][col];
+            for(std::size_t c = 0; c < C; ++c) {
+                a._m[r][c]   -= factor * a._m[col][c];
+                inv._m[r][c] -= factor * inv._m[col][c];
+            }
+        }
+    }
+
+    return inv;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr bool Mat<R, C, T>::operator==(const Mat &m) const {
+    for(std::size_t r = 0; r < R; ++r) {
+        for(std::size_t c = 0; c < C; ++c) {
+            if(_m[r][c] != m._m[r][c]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<std::size_t R, std::size_t K, std::size_t C, typename T>
+constexpr Mat<R, C, T> operator*(const Mat<R, K, T> &m,
+                                 const Mat<K, C, T> &n) {
+    Mat<R, C, T> p;
+    detail::mul<R, K, C>(m._m, n._m, p._m);
+    return p;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr Vec<R, T> operator*(const Mat<R, C, T> &m, const Vec<C, T> &v) {
+    Vec<R, T> r;
+    detail::mul<R, C>(m._m, v._e, r._e);
+    return r;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr Mat<R, C, T> operator+(const Mat<R, C, T> &m,
+                                 const Mat<R, C, T> &n) {
+    Mat<R, C, T> s;
+    detail::add<R, C>(m._m, n._m, s._m);
+    return s;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr Mat<R, C, T> operator-(const Mat<R, C, T> &m,
+                                 const Mat<R, C, T> &n) {
+    Mat<R, C, T> s;
+    detail::sub<R, C>(m._m, n._m, s._m);
+    return s;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+constexpr Mat<R, C, T> operator*(const Mat<R, C, T> &m, const T s) {
+    Mat<R, C, T> p;
+    detail::scale<R, C>(m._m, s, p._m);
+    return p;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+std::ostream& operator<<(std::ostream &os, const Mat<R, C, T> &m) {
+    for(std::size_t r = 0; r < R; ++r) {
+        os << m.row(r) << (r + 1 < R ? "\n" : "");
+    }
+    return os;
+}
+
+Mat3f  to_mat(const Mat3 &m);
+Mat4f  to_mat(const Mat4 &m);
+Mat4x4d to_mat(const Mat4d &m);
+Mat3   to_mat3(const Mat3f &m);
+Mat4   to_mat4(const Mat4f &m);
+Mat4d  to_mat4d(const Mat4x4d &m);
+
+} // namespace pdm
+
+#endif // PDMATH_MATRIX_HPP
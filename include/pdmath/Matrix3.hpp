@@ -1,19 +1,39 @@
 #ifndef PDMATH_MATRIX3_HPP
 #define PDMATH_MATRIX3_HPP
 
+#include "pdmath/fastmath.hpp"
+
 #include <array>
 #include <iostream>
+#include <span>
 
 namespace pdm {
 class Vec3;
 class Point3;
 
+// Euler orders name the rotations as they're multiplied, left to right, so
+// xyz is Rx * Ry * Rz and z is applied to a column vector first.
+enum class RotationOrder {
+    xyz,
+    xzy,
+    yxz,
+    yzx,
+    zxy,
+    zyx
+};
+
 class Mat3 {
 public:
     static const Mat3 identity;
 
     static Mat3 populate_rotation(float theta_x, float theta_y,
-                                    float theta_z);
+                                  float theta_z,
+                                  RotationOrder order = RotationOrder::xyz);
+    static void populate_rotations(std::span<const Vec3> thetas,
+                                   std::span<Mat3> out,
+                                   RotationOrder order = RotationOrder::xyz,
+                                   Accuracy accuracy = Accuracy::high);
+
     Mat3  transposed() const;
     Mat3  inverted() const;
     float determinant() const;
@@ -6,12 +6,18 @@
 
 #include <array>
 #include <iostream>
+#include <span>
 
 namespace pdm {
 class Point4;
 class Vec4;
 
-class Mat4 {
+/*------------------------------------------------------------------------------
+    Rows are stored in order (_m[row][col]) and aligned so each one is a
+    single 16 byte load; the layout, and so what gets uploaded to GL, is
+    the same as an unaligned float[4][4].
+------------------------------------------------------------------------------*/
+class alignas(16) Mat4 {
 public:
     static const Mat4 identity;
 
@@ -36,6 +42,10 @@ public:
         const Vec3 &translation,
         const float theta_x, const float theta_y, const float theta_z,
         const Vec3 &scale, Mat4 &prev_transform);
+
+    // out[i] = *this * points[i], transposing the matrix only once.
+    void transform(std::span<const Point4> points,
+                   std::span<Point4> out) const;
     
     Vec3 get_world_position() const;
 
@@ -104,6 +114,9 @@ Point3 operator*(const Mat4 &m, const Point3 &p);
 Vec3   operator*(const Mat4 &m, const Vec3 &v);
 
 std::ostream& operator<<(std::ostream &os, const Mat4 &m);
+
+static_assert(sizeof(Mat4) == 16 * sizeof(float),
+              "Mat4 must stay a packed float[4][4] for uploads");
 } // namespace pdm
 
 #endif // PDMATH_MATRIX4_HPP
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef PDMATH_MATRIX4D_HPP
+#define PDMATH_MATRIX4D_HPP
+
+#include "pdmath/Point3d.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include <iostream>
+#include <span>
+
+namespace pdm {
+
+class Mat4d {
+public:
+    static const Mat4d identity;
+
+    Point3d get_world_position() const;
+    const Mat4d& set_translation(const Point3d &p);
+
+    Mat4 relative_to(const Point3d &origin) const;
+    static void relative_to(std::span<const Mat4d> worlds,
+                            const Point3d &origin,
+                            std::span<Mat4> relative);
+
+    double _m[4][4];
+
+    Mat4d() noexcept:
+        _m{{0}, {0}, {0}, {0}}
+    { }
+
+    Mat4d(const double x1, const double y1, const double z1, const double w1,
+          const double x2, const double y2, const double z2, const double w2,
+          const double x3, const double y3, const double z3, const double w3,
+          const double x4, const double y4, const double z4, const double w4)
+          noexcept;
+
+    explicit Mat4d(const Mat4 &m) noexcept;
+
+    bool operator==(const Mat4d &m) const;
+
+    const Mat4d& operator*=(const Mat4d &m);
+};
+
+Mat4d   operator*(const Mat4d &m, const Mat4d &n);
+Point3d operator*(const Mat4d &m, const Point3d &p);
+
+std::ostream& operator<<(std::ostream &os, const Mat4d &m);
+} // namespace pdm
+
+#endif // PDMATH_MATRIX4D_HPP
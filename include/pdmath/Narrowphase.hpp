@@ -0,0 +1,93 @@
+#ifndef PDMATH_NARROWPHASE_HPP
+#define PDMATH_NARROWPHASE_HPP
+
+#include "pdmath/BSphere.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/OBBox.hpp"
+#include "pdmath/Line.hpp"
+#include "pdmath/Plane.hpp"
+#include "pdmath/JobSystem.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pdm {
+
+enum class Shape : uint8_t {
+    sphere,
+    aabb,
+    obb,
+    line,
+    plane
+};
+
+static constexpr std::size_t shape_count = 5;
+
+// A shape by kind and index into the matching array of a Colliders.
+struct ShapeRef {
+    Shape    type;
+    uint32_t index;
+};
+
+struct CollisionPair {
+    ShapeRef a;
+    ShapeRef b;
+};
+
+// The shapes pairs refer to, typically a Pool's items() each.
+struct Colliders {
+    std::span<const BSphere> spheres;
+    std::span<const AABBox>  aabbs;
+    std::span<const OBBox>   obbs;
+    std::span<const Line>    lines;
+    std::span<const Plane>   planes;
+};
+
+/*------------------------------------------------------------------------------
+    Exact tests for the pairs a broadphase produced. Pairs are counting
+    sorted by their combination of shapes, either way round, so each run of
+    the sorted list goes through one loop built for exactly those two types
+    and the code for every other combination stays out of the cache. The
+    sorted list is then split over the job system's threads.
+
+    hits[i] is set to 1 or 0 for pairs[i], so hits must be at least as long
+    as pairs, and every ShapeRef must index into its array of colliders.
+    Every slot is written by exactly one thread, so hits can be any
+    preallocated span, say from a FrameArena, and nothing is locked. An
+    AABBox against an OBBox or a Plane is tested as an OBBox with identity
+    transforms, which costs no inverse; two planes meet unless they're
+    parallel and apart.
+
+    The sort's scratch is kept between runs, so once it has grown to the
+    largest pair list seen, run() doesn't allocate.
+------------------------------------------------------------------------------*/
+class Narrowphase {
+public:
+    static constexpr std::size_t combination_count =
+        shape_count * (shape_count + 1) / 2;
+
+    // Pairs split across threads in pieces of at least this many.
+    static constexpr std::size_t grain = 256;
+
+    void run(const Colliders &colliders,
+             std::span<const CollisionPair> pairs, std::span<uint8_t> hits);
+
+    // How many pairs of the last run had this combination, in either order.
+    std::size_t bucket_size(const Shape a, const Shape b) const;
+
+    explicit Narrowphase(JobSystem &jobs = JobSystem::shared());
+
+private:
+    static std::size_t combination(const Shape a, const Shape b);
+
+    std::array<uint32_t, combination_count + 1> _offsets;
+    std::vector<uint32_t>                       _order;
+
+    JobSystem *_jobs;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_NARROWPHASE_HPP
@@ -4,11 +4,13 @@
 #include "pdmath/Point3.hpp"
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Matrix4.hpp"
+#include "pdmath/Affine3.hpp"
 
 #include <utility>
 
 namespace pdm {
 
+class AABBox;
 class BSphere;
 class Plane;
 class Point4;
@@ -45,8 +47,8 @@ public:
     Point4 to_local(const Point4 &p) const;
     Point4 to_world(const Point4 &p) const;
 
-    inline Mat4   get_local()    const { return _local;        }
-    inline Mat4   get_world()    const { return _world;        }
+    inline Mat4   get_local()    const { return _local.to_mat4(); }
+    inline Mat4   get_world()    const { return _world.to_mat4(); }
     inline Point3 center()       const { return _center;       }
     inline Point3 center_world() const { return _center_world; }
     inline Vec3   best_diag()    const { return _best_diag;    }
@@ -56,6 +58,8 @@ public:
     std::pair<float, float> z_interval() const;
 
     OBBox(const Point3 &min, const Point3 &max, const Mat4 &world) noexcept;
+    OBBox(const Point3 &min, const Point3 &max, const Affine3 &world) noexcept;
+    explicit OBBox(const AABBox &box) noexcept;
     OBBox() = delete;
 
 private:
@@ -69,8 +73,8 @@ private:
     Point3 _max_world;
     Point3 _center_world;
 
-    Mat4   _world;
-    Mat4   _local;
+    Affine3 _world;
+    Affine3 _local;
 };
 
 } // namespace pdm
@@ -0,0 +1,78 @@
+#ifndef PDMATH_OCCLUSIONBUFFER_HPP
+#define PDMATH_OCCLUSIONBUFFER_HPP
+
+#include "pdmath/Point3.hpp"
+#include "pdmath/JobSystem.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace pdm {
+
+class Camera;
+struct ScreenBounds;
+class AABBox;
+class BSphere;
+
+class OcclusionBuffer {
+public:
+    static constexpr uint32_t tile_width  = 32;
+    static constexpr uint32_t tile_height = 16;
+
+    void clear();
+
+    void add_occluder(const Point3 &a, const Point3 &b, const Point3 &c);
+    void rasterize(const Camera &camera);
+
+    bool visible(const Camera &camera, const AABBox       &box)    const;
+    bool visible(const Camera &camera, const BSphere      &sphere) const;
+    bool visible(const Camera &camera, const ScreenBounds &bounds) const;
+    bool visible(float min_x, float min_y, float max_x, float max_y,
+                 float min_depth) const;
+
+    float depth(uint32_t x, uint32_t y)      const;
+    float tile_depth(uint32_t x, uint32_t y) const;
+
+    inline uint32_t    width()          const { return _width;  }
+    inline uint32_t    height()         const { return _height; }
+    inline std::size_t occluder_count() const { return _occluders.size() / 3; }
+
+    // thread_count of 0 lets the job system spread tiles over all of its
+    // threads, 1 rasterizes on the calling thread.
+    OcclusionBuffer(uint32_t width, uint32_t height,
+                    uint32_t thread_count = 0,
+                    JobSystem &jobs = JobSystem::shared());
+    OcclusionBuffer() = delete;
+
+private:
+    struct ScreenTri {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    void bin_triangles();
+    void rasterize_tile(uint32_t tile);
+    void rasterize_tri(const ScreenTri &tri,
+                       uint32_t x0, uint32_t y0,
+                       uint32_t x1, uint32_t y1);
+
+    uint32_t _width;
+    uint32_t _height;
+    uint32_t _tiles_x;
+    uint32_t _tiles_y;
+    uint32_t _thread_count;
+
+    JobSystem *_jobs;
+
+    std::vector<float> _depth;
+    std::vector<float> _tile_max;
+
+    std::vector<Point3>    _occluders;
+    std::vector<ScreenTri> _screen_tris;
+    std::vector<std::vector<uint32_t>> _bins;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_OCCLUSIONBUFFER_HPP
@@ -0,0 +1,34 @@
+#ifndef PDMATH_POINT3D_HPP
+#define PDMATH_POINT3D_HPP
+
+#include <iostream>
+
+namespace pdm {
+class Point3;
+class Vec3;
+
+class Point3d {
+public:
+    Point3 relative_to(const Point3d &origin) const;
+
+    double _x;
+    double _y;
+    double _z;
+
+    Point3d() noexcept;
+    Point3d(const double x, const double y, const double z) noexcept;
+    explicit Point3d(const Point3 &p) noexcept;
+
+    bool operator==(const Point3d &p) const;
+
+    const Point3d& operator+=(const Vec3 &v);
+    const Point3d& operator-=(const Vec3 &v);
+};
+
+Point3d operator+(const Point3d &p, const Vec3 &v);
+Point3d operator-(const Point3d &p, const Vec3 &v);
+
+std::ostream& operator<<(std::ostream &os, const Point3d &p);
+} // namespace pdm
+
+#endif // PDMATH_POINT3D_HPP
@@ -8,7 +8,9 @@
 
 namespace pdm {
 
-class Point4 : public Point3 {
+// Aligned so the four components load as one SSE register; the layout is
+// still x, y, z, w packed into 16 bytes.
+class alignas(16) Point4 : public Point3 {
 public:
 
     float _w;
@@ -77,5 +79,8 @@ Point4 operator/(const float scalar, const Point4 &p);
 
 std::ostream& operator<<(std::ostream &os, const Point4 &p);
 
+static_assert(sizeof(Point4) == 4 * sizeof(float),
+              "Point4 must stay four packed floats");
+
 } // namespace pdm
 #endif // PDMATH_POINT4_HPP
@@ -0,0 +1,153 @@
+#ifndef PDMATH_POOL_HPP
+#define PDMATH_POOL_HPP
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    A reference to an object in a Pool<T>. The index picks a slot and the
+    generation says which object in that slot it was made for, so a handle
+    kept after its object was destroyed finds nothing instead of whatever
+    took the slot over.
+------------------------------------------------------------------------------*/
+template<typename T>
+struct Handle {
+    static constexpr uint32_t no_index =
+        std::numeric_limits<uint32_t>::max();
+
+    uint32_t _index      = no_index;
+    uint32_t _generation = 0;
+
+    inline bool is_null() const { return _index == no_index; }
+
+    bool operator==(const Handle&) const = default;
+};
+
+/*------------------------------------------------------------------------------
+    Typed storage for bounding volumes and anything else that's created
+    and destroyed often. Objects are kept packed in one array, so batch
+    code can run over items() without skipping holes; destroying one moves
+    the last object into its place and updates that object's slot.
+    Handles stay valid across all of that, pointers and references don't.
+
+    Freed slots are reused, so once the pool has grown to its working size
+    create() and destroy() never touch the heap.
+------------------------------------------------------------------------------*/
+template<typename T>
+class Pool {
+public:
+    template<typename... Args>
+    Handle<T> create(Args&&... args) {
+        uint32_t slot;
+        if(_free != no_slot) {
+            slot  = _free;
+            _free = _slots[slot].dense;
+        }
+        else {
+            slot = static_cast<uint32_t>(_slots.size());
+            _slots.push_back({0, 0});
+        }
+
+        _slots[slot].dense = static_cast<uint32_t>(_items.size());
+        _items.emplace_back(std::forward<Args>(args)...);
+        _owners.push_back(slot);
+
+        return Handle<T>{slot, _slots[slot].generation};
+    }
+
+    void destroy(const Handle<T> handle) {
+        if(!contains(handle)) {
+            return;
+        }
+
+        uint32_t dense = _slots[handle._index].dense;
+        uint32_t last  = static_cast<uint32_t>(_items.size()) - 1;
+        if(dense != last) {
+            _items[dense]  = std::move(_items[last]);
+            _owners[dense] = _owners[last];
+            _slots[_owners[dense]].dense = dense;
+        }
+        _items.pop_back();
+        _owners.pop_back();
+
+        // Bumping the generation is what turns old handles stale; no
+        // handle is ever made for a free slot's current generation.
+        Slot &slot = _slots[handle._index];
+        ++slot.generation;
+        slot.dense = _free;
+        _free      = handle._index;
+    }
+
+    inline bool contains(const Handle<T> handle) const {
+        return handle._index < _slots.size() &&
+               _slots[handle._index].generation == handle._generation;
+    }
+
+    // nullptr for a stale or null handle.
+    inline T* get(const Handle<T> handle) {
+        return contains(handle) ? &_items[_slots[handle._index].dense]
+                                : nullptr;
+    }
+    inline const T* get(const Handle<T> handle) const {
+        return contains(handle) ? &_items[_slots[handle._index].dense]
+                                : nullptr;
+    }
+
+    // Handle of items()[i].
+    inline Handle<T> handle(const std::size_t i) const {
+        return Handle<T>{_owners[i], _slots[_owners[i]].generation};
+    }
+
+    inline std::span<T>       items()       { return _items; }
+    inline std::span<const T> items() const { return _items; }
+
+    inline std::size_t size()     const { return _items.size(); }
+    inline std::size_t capacity() const { return _items.capacity(); }
+
+    void reserve(const std::size_t count) {
+        _items.reserve(count);
+        _owners.reserve(count);
+        _slots.reserve(count);
+    }
+
+    void clear() {
+        for(std::size_t i = 0; i < _owners.size(); ++i) {
+            Slot &slot = _slots[_owners[i]];
+            ++slot.generation;
+            slot.dense = _free;
+            _free      = _owners[i];
+        }
+        _items.clear();
+        _owners.clear();
+    }
+
+    Pool() noexcept = default;
+
+    explicit Pool(const std::size_t capacity) {
+        reserve(capacity);
+    }
+
+private:
+    static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+
+    // A live slot's dense is its object's index in _items; a free slot's
+    // is the next free slot.
+    struct Slot {
+        uint32_t dense;
+        uint32_t generation;
+    };
+
+    std::vector<T>        _items;
+    std::vector<uint32_t> _owners;
+    std::vector<Slot>     _slots;
+    uint32_t              _free = no_slot;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_POOL_HPP
@@ -4,17 +4,40 @@
 #include "pdmath/Vector3.hpp"
 
 #include <iostream>
+#include <span>
 
 namespace pdm {
+class Mat3;
+class Mat4;
+
 class Quat {
 public:
     Quat() noexcept = default;
     Quat(float theta, Vec3 axis) noexcept;
     Quat(float theta, float x, float y, float z) noexcept;
 
-    Quat inverted();
-    Quat normalized();
-    float length();
+    Quat  inverted() const;
+    Quat  normalized() const;
+    float length() const;
+    float dot(const Quat &q) const;
+
+    Vec3 rotate(const Vec3 &v) const;
+
+    static Quat slerp(const Quat &a, const Quat &b, const float t);
+    static Quat nlerp(const Quat &a, const Quat &b, const float t);
+
+    Mat3 to_mat3() const;
+    Mat4 to_mat4() const;
+    static Quat from_mat3(const Mat3 &m);
+
+    static void rotate(std::span<const Quat> q, std::span<const Vec3> v,
+                       std::span<Vec3> out);
+    static void slerp(std::span<const Quat> a, std::span<const Quat> b,
+                      const float t, std::span<Quat> out);
+    static void nlerp(std::span<const Quat> a, std::span<const Quat> b,
+                      const float t, std::span<Quat> out);
+    static void to_mat3(std::span<const Quat> q, std::span<Mat3> out);
+    static void from_mat3(std::span<const Mat3> m, std::span<Quat> out);
 
     static const Quat identity;
 
@@ -30,4 +53,4 @@ Quat operator*(const Quat &q, const Quat &p);
 std::ostream& operator<<(std::ostream &os, const Quat &q);
 } // namespace pdm
 
-#endif // PDMATH_QUATERNION_HPP
\ No newline at end of file
+#endif // PDMATH_QUATERNION_HPP
@@ -0,0 +1,62 @@
+#ifndef PDMATH_SHADOWCASCADES_HPP
+#define PDMATH_SHADOWCASCADES_HPP
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Camera.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace pdm {
+
+class BSphere;
+
+class ShadowCascades {
+public:
+    static constexpr std::size_t max_cascades = 8;
+
+    static void split_distances(const float near, const float far,
+                                const float lambda, std::span<float> splits);
+
+    void fit(const Camera &view, const Vec3 &light_dir);
+    void cull(std::span<const BSphere> casters,
+              std::span<uint32_t>      masks) const;
+
+    Mat4 light_ndc(const std::size_t cascade) const;
+
+    inline std::size_t   count()                   const { return _count;     }
+    inline const Camera& light(std::size_t i)      const { return _lights[i]; }
+    inline float         split_near(std::size_t i) const { return _splits[i]; }
+    inline float         split_far(std::size_t i)  const { return _splits[i + 1]; }
+
+    ShadowCascades(const std::size_t count, const float lambda,
+                   const float resolution, const float extrusion) noexcept;
+    ShadowCascades() = delete;
+
+private:
+    struct LightBounds {
+        float left;
+        float right;
+        float bottom;
+        float top;
+        float near_z;
+        float far_z;
+    };
+
+    std::size_t _count;
+    float       _lambda;
+    float       _resolution;
+    float       _extrusion;
+
+    Mat4 _light_view;
+
+    std::array<float, max_cascades + 1>   _splits;
+    std::array<Camera, max_cascades>      _lights;
+    std::array<LightBounds, max_cascades> _bounds;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_SHADOWCASCADES_HPP
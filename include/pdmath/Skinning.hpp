@@ -0,0 +1,54 @@
+#ifndef PDMATH_SKINNING_HPP
+#define PDMATH_SKINNING_HPP
+
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/DualQuaternion.hpp"
+#include "pdmath/AABBox.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace pdm {
+
+static constexpr std::size_t max_influences = 4;
+
+/*------------------------------------------------------------------------------
+    Bind pose vertices as separate x, y and z arrays, with up to four bone
+    influences each. Influence i of every vertex lives in bones[i] and
+    weights[i]; unused influences should have a weight of zero. Weights are
+    expected to sum to one.
+------------------------------------------------------------------------------*/
+struct SkinStream {
+    std::span<const float> x;
+    std::span<const float> y;
+    std::span<const float> z;
+
+    std::array<std::span<const uint16_t>, max_influences> bones;
+    std::array<std::span<const float>,    max_influences> weights;
+};
+
+struct SkinnedStream {
+    std::span<float> x;
+    std::span<float> y;
+    std::span<float> z;
+};
+
+/*------------------------------------------------------------------------------
+    Both kernels skin every vertex of the stream against a bone palette and
+    return the bounds of the skinned vertices, found in the same pass. An
+    empty stream gives an inverted box (min above max).
+
+    Linear blend skinning blends the palette matrices by weight and then
+    transforms; dual quaternion skinning blends rigid transforms and keeps
+    volume at twisting joints, but ignores scale.
+------------------------------------------------------------------------------*/
+AABBox skin_linear(const SkinStream &in, std::span<const Mat4> palette,
+                   const SkinnedStream &out);
+AABBox skin_dual_quat(const SkinStream &in,
+                      std::span<const DualQuat> palette,
+                      const SkinnedStream &out);
+
+} // namespace pdm
+
+#endif // PDMATH_SKINNING_HPP
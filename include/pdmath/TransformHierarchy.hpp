@@ -0,0 +1,124 @@
+#ifndef PDMATH_TRANSFORMHIERARCHY_HPP
+#define PDMATH_TRANSFORMHIERARCHY_HPP
+
+#include "pdmath/Point3.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/OBBox.hpp"
+#include "pdmath/JobSystem.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    A flat scene graph. Nodes are stored in the order they're added and a
+    parent always has to exist before its children, so the arrays are
+    already topologically sorted and no node is ever visited before its
+    parent. Changing a node queues it at its depth; update() walks one
+    depth at a time, rebuilding what's queued there and queueing the
+    children of what it rebuilt, so it only ever touches changed nodes and
+    the subtrees under them. Wide levels are split across the job system's
+    threads. A thread_count of 1 keeps the update on the calling thread;
+    any other non-zero count splits a level into at most that many pieces.
+
+    A node can carry one bounding sphere and one oriented box, given in its
+    local space. They're rebuilt with the node's world matrix in the same
+    pass.
+------------------------------------------------------------------------------*/
+class TransformHierarchy {
+public:
+    static constexpr uint32_t no_parent = std::numeric_limits<uint32_t>::max();
+
+    uint32_t add_node(const uint32_t parent, const Vec3 &translation,
+                      const Quat &rotation, const Vec3 &scale);
+
+    void set_local(const uint32_t node, const Vec3 &translation,
+                   const Quat &rotation, const Vec3 &scale);
+    void set_translation(const uint32_t node, const Vec3 &translation);
+    void set_rotation(const uint32_t node, const Quat &rotation);
+    void set_scale(const uint32_t node, const Vec3 &scale);
+
+    void attach_sphere(const uint32_t node, const Point3 &center,
+                       const float radius);
+    void attach_box(const uint32_t node, const Point3 &min,
+                    const Point3 &max);
+
+    void update();
+
+    inline const Mat4& world(uint32_t node)  const { return _worlds[node];  }
+    inline uint32_t    parent(uint32_t node) const { return _parents[node]; }
+    inline bool        dirty(uint32_t node)  const { return _dirty[node];   }
+
+    inline bool has_sphere(uint32_t node) const {
+        return _sphere_slots[node] != no_slot;
+    }
+    inline bool has_box(uint32_t node) const {
+        return _box_slots[node] != no_slot;
+    }
+    inline const BSphere& sphere(uint32_t node) const {
+        return _spheres[_sphere_slots[node]];
+    }
+    inline const OBBox& box(uint32_t node) const {
+        return _boxes[_box_slots[node]];
+    }
+
+    inline std::size_t size()        const { return _parents.size(); }
+    inline std::size_t level_count() const { return _pending.size(); }
+
+    // How many nodes the last update() rebuilt.
+    inline std::size_t rebuilt_count() const { return _rebuilt; }
+
+    explicit TransformHierarchy(uint32_t thread_count = 0,
+                                JobSystem &jobs = JobSystem::shared());
+
+private:
+    static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t no_node = std::numeric_limits<uint32_t>::max();
+
+    // Below this many nodes per level the threads cost more than they save.
+    static constexpr std::size_t min_parallel_level = 512;
+    static constexpr std::size_t batch_size         = 64;
+
+    void mark_dirty(const uint32_t node);
+    void update_node(const uint32_t node);
+    void update_level(const std::vector<uint32_t> &level,
+                      const std::size_t first, const std::size_t last);
+
+    uint32_t   _thread_count;
+    JobSystem *_jobs;
+
+    std::vector<uint32_t> _parents;
+    std::vector<Vec3>     _translations;
+    std::vector<Quat>     _rotations;
+    std::vector<Vec3>     _scales;
+    std::vector<Mat4>     _worlds;
+    std::vector<uint8_t>  _dirty;
+
+    std::vector<uint32_t> _depths;
+    std::vector<uint32_t> _first_child;
+    std::vector<uint32_t> _next_sibling;
+
+    // Nodes changed since the last update(), then the same nodes and their
+    // descendants sorted by depth while it runs.
+    std::vector<uint32_t>              _dirty_nodes;
+    std::vector<std::vector<uint32_t>> _pending;
+    std::size_t                        _rebuilt;
+
+    std::vector<uint32_t> _sphere_slots;
+    std::vector<uint32_t> _box_slots;
+    std::vector<BSphere>  _spheres;
+    std::vector<OBBox>    _boxes;
+    std::vector<Point3>   _sphere_centers;
+    std::vector<float>    _sphere_radii;
+    std::vector<Point3>   _box_mins;
+    std::vector<Point3>   _box_maxs;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_TRANSFORMHIERARCHY_HPP
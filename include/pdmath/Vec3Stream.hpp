@@ -0,0 +1,169 @@
+#ifndef PDMATH_VEC3STREAM_HPP
+#define PDMATH_VEC3STREAM_HPP
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/fastmath.hpp"
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace pdm {
+
+class Mat3;
+class Mat4;
+
+namespace detail {
+
+template<typename T, std::size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    T* allocate(const std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T),
+                                              std::align_val_t(Align)));
+    }
+
+    void deallocate(T *p, const std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept { }
+
+    bool operator==(const AlignedAllocator&) const { return true; }
+};
+
+} // namespace detail
+
+/*------------------------------------------------------------------------------
+    A window onto Vec3s that live inside some other array of structs, such
+    as the positions of an interleaved vertex buffer. Nothing is copied;
+    element i is read from and written to base + i * stride bytes.
+------------------------------------------------------------------------------*/
+class Vec3View {
+public:
+    inline std::size_t size() const { return _count; }
+
+    inline Vec3 get(const std::size_t i) const {
+        const float *v = element(i);
+        return Vec3(v[0], v[1], v[2]);
+    }
+
+    inline void set(const std::size_t i, const Vec3 &v) {
+        float *e = element(i);
+        e[0] = v._x;
+        e[1] = v._y;
+        e[2] = v._z;
+    }
+
+    Vec3View(std::span<Vec3> v) noexcept :
+        Vec3View(v.empty() ? nullptr : &v[0]._x, v.size(), sizeof(Vec3))
+    { }
+
+    template<typename T>
+    Vec3View(std::span<T> items, Vec3 T::*member) noexcept :
+        Vec3View(items.empty() ? nullptr : &(items[0].*member)._x,
+                 items.size(), sizeof(T))
+    { }
+
+    Vec3View(float *first, const std::size_t count,
+             const std::size_t stride) noexcept :
+        _base{reinterpret_cast<std::byte*>(first)},
+        _count{count},
+        _stride{stride}
+    { }
+
+    Vec3View() = delete;
+
+private:
+    inline float* element(const std::size_t i) const {
+        return reinterpret_cast<float*>(_base + i * _stride);
+    }
+
+    std::byte   *_base;
+    std::size_t  _count;
+    std::size_t  _stride;
+};
+
+/*------------------------------------------------------------------------------
+    Vec3s stored as three separate columns of x, y and z. Every column is
+    cache line aligned and the bulk operations below are plain loops over
+    them, so they vectorize at whatever width the target has instead of
+    fighting the 12 byte stride of an array of Vec3.
+
+    Operations that produce vectors work in place, so a.cross(b) leaves
+    a[i] x b[i] in a. Streams passed as arguments must be at least as long
+    as this one.
+------------------------------------------------------------------------------*/
+class Vec3Stream {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    using Column = std::vector<float, detail::AlignedAllocator<float,
+                                                               alignment>>;
+
+    inline std::size_t size() const { return _x.size(); }
+
+    inline std::span<float>       x()       { return _x; }
+    inline std::span<float>       y()       { return _y; }
+    inline std::span<float>       z()       { return _z; }
+    inline std::span<const float> x() const { return _x; }
+    inline std::span<const float> y() const { return _y; }
+    inline std::span<const float> z() const { return _z; }
+
+    Vec3 get(const std::size_t i) const;
+    void set(const std::size_t i, const Vec3 &v);
+
+    void resize(const std::size_t count);
+    void push_back(const Vec3 &v);
+    void clear();
+
+    void gather(std::span<const Vec3> v);
+    void gather(const Vec3View &v);
+    void scatter(std::span<Vec3> v) const;
+    void scatter(Vec3View v) const;
+
+    void dot(const Vec3 &v, std::span<float> out) const;
+    void dot(const Vec3Stream &v, std::span<float> out) const;
+    void length(std::span<float> out) const;
+
+    void cross(const Vec3 &v);
+    void cross(const Vec3Stream &v);
+    void normalize(const Accuracy accuracy = Accuracy::exact);
+    void project_onto(const Vec3 &v);
+    void project_onto(const Vec3Stream &v);
+
+    // this += v * scale, i.e. positions.add_scaled(velocities, dt).
+    void add_scaled(const Vec3Stream &v, const float scale);
+
+    void transform(const Mat3 &m);
+    void transform(const Mat4 &m);
+    void transform_points(const Mat4 &m);
+
+    const Vec3Stream& operator+=(const Vec3Stream &v);
+    const Vec3Stream& operator-=(const Vec3Stream &v);
+    const Vec3Stream& operator+=(const Vec3 &v);
+    const Vec3Stream& operator*=(const float scalar);
+
+    Vec3Stream() noexcept;
+    explicit Vec3Stream(const std::size_t count);
+    explicit Vec3Stream(std::span<const Vec3> v);
+
+private:
+    Column _x;
+    Column _y;
+    Column _z;
+};
+
+} // namespace pdm
+
+#endif // PDMATH_VEC3STREAM_HPP
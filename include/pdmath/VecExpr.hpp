@@ -0,0 +1,393 @@
+#ifndef PDMATH_VECEXPR_HPP
+#define PDMATH_VECEXPR_HPP
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Vector.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    Lazy vector arithmetic. Wrapping operands with expr::lazy() makes the
+    usual operators build a small tree of nodes instead of a Vec3 per step;
+    nothing is computed until the tree is handed to eval() or assign(), and
+    then the whole chain runs as one inlined expression:
+
+        using namespace pdm::expr;
+        auto k = lazy(axis);
+        auto v = lazy(z_vec);
+        Vec3 r = eval(v * c + cross(k, v) * s + k * (dot(k, v) * (1.0f - c)));
+
+    Leaves can also be spans, of vectors or of per-element scalars. assign()
+    then evaluates the tree once per element in a single loop, with no
+    intermediate arrays, and every component of an element is computed
+    before any of it is stored so the output may alias an input.
+
+    Leaves hold references to their operands, so build and evaluate the
+    expression while those are still alive (ideally in one statement).
+------------------------------------------------------------------------------*/
+namespace expr {
+
+namespace detail {
+
+// Component access shared by Vec3 and the generic Vec<N, T>.
+template<typename V>
+struct traits;
+
+template<>
+struct traits<Vec3> {
+    using value_type = float;
+    static constexpr std::size_t dimension = 3;
+
+    static std::array<float, 3> load(const Vec3 &v) {
+        return {v._x, v._y, v._z};
+    }
+    static void store(Vec3 &v, const std::array<float, 3> &e) {
+        v._x = e[0];
+        v._y = e[1];
+        v._z = e[2];
+    }
+};
+
+template<std::size_t N, typename T>
+struct traits<Vec<N, T>> {
+    using value_type = T;
+    static constexpr std::size_t dimension = N;
+
+    static constexpr std::array<T, N> load(const Vec<N, T> &v) {
+        std::array<T, N> e;
+        for(std::size_t c = 0; c < N; ++c) {
+            e[c] = v._e[c];
+        }
+        return e;
+    }
+    static constexpr void store(Vec<N, T> &v, const std::array<T, N> &e) {
+        for(std::size_t c = 0; c < N; ++c) {
+            v._e[c] = e[c];
+        }
+    }
+};
+
+} // namespace detail
+
+template<typename E>
+concept vec_expr = std::remove_cvref_t<E>::is_vec_expr;
+
+template<typename E>
+concept scalar_expr = std::remove_cvref_t<E>::is_scalar_expr;
+
+/*------------------------------------------------------------------------------
+    Leaves. element(i) gives the components of element i, or the scalar
+    value for scalar nodes; single values ignore i.
+------------------------------------------------------------------------------*/
+template<typename V>
+struct Ref {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = V;
+    using value_type  = typename detail::traits<V>::value_type;
+    static constexpr std::size_t dimension = detail::traits<V>::dimension;
+
+    const V *_v;
+
+    auto element(std::size_t) const { return detail::traits<V>::load(*_v); }
+};
+
+template<typename V>
+struct Span {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = V;
+    using value_type  = typename detail::traits<V>::value_type;
+    static constexpr std::size_t dimension = detail::traits<V>::dimension;
+
+    std::span<const V> _v;
+
+    auto element(std::size_t i) const {
+        return detail::traits<V>::load(_v[i]);
+    }
+};
+
+template<typename T>
+struct Constant {
+    static constexpr bool is_scalar_expr = true;
+    using value_type = T;
+
+    T _s;
+
+    T element(std::size_t) const { return _s; }
+};
+
+template<typename T>
+struct ScalarSpan {
+    static constexpr bool is_scalar_expr = true;
+    using value_type = T;
+
+    std::span<const T> _s;
+
+    T element(std::size_t i) const { return _s[i]; }
+};
+
+inline Ref<Vec3>         lazy(const Vec3 &v)              { return {&v}; }
+inline Span<Vec3>        lazy(std::span<const Vec3> v)    { return {v};  }
+inline ScalarSpan<float> lazy(std::span<const float> s)   { return {s};  }
+
+template<std::size_t N, typename T>
+Ref<Vec<N, T>> lazy(const Vec<N, T> &v) { return {&v}; }
+
+template<std::size_t N, typename T>
+Span<Vec<N, T>> lazy(std::span<const Vec<N, T>> v) { return {v}; }
+
+/*------------------------------------------------------------------------------
+    Interior nodes hold their children by value; they're only a pointer or
+    a span at the bottom, so the whole tree stays small.
+------------------------------------------------------------------------------*/
+template<typename A, typename B, typename Op>
+struct Binary {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = typename A::vector_type;
+    using value_type  = typename A::value_type;
+    static constexpr std::size_t dimension = A::dimension;
+
+    static_assert(A::dimension == B::dimension,
+                  "operands have different dimensions");
+
+    A _a;
+    B _b;
+
+    auto element(std::size_t i) const {
+        auto a = _a.element(i);
+        auto b = _b.element(i);
+        for(std::size_t c = 0; c < dimension; ++c) {
+            a[c] = Op()(a[c], b[c]);
+        }
+        return a;
+    }
+};
+
+// Vector scaled by (or, with Op = divides, divided by) a scalar node.
+template<typename A, typename S, typename Op>
+struct Scaled {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = typename A::vector_type;
+    using value_type  = typename A::value_type;
+    static constexpr std::size_t dimension = A::dimension;
+
+    A _a;
+    S _s;
+
+    auto element(std::size_t i) const {
+        auto a = _a.element(i);
+        auto s = static_cast<value_type>(_s.element(i));
+        for(std::size_t c = 0; c < dimension; ++c) {
+            a[c] = Op()(a[c], s);
+        }
+        return a;
+    }
+};
+
+template<typename A>
+struct Negated {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = typename A::vector_type;
+    using value_type  = typename A::value_type;
+    static constexpr std::size_t dimension = A::dimension;
+
+    A _a;
+
+    auto element(std::size_t i) const {
+        auto a = _a.element(i);
+        for(std::size_t c = 0; c < dimension; ++c) {
+            a[c] = -a[c];
+        }
+        return a;
+    }
+};
+
+template<typename A, typename B>
+struct Cross {
+    static constexpr bool is_vec_expr = true;
+    using vector_type = typename A::vector_type;
+    using value_type  = typename A::value_type;
+    static constexpr std::size_t dimension = 3;
+
+    static_assert(A::dimension == 3 && B::dimension == 3,
+                  "cross needs three components");
+
+    A _a;
+    B _b;
+
+    auto element(std::size_t i) const {
+        auto a = _a.element(i);
+        auto b = _b.element(i);
+        return decltype(a){a[1] * b[2] - a[2] * b[1],
+                           a[2] * b[0] - a[0] * b[2],
+                           a[0] * b[1] - a[1] * b[0]};
+    }
+};
+
+template<typename A, typename B>
+struct Dot {
+    static constexpr bool is_scalar_expr = true;
+    using value_type = typename A::value_type;
+
+    static_assert(A::dimension == B::dimension,
+                  "operands have different dimensions");
+
+    A _a;
+    B _b;
+
+    value_type element(std::size_t i) const {
+        auto a = _a.element(i);
+        auto b = _b.element(i);
+        value_type sum = value_type(0);
+        for(std::size_t c = 0; c < A::dimension; ++c) {
+            sum = static_cast<value_type>(sum + a[c] * b[c]);
+        }
+        return sum;
+    }
+};
+
+template<typename A, typename B, typename Op>
+struct ScalarBinary {
+    static constexpr bool is_scalar_expr = true;
+    using value_type = std::common_type_t<typename A::value_type,
+                                          typename B::value_type>;
+
+    A _a;
+    B _b;
+
+    value_type element(std::size_t i) const {
+        return Op()(static_cast<value_type>(_a.element(i)),
+                    static_cast<value_type>(_b.element(i)));
+    }
+};
+
+namespace detail {
+
+// Plain numbers mix into expressions as constants.
+template<typename S>
+auto as_scalar(const S &s) {
+    if constexpr(scalar_expr<S>) {
+        return s;
+    }
+    else {
+        return Constant<S>{s};
+    }
+}
+
+template<typename S>
+concept scalar_operand = scalar_expr<S> || std::is_arithmetic_v<S>;
+
+template<typename A, typename B>
+concept scalar_pair = scalar_operand<A> && scalar_operand<B> &&
+                      (scalar_expr<A> || scalar_expr<B>);
+
+} // namespace detail
+
+template<vec_expr A, vec_expr B>
+Binary<A, B, std::plus<>> operator+(const A &a, const B &b) {
+    return {a, b};
+}
+
+template<vec_expr A, vec_expr B>
+Binary<A, B, std::minus<>> operator-(const A &a, const B &b) {
+    return {a, b};
+}
+
+template<vec_expr A>
+Negated<A> operator-(const A &a) {
+    return {a};
+}
+
+template<vec_expr A, detail::scalar_operand S>
+auto operator*(const A &a, const S &s) {
+    using Node = decltype(detail::as_scalar(s));
+    return Scaled<A, Node, std::multiplies<>>{a, detail::as_scalar(s)};
+}
+
+template<vec_expr A, detail::scalar_operand S>
+auto operator*(const S &s, const A &a) {
+    return a * s;
+}
+
+template<vec_expr A, detail::scalar_operand S>
+auto operator/(const A &a, const S &s) {
+    using Node = decltype(detail::as_scalar(s));
+    return Scaled<A, Node, std::divides<>>{a, detail::as_scalar(s)};
+}
+
+template<typename A, typename B> requires detail::scalar_pair<A, B>
+auto operator+(const A &a, const B &b) {
+    using L = decltype(detail::as_scalar(a));
+    using R = decltype(detail::as_scalar(b));
+    return ScalarBinary<L, R, std::plus<>>{detail::as_scalar(a),
+                                           detail::as_scalar(b)};
+}
+
+template<typename A, typename B> requires detail::scalar_pair<A, B>
+auto operator-(const A &a, const B &b) {
+    using L = decltype(detail::as_scalar(a));
+    using R = decltype(detail::as_scalar(b));
+    return ScalarBinary<L, R, std::minus<>>{detail::as_scalar(a),
+                                            detail::as_scalar(b)};
+}
+
+template<typename A, typename B> requires detail::scalar_pair<A, B>
+auto operator*(const A &a, const B &b) {
+    using L = decltype(detail::as_scalar(a));
+    using R = decltype(detail::as_scalar(b));
+    return ScalarBinary<L, R, std::multiplies<>>{detail::as_scalar(a),
+                                                 detail::as_scalar(b)};
+}
+
+template<vec_expr A, vec_expr B>
+Cross<A, B> cross(const A &a, const B &b) {
+    return {a, b};
+}
+
+template<vec_expr A, vec_expr B>
+Dot<A, B> dot(const A &a, const B &b) {
+    return {a, b};
+}
+
+template<vec_expr E>
+typename E::vector_type eval(const E &e) {
+    typename E::vector_type v;
+    detail::traits<typename E::vector_type>::store(v, e.element(0));
+    return v;
+}
+
+template<scalar_expr E>
+typename E::value_type eval(const E &e) {
+    return e.element(0);
+}
+
+/*------------------------------------------------------------------------------
+    out[i] = e at element i for every element of out. Span leaves in e must
+    have at least out.size() elements.
+------------------------------------------------------------------------------*/
+template<vec_expr E>
+void assign(std::span<typename E::vector_type> out, const E &e) {
+    using traits = detail::traits<typename E::vector_type>;
+    for(std::size_t i = 0; i < out.size(); ++i) {
+        traits::store(out[i], e.element(i));
+    }
+}
+
+template<scalar_expr E>
+void assign(std::span<typename E::value_type> out, const E &e) {
+    for(std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = e.element(i);
+    }
+}
+
+} // namespace expr
+
+} // namespace pdm
+
+#endif // PDMATH_VECEXPR_HPP
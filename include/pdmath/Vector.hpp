@@ -0,0 +1,292 @@
+#ifndef PDMATH_VECTOR_HPP
+#define PDMATH_VECTOR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define PDMATH_SIMD_SSE2 1
+#endif
+
+// Horizontal sums add their terms in a different order from the scalar
+// loops, which deterministic builds can't have; element-wise ops are exact
+// either way and keep their SIMD paths.
+#if defined(PDMATH_SIMD_SSE2) && !defined(PDMATH_DETERMINISTIC)
+#define PDMATH_SIMD_REDUCE 1
+#endif
+
+namespace pdm {
+class Vec3;
+class Vec4;
+
+/*------------------------------------------------------------------------------
+    N-component vector over any arithmetic T, so doubles, integer grid
+    coordinates and packed storage types all share one set of operations.
+    Everything is constexpr. Vec<4, float> is aligned to a full register
+    and, outside constant evaluation, the arithmetic below runs on SSE.
+    Vec<4, double> runs the same way as a pair of SSE2 registers, so it
+    needs nothing past the x86-64 baseline.
+
+    Vec4 shares Vec4f's layout and forwards its arithmetic here; Vec3 stays
+    as it is. to_vec() and to_vec3()/to_vec4() convert between them and
+    this core.
+------------------------------------------------------------------------------*/
+namespace detail {
+
+template<std::size_t N, typename T>
+inline constexpr bool is_float4 = N == 4 && std::is_same_v<T, float>;
+
+template<std::size_t N, typename T>
+inline constexpr bool is_double4 = N == 4 && std::is_same_v<T, double>;
+
+template<std::size_t N, typename T>
+inline constexpr std::size_t vec_align =
+    is_float4<N, T> || is_double4<N, T> ? 16 : alignof(T);
+
+} // namespace detail
+
+template<std::size_t N, typename T>
+struct alignas(detail::vec_align<N, T>) Vec {
+    static_assert(N > 0, "Vec needs at least one component");
+    static_assert(std::is_arithmetic_v<T>, "Vec needs an arithmetic type");
+
+    T _e[N];
+
+    static constexpr std::size_t size() { return N; }
+
+    static constexpr Vec zero() { return Vec(T(0)); }
+
+    constexpr T&       operator[](std::size_t i)       { return _e[i]; }
+    constexpr const T& operator[](std::size_t i) const { return _e[i]; }
+
+    constexpr T dot(const Vec &v) const;
+    constexpr T length_sq() const { return dot(*this); }
+
+    T    length()     const { return static_cast<T>(std::sqrt(length_sq())); }
+    Vec  normalized() const { return *this / length(); }
+
+    constexpr Vec cross(const Vec &v) const requires (N == 3);
+
+    constexpr Vec() noexcept : _e{} { }
+
+    constexpr explicit Vec(const T fill) noexcept : _e{} {
+        for(std::size_t i = 0; i < N; ++i) {
+            _e[i] = fill;
+        }
+    }
+
+    template<typename... Args>
+        requires (sizeof...(Args) == N && N > 1 &&
+                  (std::is_convertible_v<Args, T> && ...))
+    constexpr Vec(const Args... args) noexcept :
+        _e{static_cast<T>(args)...}
+    { }
+
+    template<typename U>
+    constexpr explicit Vec(const Vec<N, U> &v) noexcept : _e{} {
+        for(std::size_t i = 0; i < N; ++i) {
+            _e[i] = static_cast<T>(v._e[i]);
+        }
+    }
+
+    constexpr bool operator==(const Vec &v) const;
+
+    constexpr Vec& operator+=(const Vec &v) { return *this = *this + v; }
+    constexpr Vec& operator-=(const Vec &v) { return *this = *this - v; }
+    constexpr Vec& operator*=(const T s)    { return *this = *this * s; }
+    constexpr Vec& operator/=(const T s)    { return *this = *this / s; }
+};
+
+using Vec2f = Vec<2, float>;
+using Vec3f = Vec<3, float>;
+using Vec4f = Vec<4, float>;
+using Vec3d = Vec<3, double>;
+using Vec4d = Vec<4, double>;
+using Vec2i = Vec<2, int>;
+using Vec3i = Vec<3, int>;
+
+namespace detail {
+
+#if defined(PDMATH_SIMD_SSE2)
+inline __m128 load(const Vec<4, float> &v)   { return _mm_load_ps(v._e); }
+inline void   store(Vec<4, float> &v, __m128 r) { _mm_store_ps(v._e, r); }
+
+// A Vec<4, double> as its low and high halves.
+struct M128d2 {
+    __m128d lo;
+    __m128d hi;
+};
+
+inline M128d2 load(const Vec<4, double> &v) {
+    return { _mm_load_pd(v._e), _mm_load_pd(v._e + 2) };
+}
+
+inline void store(Vec<4, double> &v, const M128d2 r) {
+    _mm_store_pd(v._e, r.lo);
+    _mm_store_pd(v._e + 2, r.hi);
+}
+#endif
+
+} // namespace detail
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator+(const Vec<N, T> &a, const Vec<N, T> &b) {
+    Vec<N, T> r;
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_SSE2)
+        if constexpr(detail::is_float4<N, T>) {
+            detail::store(r, _mm_add_ps(detail::load(a), detail::load(b)));
+            return r;
+        }
+        if constexpr(detail::is_double4<N, T>) {
+            detail::M128d2 x = detail::load(a);
+            detail::M128d2 y = detail::load(b);
+            detail::store(r, { _mm_add_pd(x.lo, y.lo),
+                               _mm_add_pd(x.hi, y.hi) });
+            return r;
+        }
+#endif
+    }
+    for(std::size_t i = 0; i < N; ++i) {
+        r._e[i] = static_cast<T>(a._e[i] + b._e[i]);
+    }
+    return r;
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator-(const Vec<N, T> &a, const Vec<N, T> &b) {
+    Vec<N, T> r;
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_SSE2)
+        if constexpr(detail::is_float4<N, T>) {
+            detail::store(r, _mm_sub_ps(detail::load(a), detail::load(b)));
+            return r;
+        }
+        if constexpr(detail::is_double4<N, T>) {
+            detail::M128d2 x = detail::load(a);
+            detail::M128d2 y = detail::load(b);
+            detail::store(r, { _mm_sub_pd(x.lo, y.lo),
+                               _mm_sub_pd(x.hi, y.hi) });
+            return r;
+        }
+#endif
+    }
+    for(std::size_t i = 0; i < N; ++i) {
+        r._e[i] = static_cast<T>(a._e[i] - b._e[i]);
+    }
+    return r;
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator-(const Vec<N, T> &a) {
+    return Vec<N, T>() - a;
+}
+
+// Component-wise product.
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator*(const Vec<N, T> &a, const Vec<N, T> &b) {
+    Vec<N, T> r;
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_SSE2)
+        if constexpr(detail::is_float4<N, T>) {
+            detail::store(r, _mm_mul_ps(detail::load(a), detail::load(b)));
+            return r;
+        }
+        if constexpr(detail::is_double4<N, T>) {
+            detail::M128d2 x = detail::load(a);
+            detail::M128d2 y = detail::load(b);
+            detail::store(r, { _mm_mul_pd(x.lo, y.lo),
+                               _mm_mul_pd(x.hi, y.hi) });
+            return r;
+        }
+#endif
+    }
+    for(std::size_t i = 0; i < N; ++i) {
+        r._e[i] = static_cast<T>(a._e[i] * b._e[i]);
+    }
+    return r;
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator*(const Vec<N, T> &a, const T s) {
+    return a * Vec<N, T>(s);
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator*(const T s, const Vec<N, T> &a) {
+    return a * Vec<N, T>(s);
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> operator/(const Vec<N, T> &a, const T s) {
+    Vec<N, T> r;
+    for(std::size_t i = 0; i < N; ++i) {
+        r._e[i] = static_cast<T>(a._e[i] / s);
+    }
+    return r;
+}
+
+template<std::size_t N, typename T>
+constexpr T Vec<N, T>::dot(const Vec &v) const {
+    if(!std::is_constant_evaluated()) {
+#if defined(PDMATH_SIMD_REDUCE)
+        if constexpr(detail::is_float4<N, T>) {
+            __m128 p = _mm_mul_ps(detail::load(*this), detail::load(v));
+            __m128 s = _mm_add_ps(p, _mm_movehl_ps(p, p));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+            return _mm_cvtss_f32(s);
+        }
+        if constexpr(detail::is_double4<N, T>) {
+            detail::M128d2 x = detail::load(*this);
+            detail::M128d2 y = detail::load(v);
+            __m128d s = _mm_add_pd(_mm_mul_pd(x.lo, y.lo),
+                                   _mm_mul_pd(x.hi, y.hi));
+            s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+            return _mm_cvtsd_f64(s);
+        }
+#endif
+    }
+    T sum = static_cast<T>(_e[0] * v._e[0]);
+    for(std::size_t i = 1; i < N; ++i) {
+        sum = static_cast<T>(sum + _e[i] * v._e[i]);
+    }
+    return sum;
+}
+
+template<std::size_t N, typename T>
+constexpr Vec<N, T> Vec<N, T>::cross(const Vec &v) const requires (N == 3) {
+    return Vec(static_cast<T>(_e[1] * v._e[2] - _e[2] * v._e[1]),
+               static_cast<T>(_e[2] * v._e[0] - _e[0] * v._e[2]),
+               static_cast<T>(_e[0] * v._e[1] - _e[1] * v._e[0]));
+}
+
+template<std::size_t N, typename T>
+constexpr bool Vec<N, T>::operator==(const Vec &v) const {
+    for(std::size_t i = 0; i < N; ++i) {
+        if(_e[i] != v._e[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<std::size_t N, typename T>
+std::ostream& operator<<(std::ostream &os, const Vec<N, T> &v) {
+    os << "<";
+    for(std::size_t i = 0; i < N; ++i) {
+        os << v._e[i] << (i + 1 < N ? ", " : "");
+    }
+    return os << ">";
+}
+
+Vec3f to_vec(const Vec3 &v);
+Vec4f to_vec(const Vec4 &v);
+Vec3  to_vec3(const Vec3f &v);
+Vec4  to_vec4(const Vec4f &v);
+
+} // namespace pdm
+
+#endif // PDMATH_VECTOR_HPP
@@ -1,7 +1,10 @@
 #ifndef PDMATH_VECTOR3_HPP
 #define PDMATH_VECTOR3_HPP
 
+#include "pdmath/fastmath.hpp"
+
 #include <iostream>
+#include <span>
 
 namespace pdm {
 class Point3;
@@ -19,6 +22,7 @@ public:
     float dot(const Vec3 &v) const;
 
     Vec3  normalized() const;
+    Vec3  normalized(const Accuracy accuracy) const;
     Vec3  cross(const Vec3 &v) const;
     Vec3  project_onto(const Vec3 &v) const;
     Vec3  projection_perp(const Vec3 &v) const;
@@ -26,6 +30,8 @@ public:
     bool  is_collinear(const Vec3 &v) const;
     bool  is_perpendicular(const Vec3 &v) const;
 
+    static void normalize(std::span<Vec3> v, const Accuracy accuracy);
+
     float _x;
     float _y;
     float _z;
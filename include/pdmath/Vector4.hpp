@@ -8,7 +8,9 @@
 
 namespace pdm {
 
-class Vec4 : public Vec3 {
+// Aligned so the four components load as one SSE register; the layout is
+// still x, y, z, w packed into 16 bytes.
+class alignas(16) Vec4 : public Vec3 {
 public:
     static const Vec4 zero;
     static const Vec4 one;
@@ -75,6 +77,9 @@ Vec4 operator/(const float scalar, const Vec4 &v);
 
 std::ostream& operator<<(std::ostream &os, const Vec4 &p);
 
+static_assert(sizeof(Vec4) == 4 * sizeof(float),
+              "Vec4 must stay four packed floats");
+
 } // namespace pdm
 
 #endif // PDMATH_VECTOR4_HPP
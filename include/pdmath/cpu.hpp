@@ -0,0 +1,39 @@
+#ifndef PDMATH_CPU_HPP
+#define PDMATH_CPU_HPP
+
+#include <cstdint>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    Instruction set tiers the batch kernels are built for. The library
+    itself only assumes the target's baseline (SSE2 on x86-64); wider
+    kernels are compiled alongside and one tier is picked the first time a
+    kernel runs, from what the CPU and OS support.
+
+    Setting PDMATH_ISA to scalar, sse4.2, avx2 or avx512 in the environment
+    caps the choice, for comparing tiers or working around a bad one. A
+    tier the machine can't run is never picked, whatever the variable says.
+------------------------------------------------------------------------------*/
+enum class Isa : uint8_t {
+    scalar,
+    sse42,
+    avx2,
+    avx512
+};
+
+namespace cpu {
+
+// Widest tier this machine can run.
+Isa supported();
+
+// Tier the kernels use, fixed for the life of the process.
+Isa selected();
+
+const char* name(const Isa isa);
+
+} // namespace cpu
+
+} // namespace pdm
+
+#endif // PDMATH_CPU_HPP
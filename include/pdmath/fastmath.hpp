@@ -0,0 +1,327 @@
+#ifndef PDMATH_FASTMATH_HPP
+#define PDMATH_FASTMATH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    Accuracy tiers for the approximations below:
+
+        exact - calls straight into <cmath> or divides
+        high  - error under 1e-5 (relative for rsqrt/rcp, absolute for the
+                trig functions, which land nearer 1e-7)
+        low   - error under 1e-3
+
+    The tier is a template argument, so each call site picks what it can
+    live with and pays nothing for the choice. The approximate paths have
+    no branches and no calls, so loops over them vectorize. sincos range
+    reduction is good for |x| up to a few thousand radians, which covers any
+    angle that hasn't been left to accumulate.
+------------------------------------------------------------------------------*/
+enum class Accuracy {
+    exact,
+    high,
+    low
+};
+
+/*------------------------------------------------------------------------------
+    PDMATH_DETERMINISTIC builds (the CMake option of the same name) promise
+    the same bits on every machine: no fast-math, no FMA contraction and no
+    SIMD path that adds in a different order from its scalar loop. libm
+    isn't covered by that, since every platform rounds its sin and cos a
+    little differently, so code that would call it uses the portable tier
+    instead: exact normally, the polynomials here in deterministic builds.
+------------------------------------------------------------------------------*/
+#if defined(PDMATH_DETERMINISTIC)
+static constexpr bool deterministic = true;
+#else
+static constexpr bool deterministic = false;
+#endif
+
+namespace fastmath {
+
+static constexpr Accuracy portable = deterministic ? Accuracy::high
+                                                   : Accuracy::exact;
+
+// k * pi/2 is taken off in double: the product keeps every bit that matters
+// for the k this range covers, and a single subtraction leaves nothing for
+// -ffast-math to reassociate. A float Cody-Waite split, (x - k*hi) - k*mid
+// - k*lo, gets folded back into x - k*(hi + mid + lo) under fast-math, which
+// is most of the error gone back in.
+static constexpr double pio2    = 1.57079632679489661923;
+static constexpr float  two_opi = 0.636619772367581343f;
+
+template<Accuracy A = Accuracy::high>
+inline void sincos(const float x, float &s, float &c) {
+    if constexpr(A == Accuracy::exact) {
+        s = std::sin(x);
+        c = std::cos(x);
+    }
+    else {
+        // Reduce to r in [-pi/4, pi/4] and the quadrant q.
+        float k = std::floor(x * two_opi + 0.5f);
+        auto  q = static_cast<int32_t>(k);
+        auto  r = static_cast<float>(static_cast<double>(x) -
+                                     static_cast<double>(k) * pio2);
+        float z = r * r;
+
+        float sin_r;
+        float cos_r;
+
+        if constexpr(A == Accuracy::high) {
+            sin_r = r + r * z * (-1.6666654611e-1f +
+                             z * ( 8.3321608736e-3f +
+                             z * (-1.9515295891e-4f)));
+            cos_r = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f +
+                                          z * (-1.388731625493765e-3f +
+                                          z *   2.443315711809948e-5f));
+        }
+        else {
+            sin_r = r + r * z * (-1.6666667e-1f + z * 8.3333333e-3f);
+            cos_r = 1.0f + z * (-0.5f + z * 4.1666667e-2f);
+        }
+
+        // Odd quadrants swap sine and cosine; the sign comes from the
+        // quadrant bits. Written as selects so there's nothing to branch on.
+        bool  swap     = (q & 1) != 0;
+        float sin_sign = (q & 2) != 0 ? -1.0f : 1.0f;
+        float cos_sign = ((q + 1) & 2) != 0 ? -1.0f : 1.0f;
+
+        s = (swap ? cos_r : sin_r) * sin_sign;
+        c = (swap ? sin_r : cos_r) * cos_sign;
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline float sin(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::sin(x);
+    }
+    else {
+        float s;
+        float c;
+        sincos<A>(x, s, c);
+        return s;
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline float cos(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::cos(x);
+    }
+    else {
+        float s;
+        float c;
+        sincos<A>(x, s, c);
+        return c;
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline void sincos(std::span<const float> x, std::span<float> s,
+                   std::span<float> c) {
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        sincos<A>(x[i], s[i], c[i]);
+    }
+}
+
+/*------------------------------------------------------------------------------
+    1/sqrt(x) for x > 0. The starting guess and the tuned first Newton step
+    come from Moroz et al., "Fast calculation of inverse square root with
+    the use of magic constant" (2016), for a relative error of 6.5e-4. The
+    high tier adds two plain Newton steps on top, which lands within an ulp
+    or two of 1/sqrt: one step alone (about 6e-7) is already too loose for
+    code that compares unit vectors at float_epsilon.
+------------------------------------------------------------------------------*/
+template<Accuracy A = Accuracy::high>
+inline float rsqrt(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return 1.0f / std::sqrt(x);
+    }
+    else {
+        float y = std::bit_cast<float>(
+            0x5F1FFFF9u - (std::bit_cast<uint32_t>(x) >> 1));
+        y = 0.703952253f * y * (2.38924456f - x * y * y);
+
+        if constexpr(A == Accuracy::high) {
+            y = y * (1.5f - 0.5f * x * y * y);
+            y = y * (1.5f - 0.5f * x * y * y);
+        }
+
+        return y;
+    }
+}
+
+// 1/x for x != 0, from a bit-level guess and Newton steps.
+template<Accuracy A = Accuracy::high>
+inline float rcp(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return 1.0f / x;
+    }
+    else {
+        float y = std::bit_cast<float>(
+            0x7EF311C3u - std::bit_cast<uint32_t>(x));
+        y = y * (2.0f - x * y);
+        y = y * (2.0f - x * y);
+
+        if constexpr(A == Accuracy::high) {
+            y = y * (2.0f - x * y);
+            y = y * (2.0f - x * y);
+        }
+
+        return y;
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline float sqrt(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::sqrt(x);
+    }
+    else {
+        // x * rsqrt(x) is 0 * (finite) at zero, so no special case needed.
+        return x * rsqrt<A>(x);
+    }
+}
+
+/*------------------------------------------------------------------------------
+    asin on [-1, 1]. Above 0.5 the identity
+
+        asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2))
+
+    pulls the argument back under 0.5 (high, Cephes coefficients). The low
+    tier is Abramowitz & Stegun 4.4.45, which covers [0, 1] in one piece.
+------------------------------------------------------------------------------*/
+template<Accuracy A = Accuracy::high>
+inline float asin(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::asin(x);
+    }
+    else if constexpr(A == Accuracy::high) {
+        float a   = std::abs(x);
+        bool  big = a > 0.5f;
+
+        float z = big ? 0.5f * (1.0f - a) : a * a;
+        float r = big ? std::sqrt(z) : a;
+
+        float p = r + r * z * (1.6666752422e-1f +
+                          z * (7.4953002686e-2f +
+                          z * (4.5470025998e-2f +
+                          z * (2.4181311049e-2f +
+                          z *  4.2163199048e-2f))));
+
+        float result = big ? std::numbers::pi_v<float> / 2.0f - 2.0f * p : p;
+        return std::copysign(result, x);
+    }
+    else {
+        float a = std::abs(x);
+        float p = 1.5707288f + a * (-0.2121144f +
+                               a * ( 0.0742610f +
+                               a *  -0.0187293f));
+
+        float result = std::numbers::pi_v<float> / 2.0f -
+                       std::sqrt(1.0f - a) * p;
+        return std::copysign(result, x);
+    }
+}
+
+/*------------------------------------------------------------------------------
+    acos on [-1, 1] through asin. Near |x| = 1, pi/2 - asin(x) would lose
+    most of its bits to cancellation, so there it's 2 asin(sqrt((1 - x) / 2))
+    instead, which is the same identity asin uses.
+------------------------------------------------------------------------------*/
+template<Accuracy A = Accuracy::high>
+inline float acos(const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::acos(x);
+    }
+    else {
+        float a = std::abs(x);
+        float r = a > 0.5f
+                ? 2.0f * asin<A>(std::sqrt(0.5f * (1.0f - a)))
+                : std::numbers::pi_v<float> / 2.0f - asin<A>(a);
+        return x < 0.0f ? std::numbers::pi_v<float> - r : r;
+    }
+}
+
+/*------------------------------------------------------------------------------
+    atan2 through atan on [0, 1]: divide the smaller magnitude by the
+    larger, then unfold the octant. High reduces once more around
+    tan(pi/8) and uses the Cephes polynomial; low is Abramowitz & Stegun
+    4.4.49 with a reciprocal estimate instead of a divide.
+------------------------------------------------------------------------------*/
+template<Accuracy A = Accuracy::high>
+inline float atan2(const float y, const float x) {
+    if constexpr(A == Accuracy::exact) {
+        return std::atan2(y, x);
+    }
+    else {
+        float ax = std::abs(x);
+        float ay = std::abs(y);
+
+        float hi = std::max(ax, ay);
+        float lo = std::min(ax, ay);
+
+        // 0/0 becomes 0/1, giving atan2(0, 0) = 0 like <cmath>.
+        float t = lo * rcp<A>(hi > 0.0f ? hi : 1.0f);
+        float r;
+
+        if constexpr(A == Accuracy::high) {
+            bool  upper = t > 0.41421356f;
+            float base  = upper ? std::numbers::pi_v<float> / 4.0f : 0.0f;
+            float u     = upper ? (t - 1.0f) / (t + 1.0f) : t;
+            float z     = u * u;
+
+            r = base + u + u * z * (-3.33329491539e-1f +
+                               z * ( 1.99777106478e-1f +
+                               z * (-1.38776856032e-1f +
+                               z *   8.05374449538e-2f)));
+        }
+        else {
+            float z = t * t;
+            r = t * (0.9998660f + z * (-0.3302995f +
+                                  z * ( 0.1801410f +
+                                  z * (-0.0851330f +
+                                  z *   0.0208351f))));
+        }
+
+        r = ay > ax ? std::numbers::pi_v<float> / 2.0f - r : r;
+        r = x < 0.0f ? std::numbers::pi_v<float> - r : r;
+        return std::copysign(r, y);
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline void rsqrt(std::span<const float> x, std::span<float> out) {
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        out[i] = rsqrt<A>(x[i]);
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline void rcp(std::span<const float> x, std::span<float> out) {
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        out[i] = rcp<A>(x[i]);
+    }
+}
+
+template<Accuracy A = Accuracy::high>
+inline void atan2(std::span<const float> y, std::span<const float> x,
+                  std::span<float> out) {
+    for(std::size_t i = 0; i < y.size(); ++i) {
+        out[i] = atan2<A>(y[i], x[i]);
+    }
+}
+
+} // namespace fastmath
+
+} // namespace pdm
+
+#endif // PDMATH_FASTMATH_HPP
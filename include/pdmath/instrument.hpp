@@ -0,0 +1,155 @@
+#ifndef PDMATH_INSTRUMENT_HPP
+#define PDMATH_INSTRUMENT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#if defined(PDMATH_INSTRUMENT)
+#include "pdmath/ticks.hpp"
+
+#include <atomic>
+#endif
+
+namespace pdm::instrument {
+
+/*------------------------------------------------------------------------------
+    Call counters and cycle timers on the hot entry points, for finding out
+    how often they run per frame in a real build. Everything here compiles
+    to nothing unless PDMATH_INSTRUMENT is defined (the CMake option of the
+    same name); the snapshot API stays available either way and just
+    reports zeros.
+
+    Each thread bumps its own counters with plain relaxed stores, so a
+    counted call costs a load and a store. Timing reads the time stamp
+    counter twice on top of that and is off until set_timing(true).
+    frame() sums every thread and returns the change since the previous
+    call, which is the per-frame reset: nothing is ever written back to
+    the threads' counters.
+------------------------------------------------------------------------------*/
+enum class Counter : uint8_t {
+    obbox_collides,
+    mat4_inverted,
+    bsphere_constructed,
+    count
+};
+
+static constexpr std::size_t counter_count =
+    static_cast<std::size_t>(Counter::count);
+
+#if defined(PDMATH_INSTRUMENT)
+static constexpr bool compiled_in = true;
+#else
+static constexpr bool compiled_in = false;
+#endif
+
+struct Stats {
+    uint64_t calls = 0;
+    uint64_t ticks = 0;     // only from timed calls
+
+    double ticks_per_call() const {
+        return calls ? static_cast<double>(ticks) /
+                       static_cast<double>(calls) : 0.0;
+    }
+};
+
+struct Snapshot {
+    std::array<Stats, counter_count> stats{};
+
+    const Stats& operator[](const Counter c) const {
+        return stats[static_cast<std::size_t>(c)];
+    }
+
+    Snapshot operator-(const Snapshot &rhs) const;
+};
+
+const char* name(const Counter c);
+
+// Totals since startup, including threads that have since exited.
+Snapshot snapshot();
+
+// Totals since the previous frame() call; call it once per frame.
+Snapshot frame();
+
+void set_timing(const bool on);
+bool timing();
+
+std::ostream& operator<<(std::ostream &os, const Snapshot &s);
+
+#if defined(PDMATH_INSTRUMENT)
+namespace detail {
+
+struct ThreadCounters {
+    std::array<std::atomic<uint64_t>, counter_count> calls{};
+    std::array<std::atomic<uint64_t>, counter_count> ticks{};
+
+    ThreadCounters();
+    ~ThreadCounters();
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+};
+
+extern thread_local ThreadCounters local_counters;
+extern std::atomic<bool> timing_on;
+
+// Only the owning thread writes, so there's no need for a locked add.
+inline void bump(std::atomic<uint64_t> &value, const uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+inline void count(const Counter c) {
+    detail::bump(detail::local_counters.calls[static_cast<std::size_t>(c)],
+                 1);
+}
+
+// Counts the call and, while timing is on, the ticks until scope exit.
+class Timer {
+public:
+    explicit Timer(const Counter c) :
+        _index{static_cast<std::size_t>(c)},
+        _timed{detail::timing_on.load(std::memory_order_relaxed)},
+        _start{_timed ? ticks() : 0}
+    { }
+
+    ~Timer() {
+        detail::ThreadCounters &local = detail::local_counters;
+        detail::bump(local.calls[_index], 1);
+        if(_timed) {
+            detail::bump(local.ticks[_index], ticks() - _start);
+        }
+    }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+private:
+    std::size_t _index;
+    bool        _timed;
+    uint64_t    _start;
+};
+#endif
+
+} // namespace pdm::instrument
+
+#define PDMATH_INSTRUMENT_CONCAT_(a, b) a##b
+#define PDMATH_INSTRUMENT_CONCAT(a, b)  PDMATH_INSTRUMENT_CONCAT_(a, b)
+
+// PDMATH_COUNT(obbox_collides); or PDMATH_TIME(mat4_inverted); at the top
+// of a function body.
+#if defined(PDMATH_INSTRUMENT)
+#define PDMATH_COUNT(counter) \
+    pdm::instrument::count(pdm::instrument::Counter::counter)
+#define PDMATH_TIME(counter)                                                  \
+    pdm::instrument::Timer PDMATH_INSTRUMENT_CONCAT(pdmath_timer_, __LINE__)( \
+        pdm::instrument::Counter::counter)
+#else
+#define PDMATH_COUNT(counter) ((void)0)
+#define PDMATH_TIME(counter)  ((void)0)
+#endif
+
+#endif // PDMATH_INSTRUMENT_HPP
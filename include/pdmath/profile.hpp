@@ -0,0 +1,123 @@
+#ifndef PDMATH_PROFILE_HPP
+#define PDMATH_PROFILE_HPP
+
+#include <ostream>
+#include <string>
+
+#if defined(PDMATH_PROFILE)
+#include "pdmath/ticks.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#endif
+
+namespace pdm::profile {
+
+/*------------------------------------------------------------------------------
+    Scoped zones for seeing where a frame goes. PDMATH_ZONE("name") at the
+    top of a scope records its start and end ticks into a ring buffer
+    owned by the calling thread; write_chrome_trace() turns every thread's
+    buffer into Chrome trace-event JSON, which chrome://tracing or Perfetto
+    open straight from disk.
+
+    Compiled out unless PDMATH_PROFILE is defined (the CMake option of the
+    same name). A zone costs two tick reads and one store into the ring;
+    once a thread has recorded events_per_thread zones the oldest are
+    overwritten, so a long session keeps its most recent frames. Names
+    must be string literals or otherwise outlive the export.
+
+    Export reads other threads' buffers without stopping them, so call it
+    while the traced work is idle, e.g. between frames.
+------------------------------------------------------------------------------*/
+#if defined(PDMATH_PROFILE)
+static constexpr bool compiled_in = true;
+#else
+static constexpr bool compiled_in = false;
+#endif
+
+void set_recording(const bool on);
+bool recording();
+
+// Shows up as the thread's name in the viewer.
+void set_thread_name(const char *name);
+
+// Drops everything recorded so far, including exited threads' buffers.
+void clear();
+
+// Always writes a valid trace, empty when profiling is compiled out.
+void write_chrome_trace(std::ostream &os);
+bool write_chrome_trace(const std::string &path);
+
+#if defined(PDMATH_PROFILE)
+namespace detail {
+
+static constexpr std::size_t events_per_thread = std::size_t(1) << 14;
+
+struct Event {
+    const char *name;
+    uint64_t    start;
+    uint64_t    end;
+};
+
+struct ThreadBuffer {
+    Event                 events[events_per_thread];
+    std::atomic<uint64_t> head{0};
+    uint32_t              id;
+    const char           *name = nullptr;
+    bool                  live = true;
+};
+
+extern thread_local ThreadBuffer *local_buffer;
+extern std::atomic<bool>          recording_on;
+
+ThreadBuffer* attach_thread();
+
+} // namespace detail
+
+class Zone {
+public:
+    explicit Zone(const char *name) :
+        _name{detail::recording_on.load(std::memory_order_relaxed)
+              ? name : nullptr},
+        _start{_name ? ticks() : 0}
+    { }
+
+    ~Zone() {
+        if(!_name) {
+            return;
+        }
+        uint64_t end = ticks();
+
+        detail::ThreadBuffer *b = detail::local_buffer;
+        if(!b) {
+            b = detail::attach_thread();
+        }
+        uint64_t h = b->head.load(std::memory_order_relaxed);
+        b->events[h % detail::events_per_thread] = {_name, _start, end};
+        b->head.store(h + 1, std::memory_order_release);
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char *_name;
+    uint64_t    _start;
+};
+#endif
+
+} // namespace pdm::profile
+
+#define PDMATH_PROFILE_CONCAT_(a, b) a##b
+#define PDMATH_PROFILE_CONCAT(a, b)  PDMATH_PROFILE_CONCAT_(a, b)
+
+// PDMATH_ZONE("OcclusionBuffer::rasterize"); at the top of a scope.
+#if defined(PDMATH_PROFILE)
+#define PDMATH_ZONE(name)                                                     \
+    pdm::profile::Zone PDMATH_PROFILE_CONCAT(pdmath_zone_, __LINE__)(name)
+#else
+#define PDMATH_ZONE(name) ((void)0)
+#endif
+
+#endif // PDMATH_PROFILE_HPP
@@ -0,0 +1,30 @@
+#ifndef PDMATH_TICKS_HPP
+#define PDMATH_TICKS_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PDMATH_TICKS_RDTSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PDMATH_TICKS_RDTSC 1
+#endif
+
+namespace pdm {
+
+// The time stamp counter where there is one, steady_clock nanoseconds
+// elsewhere. Only differences mean anything, and only on one machine.
+inline uint64_t ticks() {
+#if defined(PDMATH_TICKS_RDTSC)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+} // namespace pdm
+
+#endif // PDMATH_TICKS_HPP
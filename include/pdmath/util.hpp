@@ -9,6 +9,9 @@ namespace pdm {
 static constexpr uint8_t float_precision = 7;
 static constexpr float   float_epsilon = 1.0e-6f;
 
+static constexpr uint8_t double_precision = 15;
+static constexpr double  double_epsilon   = 1.0e-9;
+
 static float clamp(const float val, const float min, const float max) {
     if(val > max) {
         return max;
@@ -0,0 +1,240 @@
+#include "pdmath/Affine3.hpp"
+
+#include "pdmath/util.hpp"
+#include "pdmath/Point3.hpp"
+#include "pdmath/Point4.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Vector.hpp"
+
+#include <iomanip>
+
+namespace pdm {
+
+const Affine3 Affine3::identity(1.0f, 0.0f, 0.0f, 0.0f,
+                                0.0f, 1.0f, 0.0f, 0.0f,
+                                0.0f, 0.0f, 1.0f, 0.0f);
+
+/*------------------------------------------------------------------------------
+    [A t]^-1 = [A^-1  -A^-1 t], with A^-1 from the cofactors of the 3x3. A
+    singular linear part comes back as all zeros, like Mat<>::inverted().
+------------------------------------------------------------------------------*/
+Affine3 Affine3::inverted() const {
+    float c00 = _m[1][1] * _m[2][2] - _m[1][2] * _m[2][1];
+    float c01 = _m[1][2] * _m[2][0] - _m[1][0] * _m[2][2];
+    float c02 = _m[1][0] * _m[2][1] - _m[1][1] * _m[2][0];
+
+    float det = _m[0][0] * c00 + _m[0][1] * c01 + _m[0][2] * c02;
+    if(det == 0.0f) {
+        return Affine3();
+    }
+    float inv_det = 1.0f / det;
+
+    Affine3 inv;
+    inv._m[0][0] = c00 * inv_det;
+    inv._m[1][0] = c01 * inv_det;
+    inv._m[2][0] = c02 * inv_det;
+
+    inv._m[0][1] = (_m[0][2] * _m[2][1] - _m[0][1] * _m[2][2]) * inv_det;
+    inv._m[1][1] = (_m[0][0] * _m[2][2] - _m[0][2] * _m[2][0]) * inv_det;
+    inv._m[2][1] = (_m[0][1] * _m[2][0] - _m[0][0] * _m[2][1]) * inv_det;
+
+    inv._m[0][2] = (_m[0][1] * _m[1][2] - _m[0][2] * _m[1][1]) * inv_det;
+    inv._m[1][2] = (_m[0][2] * _m[1][0] - _m[0][0] * _m[1][2]) * inv_det;
+    inv._m[2][2] = (_m[0][0] * _m[1][1] - _m[0][1] * _m[1][0]) * inv_det;
+
+    for(std::size_t r = 0; r < 3; ++r) {
+        inv._m[r][3] = -(inv._m[r][0] * _m[0][3] +
+                         inv._m[r][1] * _m[1][3] +
+                         inv._m[r][2] * _m[2][3]);
+    }
+
+    return inv;
+}
+
+// Same steps as Mat4::inverted_trs(), so the two agree exactly on the
+// same transform: undo the translation, then the rotation, then the scale.
+Affine3 Affine3::inverted_trs() const {
+    float x_scale = get_x_scale();
+    float y_scale = get_y_scale();
+    float z_scale = get_z_scale();
+
+    Vec3 x_rot(_m[0][0] / x_scale, _m[1][0] / x_scale, _m[2][0] / x_scale);
+    Vec3 y_rot(_m[0][1] / y_scale, _m[1][1] / y_scale, _m[2][1] / y_scale);
+    Vec3 z_rot(_m[0][2] / z_scale, _m[1][2] / z_scale, _m[2][2] / z_scale);
+
+    Affine3 t_inv(1.0f, 0.0f, 0.0f, -_m[0][3],
+                  0.0f, 1.0f, 0.0f, -_m[1][3],
+                  0.0f, 0.0f, 1.0f, -_m[2][3]);
+
+    Affine3 r_inv(x_rot._x, x_rot._y, x_rot._z, 0.0f,
+                  y_rot._x, y_rot._y, y_rot._z, 0.0f,
+                  z_rot._x, z_rot._y, z_rot._z, 0.0f);
+
+    Affine3 s_inv(1/x_scale, 0.0f,      0.0f,      0.0f,
+                  0.0f,      1/y_scale, 0.0f,      0.0f,
+                  0.0f,      0.0f,      1/z_scale, 0.0f);
+
+    return s_inv * r_inv * t_inv;
+}
+
+Mat4 Affine3::to_mat4() const {
+    return Mat4(_m[0][0], _m[0][1], _m[0][2], _m[0][3],
+                _m[1][0], _m[1][1], _m[1][2], _m[1][3],
+                _m[2][0], _m[2][1], _m[2][2], _m[2][3],
+                0.0f,     0.0f,     0.0f,     1.0f);
+}
+
+Mat3 Affine3::linear() const {
+    return Mat3(_m[0][0], _m[0][1], _m[0][2],
+                _m[1][0], _m[1][1], _m[1][2],
+                _m[2][0], _m[2][1], _m[2][2]);
+}
+
+Vec3 Affine3::get_world_position() const {
+    return Vec3(_m[0][3], _m[1][3], _m[2][3]);
+}
+
+Vec3 Affine3::get_x_vec() const {
+    return Vec3(_m[0][0], _m[1][0], _m[2][0]);
+}
+
+float Affine3::get_x_scale() const {
+    return Vec3(_m[0][0], _m[1][0], _m[2][0]).length();
+}
+
+float Affine3::get_y_scale() const {
+    return Vec3(_m[0][1], _m[1][1], _m[2][1]).length();
+}
+
+float Affine3::get_z_scale() const {
+    return Vec3(_m[0][2], _m[1][2], _m[2][2]).length();
+}
+
+const Affine3& Affine3::set_translation(const Vec3 &v) {
+    _m[0][3] = v._x;
+    _m[1][3] = v._y;
+    _m[2][3] = v._z;
+    return *this;
+}
+
+const Affine3& Affine3::apply_scale(const Vec3 &v) {
+    for(std::size_t r = 0; r < 3; ++r) {
+        _m[r][0] *= v._x;
+        _m[r][1] *= v._y;
+        _m[r][2] *= v._z;
+    }
+    return *this;
+}
+
+Affine3::Affine3(const float x1, const float y1, const float z1,
+                 const float w1,
+                 const float x2, const float y2, const float z2,
+                 const float w2,
+                 const float x3, const float y3, const float z3,
+                 const float w3) noexcept :
+    _m{{x1, y1, z1, w1},
+       {x2, y2, z2, w2},
+       {x3, y3, z3, w3}}
+{ }
+
+Affine3::Affine3(const Mat3 &linear, const Vec3 &translation) noexcept :
+    _m{{linear._m[0][0], linear._m[0][1], linear._m[0][2], translation._x},
+       {linear._m[1][0], linear._m[1][1], linear._m[1][2], translation._y},
+       {linear._m[2][0], linear._m[2][1], linear._m[2][2], translation._z}}
+{ }
+
+Affine3::Affine3(const Mat4 &m) noexcept :
+    _m{{m._m[0][0], m._m[0][1], m._m[0][2], m._m[0][3]},
+       {m._m[1][0], m._m[1][1], m._m[1][2], m._m[1][3]},
+       {m._m[2][0], m._m[2][1], m._m[2][2], m._m[2][3]}}
+{ }
+
+bool Affine3::operator==(const Affine3 &a) const {
+    for(std::size_t c = 0; c < 4; ++c) {
+        Vec3 mine(_m[0][c], _m[1][c], _m[2][c]);
+        Vec3 theirs(a._m[0][c], a._m[1][c], a._m[2][c]);
+        if(!(mine == theirs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const Affine3& Affine3::operator*=(const Affine3 &a) {
+    *this = *this * a;
+    return *this;
+}
+
+/*------------------------------------------------------------------------------
+    Row r of the product is the rows of b weighted by row r of a, where b's
+    missing bottom row is 0 0 0 1: it only adds a's translation. Three rows
+    of four multiply-adds, against four for a Mat4.
+------------------------------------------------------------------------------*/
+Affine3 operator*(const Affine3 &a, const Affine3 &b) {
+    Affine3 p;
+#if defined(PDMATH_SIMD_SSE2)
+    const __m128 bottom = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    for(std::size_t r = 0; r < 3; ++r) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a._m[r][0]),
+                                _mm_load_ps(b._m[0]));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a._m[r][1]),
+                                         _mm_load_ps(b._m[1])));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a._m[r][2]),
+                                         _mm_load_ps(b._m[2])));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a._m[r][3]), bottom));
+        _mm_store_ps(p._m[r], row);
+    }
+#else
+    for(std::size_t r = 0; r < 3; ++r) {
+        for(std::size_t c = 0; c < 3; ++c) {
+            p._m[r][c] = a._m[r][0] * b._m[0][c] +
+                         a._m[r][1] * b._m[1][c] +
+                         a._m[r][2] * b._m[2][c];
+        }
+        p._m[r][3] = a._m[r][0] * b._m[0][3] +
+                     a._m[r][1] * b._m[1][3] +
+                     a._m[r][2] * b._m[2][3] +
+                     a._m[r][3];
+    }
+#endif
+    return p;
+}
+
+Point3 operator*(const Affine3 &a, const Point3 &p) {
+    return Point3(a._m[0][0] * p._x + a._m[0][1] * p._y +
+                  a._m[0][2] * p._z + a._m[0][3],
+                  a._m[1][0] * p._x + a._m[1][1] * p._y +
+                  a._m[1][2] * p._z + a._m[1][3],
+                  a._m[2][0] * p._x + a._m[2][1] * p._y +
+                  a._m[2][2] * p._z + a._m[2][3]);
+}
+
+Vec3 operator*(const Affine3 &a, const Vec3 &v) {
+    return Vec3(a._m[0][0] * v._x + a._m[0][1] * v._y + a._m[0][2] * v._z,
+                a._m[1][0] * v._x + a._m[1][1] * v._y + a._m[1][2] * v._z,
+                a._m[2][0] * v._x + a._m[2][1] * v._y + a._m[2][2] * v._z);
+}
+
+Point4 operator*(const Affine3 &a, const Point4 &p) {
+    return Point4(a._m[0][0] * p._x + a._m[0][1] * p._y +
+                  a._m[0][2] * p._z + a._m[0][3] * p._w,
+                  a._m[1][0] * p._x + a._m[1][1] * p._y +
+                  a._m[1][2] * p._z + a._m[1][3] * p._w,
+                  a._m[2][0] * p._x + a._m[2][1] * p._y +
+                  a._m[2][2] * p._z + a._m[2][3] * p._w,
+                  p._w);
+}
+
+std::ostream& operator<<(std::ostream &os, const Affine3 &a) {
+    os << std::fixed << std::setprecision(float_precision)
+       << "[" << a._m[0][0] << ", " << a._m[0][1] << ", "
+       << a._m[0][2] << ", " << a._m[0][3] << "]\n"
+       << "[" << a._m[1][0] << ", " << a._m[1][1] << ", "
+       << a._m[1][2] << ", " << a._m[1][3] << "]\n"
+       << "[" << a._m[2][0] << ", " << a._m[2][1] << ", "
+       << a._m[2][2] << ", " << a._m[2][3] << "]";
+    return os;
+}
+
+} // namespace pdm
@@ -0,0 +1,286 @@
+#include "pdmath/Animation.hpp"
+
+#include "pdmath/Vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace pdm {
+
+uint32_t AnimationClip::add_track(std::span<const float> times,
+                                  std::span<const Vec3>  translations,
+                                  std::span<const Quat>  rotations,
+                                  std::span<const Vec3>  scales) {
+    std::size_t count = std::min({times.size(), translations.size(),
+                                  rotations.size(), scales.size()});
+
+    if(count == 0) {
+        static constexpr float time = 0.0f;
+        return add_track(std::span(&time, 1), std::span(&Vec3::zero, 1),
+                         std::span(&Quat::identity, 1),
+                         std::span(&Vec3::one, 1));
+    }
+
+    _tracks.push_back(Track{static_cast<uint32_t>(_times.size()),
+                            static_cast<uint32_t>(count)});
+
+    for(std::size_t i = 0; i < count; ++i) {
+        _times.push_back(times[i]);
+
+        _tx.push_back(translations[i]._x);
+        _ty.push_back(translations[i]._y);
+        _tz.push_back(translations[i]._z);
+
+        _rw.push_back(rotations[i]._w);
+        _rx.push_back(rotations[i]._v._x);
+        _ry.push_back(rotations[i]._v._y);
+        _rz.push_back(rotations[i]._v._z);
+
+        _sx.push_back(scales[i]._x);
+        _sy.push_back(scales[i]._y);
+        _sz.push_back(scales[i]._z);
+    }
+
+    _duration = std::max(_duration, times[count - 1]);
+
+    return static_cast<uint32_t>(_tracks.size() - 1);
+}
+
+AnimationClip::AnimationClip() noexcept :
+    _duration{0.0f}
+{ }
+
+void AnimationSampler::sample(const float time,
+                              std::span<Vec3> translations,
+                              std::span<Quat> rotations,
+                              std::span<Vec3> scales) {
+    find_keys(time);
+    interpolate(translations, rotations, scales);
+}
+
+void AnimationSampler::sample(const float time, std::span<Mat4> locals) {
+    find_keys(time);
+    assert(locals.size() >= _keys.size());
+
+    interpolate(_translations, _rotations, _scales);
+
+    for(std::size_t i = 0; i < _keys.size(); ++i) {
+        locals[i] = _rotations[i].to_mat4();
+        locals[i].apply_scale(_scales[i]);
+        locals[i].set_translation(_translations[i]);
+    }
+}
+
+void AnimationSampler::reset() {
+    std::fill(_cursors.begin(), _cursors.end(), 0);
+    _last_time = 0.0f;
+}
+
+void AnimationSampler::find_keys(const float time) {
+    const AnimationClip &clip = *_clip;
+    bool rewound = time < _last_time;
+
+    // Tracks added since the last call start from their first key.
+    std::size_t track_count = clip.track_count();
+    if(_keys.size() != track_count) {
+        _cursors.resize(track_count, 0);
+        _keys.resize(track_count);
+        _next_keys.resize(track_count);
+        _alphas.resize(track_count);
+        _translations.resize(track_count);
+        _rotations.resize(track_count);
+        _scales.resize(track_count);
+    }
+
+    for(std::size_t i = 0; i < clip._tracks.size(); ++i) {
+        const AnimationClip::Track &track = clip._tracks[i];
+        const float *times = clip._times.data() + track.first;
+
+        if(track.count < 2) {
+            _keys[i]      = track.first;
+            _next_keys[i] = track.first;
+            _alphas[i]    = 0.0f;
+            continue;
+        }
+
+        uint32_t cursor = _cursors[i];
+        uint32_t last   = track.count - 2;
+
+        if(rewound) {
+            auto upper = std::upper_bound(times, times + track.count, time);
+            auto found = static_cast<uint32_t>(std::max<std::ptrdiff_t>(
+                (upper - times) - 1, 0));
+            cursor = std::min(found, last);
+        }
+        else {
+            while(cursor < last && times[cursor + 1] <= time) {
+                ++cursor;
+            }
+        }
+
+        _cursors[i] = cursor;
+
+        float span  = times[cursor + 1] - times[cursor];
+        float alpha = span > 0.0f ? (time - times[cursor]) / span : 0.0f;
+
+        _keys[i]      = track.first + cursor;
+        _next_keys[i] = track.first + cursor + 1;
+        _alphas[i]    = std::clamp(alpha, 0.0f, 1.0f);
+    }
+
+    _last_time = time;
+}
+
+/*------------------------------------------------------------------------------
+    Translation and scale lerp; rotation is an nlerp along the shorter arc.
+    The hemisphere flip is a sign multiply rather than a branch.
+
+    With SSE2 four tracks go at once: their keys are gathered from the
+    component arrays into one register per component, and each lane does
+    the single-track arithmetic in the same order, so both give the same
+    results. The tracks left over go one at a time.
+------------------------------------------------------------------------------*/
+void AnimationSampler::interpolate(std::span<Vec3> translations,
+                                   std::span<Quat> rotations,
+                                   std::span<Vec3> scales) const {
+    std::size_t count = _keys.size();
+    assert(translations.size() >= count);
+    assert(rotations.size() >= count);
+    assert(scales.size() >= count);
+
+    std::size_t i = 0;
+
+#if defined(PDMATH_SIMD_SSE2)
+    static_assert(sizeof(Quat) == 4 * sizeof(float));
+
+    const AnimationClip &clip = *_clip;
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+
+    for(; i + 4 <= count; i += 4) {
+        const uint32_t *a = &_keys[i];
+        const uint32_t *b = &_next_keys[i];
+
+        auto gather = [](const std::vector<float> &c, const uint32_t *k) {
+            return _mm_setr_ps(c[k[0]], c[k[1]], c[k[2]], c[k[3]]);
+        };
+        auto lerp = [&](const std::vector<float> &c, const __m128 t) {
+            __m128 from = gather(c, a);
+            return _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(gather(c, b), from),
+                                               t));
+        };
+
+        __m128 t = _mm_loadu_ps(&_alphas[i]);
+
+        alignas(16) float out[6][4];
+        _mm_store_ps(out[0], lerp(clip._tx, t));
+        _mm_store_ps(out[1], lerp(clip._ty, t));
+        _mm_store_ps(out[2], lerp(clip._tz, t));
+        _mm_store_ps(out[3], lerp(clip._sx, t));
+        _mm_store_ps(out[4], lerp(clip._sy, t));
+        _mm_store_ps(out[5], lerp(clip._sz, t));
+
+        for(std::size_t j = 0; j < 4; ++j) {
+            translations[i + j] = Vec3(out[0][j], out[1][j], out[2][j]);
+            scales[i + j]       = Vec3(out[3][j], out[4][j], out[5][j]);
+        }
+
+        __m128 aw = gather(clip._rw, a);
+        __m128 ax = gather(clip._rx, a);
+        __m128 ay = gather(clip._ry, a);
+        __m128 az = gather(clip._rz, a);
+        __m128 bw = gather(clip._rw, b);
+        __m128 bx = gather(clip._rx, b);
+        __m128 by = gather(clip._ry, b);
+        __m128 bz = gather(clip._rz, b);
+
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bw),
+                                                      _mm_mul_ps(ax, bx)),
+                                           _mm_mul_ps(ay, by)),
+                                _mm_mul_ps(az, bz));
+
+        // copysign(t, dot); t is never negative
+        __m128 weight_a = _mm_sub_ps(one, t);
+        __m128 weight_b = _mm_or_ps(t, _mm_and_ps(dot, sign));
+
+        __m128 w = _mm_add_ps(_mm_mul_ps(weight_a, aw),
+                              _mm_mul_ps(weight_b, bw));
+        __m128 x = _mm_add_ps(_mm_mul_ps(weight_a, ax),
+                              _mm_mul_ps(weight_b, bx));
+        __m128 y = _mm_add_ps(_mm_mul_ps(weight_a, ay),
+                              _mm_mul_ps(weight_b, by));
+        __m128 z = _mm_add_ps(_mm_mul_ps(weight_a, az),
+                              _mm_mul_ps(weight_b, bz));
+
+        __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w),
+                                                            _mm_mul_ps(x, x)),
+                                                 _mm_mul_ps(y, y)),
+                                      _mm_mul_ps(z, z));
+        __m128 inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_sq));
+
+        w = _mm_mul_ps(w, inv_length);
+        x = _mm_mul_ps(x, inv_length);
+        y = _mm_mul_ps(y, inv_length);
+        z = _mm_mul_ps(z, inv_length);
+
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        _mm_storeu_ps(&rotations[i]._w,     w);
+        _mm_storeu_ps(&rotations[i + 1]._w, x);
+        _mm_storeu_ps(&rotations[i + 2]._w, y);
+        _mm_storeu_ps(&rotations[i + 3]._w, z);
+    }
+#endif
+
+    for(; i < count; ++i) {
+        interpolate(i, translations[i], rotations[i], scales[i]);
+    }
+}
+
+void AnimationSampler::interpolate(const std::size_t track,
+                                   Vec3 &translation, Quat &rotation,
+                                   Vec3 &scale) const {
+    const AnimationClip &clip = *_clip;
+
+    uint32_t a = _keys[track];
+    uint32_t b = _next_keys[track];
+    float    t = _alphas[track];
+
+    translation = Vec3(clip._tx[a] + (clip._tx[b] - clip._tx[a]) * t,
+                       clip._ty[a] + (clip._ty[b] - clip._ty[a]) * t,
+                       clip._tz[a] + (clip._tz[b] - clip._tz[a]) * t);
+
+    scale = Vec3(clip._sx[a] + (clip._sx[b] - clip._sx[a]) * t,
+                 clip._sy[a] + (clip._sy[b] - clip._sy[a]) * t,
+                 clip._sz[a] + (clip._sz[b] - clip._sz[a]) * t);
+
+    float dot = clip._rw[a] * clip._rw[b] + clip._rx[a] * clip._rx[b] +
+                clip._ry[a] * clip._ry[b] + clip._rz[a] * clip._rz[b];
+
+    float weight_a = 1.0f - t;
+    float weight_b = std::copysign(t, dot);
+
+    float w = weight_a * clip._rw[a] + weight_b * clip._rw[b];
+    float x = weight_a * clip._rx[a] + weight_b * clip._rx[b];
+    float y = weight_a * clip._ry[a] + weight_b * clip._ry[b];
+    float z = weight_a * clip._rz[a] + weight_b * clip._rz[b];
+
+    float inv_length = 1.0f / std::sqrt(w*w + x*x + y*y + z*z);
+
+    rotation = Quat(w * inv_length, x * inv_length,
+                    y * inv_length, z * inv_length);
+}
+
+AnimationSampler::AnimationSampler(const AnimationClip &clip) :
+    _clip{&clip},
+    _cursors(clip.track_count(), 0),
+    _keys(clip.track_count(), 0),
+    _next_keys(clip.track_count(), 0),
+    _alphas(clip.track_count(), 0.0f),
+    _translations(clip.track_count()),
+    _rotations(clip.track_count()),
+    _scales(clip.track_count()),
+    _last_time{0.0f}
+{ }
+
+} // namespace pdm
@@ -1,6 +1,7 @@
 #include "pdmath/BSphere.hpp"
 
 #include "pdmath/util.hpp"
+#include "pdmath/fastmath.hpp"
 #include "pdmath/Vector4.hpp"
 #include "pdmath/AABBox.hpp"
 #include "pdmath/OBBox.hpp"
@@ -36,7 +37,8 @@ bool BSphere::collides(const OBBox &box) const {
 bool BSphere::collides(const Plane &plane) const {
     Vec3 c_minus_p(_center - plane.point());
     float distance = std::abs(c_minus_p.dot(plane.normal()));
-    distance /= plane.normal().length();
+    distance *= fastmath::rsqrt<Accuracy::high>(
+        plane.normal().dot(plane.normal()));
 
     return distance < _radius;
 }
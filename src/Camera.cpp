@@ -2,7 +2,13 @@
 
 #include "pdmath/Point4.hpp"
 #include "pdmath/Vector4.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Matrix4d.hpp"
+#include "pdmath/Vector.hpp"
+#include "pdmath/profile.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace pdm {
@@ -34,6 +40,21 @@ namespace pdm {
                               v_side._z, v_up._z, _gaze._z, _position._z,
                               0,         0,       0,        1);
         _world_to_view = _view_to_world.inverted();
+
+        update_world_to_screen();
+    }
+
+    Point3 Camera::rebase(const Point3d &point) const {
+        return point.relative_to(_origin);
+    }
+
+    Mat4 Camera::rebase(const Mat4d &world) const {
+        return world.relative_to(_origin);
+    }
+
+    void Camera::rebase(std::span<const Mat4d> worlds,
+                        std::span<Mat4>        relative) const {
+        Mat4d::relative_to(worlds, _origin, relative);
     }
 
     void Camera::set_ortho(const float left,  const float right,
@@ -41,6 +62,12 @@ namespace pdm {
                            const float near,  const float far,
                            const float x_res, const float y_res,
                            const float z_depth) {
+        _near    = near;
+        _far     = far;
+        _x_res   = x_res;
+        _y_res   = y_res;
+        _z_depth = z_depth;
+
         _ortho_ndc =
             Mat4((2/(right - left)), 0, 0, -((right + left)/(right - left)),
                  0, (2/(top - bottom)), 0, -((top + bottom)/(top - bottom)),
@@ -52,11 +79,21 @@ namespace pdm {
                  0.0f,       -y_res/2.0f, 0.0f,         y_res/2.0f,
                  0.0f,       0.0f,        z_depth/2.0f, z_depth/2.0f,
                  0.0f,       0.0f,        0.0f,         1.0f);
+
+        _projection = Projection::ortho;
+        update_world_to_screen();
     }
 
     void Camera::set_persp(const float near,  const float far,
                            const float x_res, const float y_res,
                            const float fov,   const float z_depth) {
+        _near    = near;
+        _far     = far;
+        _fov     = fov;
+        _x_res   = x_res;
+        _y_res   = y_res;
+        _z_depth = z_depth;
+
         float aspect   = x_res / y_res;
         float half_fov = fov / 2.0f;
         float distance = std::cos(half_fov) / std::sin(half_fov);
@@ -74,6 +111,9 @@ namespace pdm {
                  0.0f,       -y_res/2.0f, 0.0f,         y_res/2.0f,
                  0.0f,       0.0f,        z_depth/2.0f, z_depth/2.0f,
                  0.0f,       0.0f,        0.0f,         1.0f);
+
+        _projection = Projection::persp;
+        update_world_to_screen();
     }
 
     Point4 Camera::view(const Point4 &point) const {
@@ -98,6 +138,314 @@ namespace pdm {
         return _screen * persp_ndc(point);
     }
 
+    /*--------------------------------------------------------------------------
+        Tangent lines from the eye to a circle with center (c, d) and radius r,
+        where d is the distance along the view direction. With t the length of
+        the tangent, the tangent points project to:
+
+            (c*t - d*r) / (d*t + c*r)   and   (c*t + d*r) / (d*t - c*r)
+    --------------------------------------------------------------------------*/
+    static void sphere_axis_bounds(float c, float d, float r, float t,
+                                   float &min, float &max) {
+        min = (c * t - d * r) / (d * t + c * r);
+        max = (c * t + d * r) / (d * t - c * r);
+    }
+
+    ScreenBounds Camera::projected_bounds(const BSphere &sphere) const {
+        Point4 center = view(Point4(sphere.center_world()));
+        float  r = sphere.scaled_radius();
+        float  d = -center._z;
+
+        if(d - r <= _near) {
+            return ScreenBounds{0.0f, 0.0f, _x_res, _y_res, 0.0f, false};
+        }
+
+        float x_min;
+        float x_max;
+        float y_min;
+        float y_max;
+
+        float r_sq = r * r;
+        float t_x  = std::sqrt(center._x * center._x + d * d - r_sq);
+        float t_y  = std::sqrt(center._y * center._y + d * d - r_sq);
+
+        sphere_axis_bounds(center._x, d, r, t_x, x_min, x_max);
+        sphere_axis_bounds(center._y, d, r, t_y, y_min, y_max);
+
+        // ndc -> screen; the screen matrix flips y, so the bounds swap
+        float sx0 = _screen._m[0][0] * (_persp_ndc._m[0][0] * x_min) +
+                    _screen._m[0][3];
+        float sx1 = _screen._m[0][0] * (_persp_ndc._m[0][0] * x_max) +
+                    _screen._m[0][3];
+        float sy0 = _screen._m[1][1] * (_persp_ndc._m[1][1] * y_min) +
+                    _screen._m[1][3];
+        float sy1 = _screen._m[1][1] * (_persp_ndc._m[1][1] * y_max) +
+                    _screen._m[1][3];
+
+        float near_z = d - r;
+        float ndc_z  = (_persp_ndc._m[2][2] * -near_z + _persp_ndc._m[2][3]) /
+                       near_z;
+
+        return ScreenBounds{std::min(sx0, sx1), std::min(sy0, sy1),
+                            std::max(sx0, sx1), std::max(sy0, sy1),
+                            _screen._m[2][2] * ndc_z + _screen._m[2][3],
+                            true};
+    }
+
+#if defined(PDMATH_SIMD_SSE2)
+    static inline float horizontal_min(__m128 v) {
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(v);
+    }
+
+    static inline float horizontal_max(__m128 v) {
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(v);
+    }
+
+    // One row of the matrix against four corners, added in the same order
+    // as the scalar loop.
+    static inline __m128 transform_row(const float (&row)[4], const __m128 x,
+                                       const __m128 y, const __m128 z) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(row[0]), x),
+                              _mm_mul_ps(_mm_set1_ps(row[1]), y));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), z));
+        return _mm_add_ps(r, _mm_set1_ps(row[3]));
+    }
+#endif
+
+    /*--------------------------------------------------------------------------
+        The eight corners are transformed as two groups of four, the near
+        and far faces, with x, y, z and w in separate registers. Every
+        lane does the scalar loop's multiplies and adds in the same order,
+        and min and max are exact whatever order they're taken in, so both
+        paths give the same bounds.
+    --------------------------------------------------------------------------*/
+    ScreenBounds Camera::projected_bounds(const AABBox &box) const {
+        Point3 min = box.min();
+        Point3 max = box.max();
+        const Mat4 &m = _world_to_screen;
+
+#if defined(PDMATH_SIMD_SSE2)
+        const __m128 x = _mm_setr_ps(min._x, max._x, min._x, max._x);
+        const __m128 y = _mm_setr_ps(min._y, min._y, max._y, max._y);
+        const __m128 z[2] = {_mm_set1_ps(min._z), _mm_set1_ps(max._z)};
+
+        __m128 sx[2];
+        __m128 sy[2];
+        __m128 sz[2];
+        __m128 sw[2];
+
+        for(std::size_t i = 0; i < 2; ++i) {
+            sx[i] = transform_row(m._m[0], x, y, z[i]);
+            sy[i] = transform_row(m._m[1], x, y, z[i]);
+            sz[i] = transform_row(m._m[2], x, y, z[i]);
+            sw[i] = transform_row(m._m[3], x, y, z[i]);
+        }
+
+        // w is the distance in front of the eye, so one corner behind the
+        // near plane means the box can't be bounded this way
+        if(horizontal_min(_mm_min_ps(sw[0], sw[1])) <= _near) {
+            return ScreenBounds{0.0f, 0.0f, _x_res, _y_res, 0.0f, false};
+        }
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        for(std::size_t i = 0; i < 2; ++i) {
+            __m128 inv_w = _mm_div_ps(one, sw[i]);
+            sx[i] = _mm_mul_ps(sx[i], inv_w);
+            sy[i] = _mm_mul_ps(sy[i], inv_w);
+            sz[i] = _mm_mul_ps(sz[i], inv_w);
+        }
+
+        return ScreenBounds{horizontal_min(_mm_min_ps(sx[0], sx[1])),
+                            horizontal_min(_mm_min_ps(sy[0], sy[1])),
+                            horizontal_max(_mm_max_ps(sx[0], sx[1])),
+                            horizontal_max(_mm_max_ps(sy[0], sy[1])),
+                            horizontal_min(_mm_min_ps(sz[0], sz[1])),
+                            true};
+#else
+        const float x[8] = {min._x, max._x, min._x, max._x,
+                            min._x, max._x, min._x, max._x};
+        const float y[8] = {min._y, min._y, max._y, max._y,
+                            min._y, min._y, max._y, max._y};
+        const float z[8] = {min._z, min._z, min._z, min._z,
+                            max._z, max._z, max._z, max._z};
+
+        float sx[8];
+        float sy[8];
+        float sz[8];
+        float sw[8];
+
+        for(std::size_t i = 0; i < 8; ++i) {
+            sx[i] = m._m[0][0] * x[i] + m._m[0][1] * y[i] +
+                    m._m[0][2] * z[i] + m._m[0][3];
+            sy[i] = m._m[1][0] * x[i] + m._m[1][1] * y[i] +
+                    m._m[1][2] * z[i] + m._m[1][3];
+            sz[i] = m._m[2][0] * x[i] + m._m[2][1] * y[i] +
+                    m._m[2][2] * z[i] + m._m[2][3];
+            sw[i] = m._m[3][0] * x[i] + m._m[3][1] * y[i] +
+                    m._m[3][2] * z[i] + m._m[3][3];
+        }
+
+        float min_w = sw[0];
+        for(std::size_t i = 1; i < 8; ++i) {
+            min_w = std::min(min_w, sw[i]);
+        }
+
+        if(min_w <= _near) {
+            return ScreenBounds{0.0f, 0.0f, _x_res, _y_res, 0.0f, false};
+        }
+
+        for(std::size_t i = 0; i < 8; ++i) {
+            float inv_w = 1.0f / sw[i];
+            sx[i] *= inv_w;
+            sy[i] *= inv_w;
+            sz[i] *= inv_w;
+        }
+
+        ScreenBounds bounds{sx[0], sy[0], sx[0], sy[0], sz[0], true};
+        for(std::size_t i = 1; i < 8; ++i) {
+            bounds.min_x     = std::min(bounds.min_x, sx[i]);
+            bounds.min_y     = std::min(bounds.min_y, sy[i]);
+            bounds.max_x     = std::max(bounds.max_x, sx[i]);
+            bounds.max_y     = std::max(bounds.max_y, sy[i]);
+            bounds.min_depth = std::min(bounds.min_depth, sz[i]);
+        }
+
+        return bounds;
+#endif
+    }
+
+    void Camera::projected_bounds(std::span<const BSphere> spheres,
+                                  std::span<ScreenBounds>  bounds) const {
+        PDMATH_ZONE("Camera::projected_bounds");
+
+        for(std::size_t i = 0; i < spheres.size(); ++i) {
+            bounds[i] = projected_bounds(spheres[i]);
+        }
+    }
+
+    void Camera::projected_bounds(std::span<const AABBox> boxes,
+                                  std::span<ScreenBounds> bounds) const {
+        PDMATH_ZONE("Camera::projected_bounds");
+
+        for(std::size_t i = 0; i < boxes.size(); ++i) {
+            bounds[i] = projected_bounds(boxes[i]);
+        }
+    }
+
+    // Projected radius in pixels. It skips the tangent correction, which is
+    // fine for ranking LODs but not for exact bounds.
+    float Camera::projected_size(const BSphere &sphere) const {
+        const Point3 c = sphere.center_world();
+        float d = -(_world_to_view._m[2][0] * c._x +
+                    _world_to_view._m[2][1] * c._y +
+                    _world_to_view._m[2][2] * c._z +
+                    _world_to_view._m[2][3]);
+
+        if(d <= _near) {
+            return _y_res;
+        }
+
+        return sphere.scaled_radius() * _persp_ndc._m[1][1] *
+               _y_res * 0.5f / d;
+    }
+
+    void Camera::projected_size(std::span<const BSphere> spheres,
+                                std::span<float>         sizes) const {
+        for(std::size_t i = 0; i < spheres.size(); ++i) {
+            sizes[i] = projected_size(spheres[i]);
+        }
+    }
+
+    // Without a projection there's nothing to compose, and the zero
+    // matrices would only invert to infinities.
+    void Camera::update_world_to_screen() {
+        switch(_projection) {
+            case Projection::ortho:
+                _world_to_screen = _screen * _ortho_ndc * _world_to_view;
+                break;
+            case Projection::persp:
+                _world_to_screen = _screen * _persp_ndc * _world_to_view;
+                break;
+            case Projection::none:
+            default:
+                // Spelled out, since a camera built during static
+                // initialization can't count on Mat4::identity yet.
+                _world_to_screen = Mat4(1.0f, 0.0f, 0.0f, 0.0f,
+                                        0.0f, 1.0f, 0.0f, 0.0f,
+                                        0.0f, 0.0f, 1.0f, 0.0f,
+                                        0.0f, 0.0f, 0.0f, 1.0f);
+                _screen_to_world = _world_to_screen;
+                return;
+        }
+        _screen_to_world = _world_to_screen.inverted();
+    }
+
+    Line Camera::pick_ray(const float x, const float y) const {
+        Line ray;
+        pick_rays(std::span<const float>(&x, 1),
+                  std::span<const float>(&y, 1),
+                  std::span<Line>(&ray, 1));
+        return ray;
+    }
+
+    /*--------------------------------------------------------------------------
+        Unprojects each pixel at screen depth 0 and z_depth. Both points share
+        the x and y terms, so the far point only costs the z column on top of
+        the near one, plus the two perspective divides.
+    --------------------------------------------------------------------------*/
+    void Camera::pick_rays(std::span<const float> xs,
+                           std::span<const float> ys,
+                           std::span<Line> rays) const {
+        const Mat4 &m = _screen_to_world;
+
+        for(std::size_t i = 0; i < xs.size(); ++i) {
+            float x = xs[i];
+            float y = ys[i];
+
+            float bx = m._m[0][0] * x + m._m[0][1] * y + m._m[0][3];
+            float by = m._m[1][0] * x + m._m[1][1] * y + m._m[1][3];
+            float bz = m._m[2][0] * x + m._m[2][1] * y + m._m[2][3];
+            float bw = m._m[3][0] * x + m._m[3][1] * y + m._m[3][3];
+
+            float fx = bx + m._m[0][2] * _z_depth;
+            float fy = by + m._m[1][2] * _z_depth;
+            float fz = bz + m._m[2][2] * _z_depth;
+            float fw = bw + m._m[3][2] * _z_depth;
+
+            float inv_bw = 1.0f / bw;
+            float inv_fw = 1.0f / fw;
+
+            rays[i] = Line(Point3(bx * inv_bw, by * inv_bw, bz * inv_bw),
+                           Point3(fx * inv_fw, fy * inv_fw, fz * inv_fw));
+        }
+    }
+
+    std::array<Point3, 8> Camera::frustum_corners(const float near,
+                                                  const float far) const {
+        float tan_half_fov = std::tan(_fov / 2.0f);
+        float aspect       = _x_res / _y_res;
+
+        std::array<Point3, 8> corners;
+
+        for(std::size_t i = 0; i < 8; ++i) {
+            float distance    = i < 4 ? near : far;
+            float half_height = distance * tan_half_fov;
+            float half_width  = half_height * aspect;
+
+            Point3 corner((i & 1) ? half_width  : -half_width,
+                          (i & 2) ? half_height : -half_height,
+                          -distance);
+
+            corners[i] = _view_to_world * corner;
+        }
+
+        return corners;
+    }
+
     Vec3 Camera::face_normal(const Point3 &a, const Point3 &b,
                              const Point3 &c) {
         Point3 _a(a._x, a._y, a._z);
@@ -112,12 +460,20 @@ namespace pdm {
     }
 
     Camera::Camera() noexcept :
-        _position{Vec3()}, _target{Vec3()}, _gaze{Vec3()}, _up{Vec3()}
-    { }
+        _position{Vec3()}, _target{Vec3()}, _gaze{Vec3()}, _up{Vec3()},
+        _near{0.0f}, _far{0.0f}, _fov{0.0f},
+        _x_res{0.0f}, _y_res{0.0f}, _z_depth{0.0f},
+        _projection{Projection::none}
+    {
+        update_world_to_screen();
+    }
 
     Camera::Camera(const Vec3 &pos, const Vec3 &target, const Vec3 &up)
     noexcept :
-        _position{pos}, _target{target}, _up{up}
+        _position{pos}, _target{target}, _up{up},
+        _near{0.0f}, _far{0.0f}, _fov{0.0f},
+        _x_res{0.0f}, _y_res{0.0f}, _z_depth{0.0f},
+        _projection{Projection::none}
     {
         set_view(_position, _target, _up);
     }
@@ -0,0 +1,58 @@
+#include "pdmath/DualQuaternion.hpp"
+
+#include "pdmath/util.hpp"
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include <iomanip>
+
+namespace pdm {
+    const DualQuat DualQuat::identity(Quat(1.0f, 0.0f, 0.0f, 0.0f),
+                                      Vec3(0.0f, 0.0f, 0.0f));
+
+    DualQuat::DualQuat(const Quat &rotation, const Vec3 &translation) noexcept :
+        _real{rotation},
+        _dual{Quat(0.0f, 0.5f * translation._x, 0.5f * translation._y,
+                   0.5f * translation._z) * rotation}
+    { }
+
+    DualQuat DualQuat::normalized() const {
+        float inv_length = 1.0f / _real.length();
+
+        DualQuat d;
+        d._real = Quat(_real._w * inv_length, _real._v._x * inv_length,
+                       _real._v._y * inv_length, _real._v._z * inv_length);
+        d._dual = Quat(_dual._w * inv_length, _dual._v._x * inv_length,
+                       _dual._v._y * inv_length, _dual._v._z * inv_length);
+        return d;
+    }
+
+    /*--------------------------------------------------------------------------
+        t = 2 * dual * conjugate(real), written out for the vector part only.
+    --------------------------------------------------------------------------*/
+    Vec3 DualQuat::translation() const {
+        return 2.0f * (_real._w * _dual._v - _dual._w * _real._v +
+                       _real._v.cross(_dual._v));
+    }
+
+    Point3 DualQuat::transform(const Point3 &point) const {
+        return Point3(_real.rotate(Vec3(point)) + translation());
+    }
+
+    Mat4 DualQuat::to_mat4() const {
+        Mat4 m = _real.to_mat4();
+        m.set_translation(translation());
+        return m;
+    }
+
+    bool DualQuat::operator==(const DualQuat &d) const {
+        return _real == d._real && _dual == d._dual;
+    }
+
+    std::ostream& operator<<(std::ostream &os, const DualQuat &d) {
+        os << std::fixed << std::setprecision(float_precision) << "["
+            << d._real << ", "
+            << d._dual << "]";
+        return os;
+    }
+} // namespace pdm
@@ -0,0 +1,69 @@
+#include "pdmath/FrameArena.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace pdm {
+
+void* FrameArena::allocate(const std::size_t bytes, const std::size_t align) {
+    Block &block = _blocks.back();
+
+    std::size_t start = (_offset + align - 1) & ~(align - 1);
+    if(start + bytes > block.size) {
+        // Blocks start on a block_alignment boundary, so offset zero of a
+        // fresh one suits any alignment allocate() takes.
+        add_block(std::max(bytes, _capacity));
+        start = 0;
+    }
+
+    _offset = start + bytes;
+    return _blocks.back().data + start;
+}
+
+void FrameArena::reset() {
+    if(_blocks.size() > 1) {
+        std::size_t total = _capacity;
+        release();
+        add_block(total);
+    }
+    _used   = 0;
+    _offset = 0;
+}
+
+void FrameArena::add_block(const std::size_t size) {
+    if(!_blocks.empty()) {
+        _used += _blocks.back().size;
+    }
+
+    auto *data = static_cast<std::byte*>(
+        ::operator new(size, std::align_val_t(block_alignment)));
+    _blocks.push_back({data, size});
+
+    _offset    = 0;
+    _capacity += size;
+}
+
+void FrameArena::release() {
+    for(Block &block : _blocks) {
+        ::operator delete(block.data, std::align_val_t(block_alignment));
+    }
+    _blocks.clear();
+    _used     = 0;
+    _capacity = 0;
+}
+
+FrameArena::FrameArena(const std::size_t capacity) :
+    _used{0},
+    _offset{0},
+    _capacity{0}
+{
+    // Room for a few overflow blocks before the list itself has to grow.
+    _blocks.reserve(8);
+    add_block(std::max<std::size_t>(capacity, block_alignment));
+}
+
+FrameArena::~FrameArena() {
+    release();
+}
+
+} // namespace pdm
@@ -0,0 +1,387 @@
+#include "pdmath/JobSystem.hpp"
+
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace pdm {
+
+// How many empty looks for work a thread makes before going to sleep (or,
+// for a helper, handing its thread back).
+static constexpr int idle_spins = 64;
+
+namespace {
+
+struct Current {
+    const JobSystem *system = nullptr;
+    uint32_t         slot   = 0;
+};
+
+thread_local Current current;
+
+void pin(std::thread &thread, const uint32_t core) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core);
+#else
+    (void)thread;
+    (void)core;
+#endif
+}
+
+} // namespace
+
+void TaskGraph::precede(const Node before, const Node after) {
+    _successors[before].push_back(after);
+    ++_predecessors[after];
+}
+
+/*------------------------------------------------------------------------------
+    A range task splits off its upper half for as long as both halves stay
+    at least grain long, then runs what's left. Each half it publishes gets a
+    wake(), so idle threads pick the halves up while the splitting is still
+    going on instead of only the first one being spread; once every helper
+    is out, that's a load (executor) or an add and a load (own threads).
+    Whoever takes the last items off remaining may be the one the caller is
+    waiting on, so nothing here touches the job after that.
+------------------------------------------------------------------------------*/
+void JobSystem::run_range(JobSystem &system, void *data, std::size_t first,
+                          std::size_t last, const uint32_t slot) {
+    auto &job = *static_cast<RangeJob*>(data);
+
+    while(last - first >= 2 * job.grain) {
+        std::size_t middle = first + (last - first) / 2;
+        if(!system.push(slot, {run_range, data, middle, last})) {
+            break;
+        }
+        system.wake();
+        last = middle;
+    }
+
+    job.body(job.f, first, last);
+    job.remaining.fetch_sub(last - first, std::memory_order_acq_rel);
+}
+
+void JobSystem::run_range_job(RangeJob &job, const std::size_t first,
+                              const std::size_t last) {
+    if(last <= first) {
+        return;
+    }
+
+    if(_thread_count == 1 || last - first < 2 * job.grain) {
+        job.body(job.f, first, last);
+        return;
+    }
+
+    uint32_t slot = current_slot();
+    job.remaining.store(last - first, std::memory_order_relaxed);
+
+    if(!push(slot, {run_range, &job, first, last})) {
+        run_range(*this, &job, first, last, slot);
+    }
+    wake();
+
+    while(job.remaining.load(std::memory_order_acquire) != 0) {
+        if(!run_one(slot)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::run_node(JobSystem &system, void *data,
+                         const std::size_t node, std::size_t,
+                         const uint32_t slot) {
+    auto &graph = *static_cast<TaskGraph*>(data);
+
+    graph._tasks[node]();
+
+    // This thread pops the last successor it queued as soon as it returns,
+    // so a single one isn't worth a wake(); only a second one has anyone to
+    // go to.
+    int queued = 0;
+    for(TaskGraph::Node next : graph._successors[node]) {
+        if(graph._pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if(system.push(slot, {run_node, data, next, 0})) {
+                ++queued;
+            }
+            else {
+                run_node(system, data, next, 0, slot);
+            }
+        }
+    }
+    if(queued > 1) {
+        system.wake();
+    }
+
+    graph._remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::run(TaskGraph &graph) {
+    std::size_t count = graph.size();
+    if(count == 0) {
+        return;
+    }
+
+    if(graph._pending_size != count) {
+        graph._pending      = std::make_unique<std::atomic<uint32_t>[]>(count);
+        graph._pending_size = count;
+    }
+    for(std::size_t i = 0; i < count; ++i) {
+        graph._pending[i].store(graph._predecessors[i],
+                                std::memory_order_relaxed);
+    }
+    graph._remaining.store(count, std::memory_order_relaxed);
+
+    uint32_t slot = current_slot();
+    for(std::size_t i = 0; i < count; ++i) {
+        if(graph._predecessors[i] == 0 &&
+           !push(slot, {run_node, &graph, i, 0})) {
+            run_node(*this, &graph, i, 0, slot);
+        }
+    }
+    wake();
+
+    while(graph._remaining.load(std::memory_order_acquire) != 0) {
+        if(!run_one(slot)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// The owner pushes and pops at the back, so it works depth first on what
+// it just split off; thieves take from the front, where the biggest
+// pieces are.
+bool JobSystem::push(const uint32_t slot, const Task &task) {
+    Slot &s = _slots[slot];
+    std::lock_guard lock(s.lock);
+
+    if(s.count == queue_capacity) {
+        return false;
+    }
+    s.tasks[(s.head + s.count) % queue_capacity] = task;
+    ++s.count;
+    return true;
+}
+
+bool JobSystem::pop(const uint32_t slot, Task &task) {
+    Slot &s = _slots[slot];
+    std::lock_guard lock(s.lock);
+
+    if(s.count == 0) {
+        return false;
+    }
+    --s.count;
+    task = s.tasks[(s.head + s.count) % queue_capacity];
+    return true;
+}
+
+bool JobSystem::steal(const uint32_t thief, Task &task) {
+    for(uint32_t i = 1; i < _thread_count; ++i) {
+        Slot &s = _slots[(thief + i) % _thread_count];
+        std::lock_guard lock(s.lock);
+
+        if(s.count > 0) {
+            task   = s.tasks[s.head];
+            s.head = (s.head + 1) % queue_capacity;
+            --s.count;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::run_one(const uint32_t slot) {
+    Task task;
+    if(pop(slot, task) || steal(slot, task)) {
+        task.run(*this, task.data, task.first, task.last, slot);
+        return true;
+    }
+    return false;
+}
+
+/*------------------------------------------------------------------------------
+    Sleeping goes through _sleeping so that publishing work only pays for a
+    notify when someone is actually asleep. A worker counts itself in before
+    it waits and the publisher bumps _epoch before it checks the count, so
+    either the publisher sees the sleeper or the sleeper sees the new epoch.
+------------------------------------------------------------------------------*/
+void JobSystem::worker(const uint32_t slot) {
+    enter(slot);
+    profile::set_thread_name("pdmath worker");
+
+    while(!_stop.load(std::memory_order_acquire)) {
+        uint32_t seen = _epoch.load();
+
+        bool found = false;
+        for(int i = 0; i < idle_spins && !found; ++i) {
+            found = run_one(slot);
+            if(!found) {
+                std::this_thread::yield();
+            }
+        }
+
+        if(!found) {
+            _sleeping.fetch_add(1);
+            _epoch.wait(seen);
+            _sleeping.fetch_sub(1);
+        }
+    }
+}
+
+// wake() claimed the number for this helper when it submitted it.
+void JobSystem::help(void *data) {
+    auto &helper = *static_cast<Helper*>(data);
+    JobSystem &system = *helper.system;
+
+    Current outer = current;
+    system.enter(helper.slot);
+
+    for(int idle = 0; idle < idle_spins; ) {
+        if(system.run_one(helper.slot)) {
+            idle = 0;
+        }
+        else {
+            ++idle;
+            std::this_thread::yield();
+        }
+    }
+
+    current = outer;
+    system._slots[helper.slot].occupied.store(false,
+                                              std::memory_order_release);
+    system._helpers_pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/*------------------------------------------------------------------------------
+    With an executor, a helper is only submitted for a number no other
+    helper has been handed, so there are never more than thread_count() - 1
+    out at once however often work is published. Once that many are
+    pending, publishing costs one load. A helper that is just giving its
+    number back can miss the new work; the publisher works through it
+    while it waits, so it still gets done.
+------------------------------------------------------------------------------*/
+void JobSystem::wake() {
+    if(_external) {
+        for(uint32_t i = 1; i < _thread_count; ++i) {
+            if(_helpers_pending.load(std::memory_order_acquire) >=
+               _thread_count - 1) {
+                break;
+            }
+            if(!_slots[i].occupied.exchange(true,
+                                            std::memory_order_acq_rel)) {
+                _helpers_pending.fetch_add(1, std::memory_order_relaxed);
+                _executor.submit(_executor.context, help, &_helpers[i]);
+            }
+        }
+        return;
+    }
+
+    _epoch.fetch_add(1);
+    if(_sleeping.load() > 0) {
+        _epoch.notify_all();
+    }
+}
+
+void JobSystem::enter(const uint32_t slot) {
+    current.system = this;
+    current.slot   = slot;
+}
+
+// Number 0 and its arena belong to the thread that made the system, so no
+// other outside thread may use them.
+uint32_t JobSystem::current_slot() const {
+    if(current.system == this) {
+        return current.slot;
+    }
+    assert(std::this_thread::get_id() == _owner);
+    return 0;
+}
+
+uint32_t JobSystem::thread_index() const {
+    return current_slot();
+}
+
+FrameArena& JobSystem::arena() {
+    return _slots[current_slot()].arena;
+}
+
+void JobSystem::reset_arenas() {
+    for(uint32_t i = 0; i < _thread_count; ++i) {
+        _slots[i].arena.reset();
+    }
+}
+
+JobSystem& JobSystem::shared() {
+    static JobSystem system;
+    return system;
+}
+
+void JobSystem::start_threads(const bool pin_threads) {
+    uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _threads.reserve(_thread_count - 1);
+    for(uint32_t i = 1; i < _thread_count; ++i) {
+        _threads.emplace_back([this, i] { worker(i); });
+        if(pin_threads) {
+            pin(_threads.back(), i % cores);
+        }
+    }
+}
+
+JobSystem::JobSystem(const uint32_t thread_count, const bool pin_threads) :
+    _thread_count{thread_count},
+    _external{false},
+    _executor{nullptr, nullptr, 0},
+    _owner{std::this_thread::get_id()}
+{
+    if(_thread_count == 0) {
+        _thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    _slots = std::make_unique<Slot[]>(_thread_count);
+    start_threads(pin_threads);
+}
+
+JobSystem::JobSystem(const Executor &executor) :
+    _thread_count{std::max(executor.thread_count, 1u)},
+    _external{true},
+    _executor{executor},
+    _owner{std::this_thread::get_id()}
+{
+    _slots   = std::make_unique<Slot[]>(_thread_count);
+    _helpers = std::make_unique<Helper[]>(_thread_count);
+    for(uint32_t i = 0; i < _thread_count; ++i) {
+        _helpers[i] = {this, i};
+    }
+}
+
+// Helpers already handed to an executor still point at this system, so
+// they have to have run before it goes.
+JobSystem::~JobSystem() {
+    _stop.store(true, std::memory_order_release);
+    _epoch.fetch_add(1);
+    _epoch.notify_all();
+
+    for(auto &thread : _threads) {
+        thread.join();
+    }
+
+    while(_helpers_pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace pdm
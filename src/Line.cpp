@@ -96,6 +96,10 @@ Point3 Line::collides_at(const Plane &plane) const {
     return this->_p + static_cast<Point3>(this->_v) * lambda;
 }
 
+Line::Line() :
+    _p{Point3()}, _t{Point3()}, _v{Vec3()}
+{ }
+
 Line::Line(const Point3 &a, const Point3 &b) :
     _p{a}, _t{b}, _v{Vec3(b - a)}
 { }
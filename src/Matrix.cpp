@@ -0,0 +1,55 @@
+#include "pdmath/Matrix.hpp"
+
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Matrix4d.hpp"
+
+namespace pdm {
+
+template<std::size_t N, typename T, typename From>
+static Mat<N, N, T> copy_to(const From &from) {
+    Mat<N, N, T> m;
+    for(std::size_t r = 0; r < N; ++r) {
+        for(std::size_t c = 0; c < N; ++c) {
+            m._m[r][c] = from._m[r][c];
+        }
+    }
+    return m;
+}
+
+template<std::size_t N, typename To, typename T>
+static To copy_from(const Mat<N, N, T> &from) {
+    To m;
+    for(std::size_t r = 0; r < N; ++r) {
+        for(std::size_t c = 0; c < N; ++c) {
+            m._m[r][c] = from._m[r][c];
+        }
+    }
+    return m;
+}
+
+Mat3f to_mat(const Mat3 &m) {
+    return copy_to<3, float>(m);
+}
+
+Mat4f to_mat(const Mat4 &m) {
+    return copy_to<4, float>(m);
+}
+
+Mat4x4d to_mat(const Mat4d &m) {
+    return copy_to<4, double>(m);
+}
+
+Mat3 to_mat3(const Mat3f &m) {
+    return copy_from<3, Mat3>(m);
+}
+
+Mat4 to_mat4(const Mat4f &m) {
+    return copy_from<4, Mat4>(m);
+}
+
+Mat4d to_mat4d(const Mat4x4d &m) {
+    return copy_from<4, Mat4d>(m);
+}
+
+} // namespace pdm
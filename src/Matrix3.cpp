@@ -3,64 +3,144 @@
 #include "pdmath/util.hpp"
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Point3.hpp"
+#include "pdmath/Matrix.hpp"
 
+#include "kernels/kernels.hpp"
+
+#include <algorithm>
 #include <iomanip>
 #include <cmath>
 #include <numbers>
 
 namespace pdm {
+    // Mat3 stores its rows the way Mat3f does, so its arithmetic runs the
+    // generic kernels in Matrix.hpp straight on _m.
     const Mat3 Mat3::identity(1.0f, 0.0f, 0.0f,
                               0.0f, 1.0f, 0.0f,
                               0.0f, 0.0f, 1.0f);
 
-    Mat3 Mat3::populate_rotation(float theta_x, float theta_y,  float theta_z) {
-        Mat3 rot_x;
-        if(theta_x != 1) {
-            float cos_theta = std::cos(theta_x);
-            float sin_theta = std::sin(theta_x);
-            rot_x = Mat3(1.0f, 0.0f,       0.0f,
-                         0.0f, cos_theta, -sin_theta,
-                         0.0f, sin_theta,  cos_theta);
-        }
-        else {
-            rot_x = identity;
+    /*--------------------------------------------------------------------------
+        Each order is the product of the three axis rotations written out
+        ahead of time, so building a matrix is one sincos per axis and a
+        handful of multiplies instead of two full matrix products.
+    --------------------------------------------------------------------------*/
+    static Mat3 euler_to_mat3(float sx, float cx, float sy, float cy,
+                              float sz, float cz, RotationOrder order) {
+        switch(order) {
+            case RotationOrder::xyz:
+                return Mat3(
+                    cy * cz, -cy * sz, sy,
+                    cx * sz + sx * sy * cz, cx * cz - sx * sy * sz, -sx * cy,
+                    sx * sz - cx * sy * cz, sx * cz + cx * sy * sz, cx * cy);
+            case RotationOrder::xzy:
+                return Mat3(
+                    cy * cz, -sz, sy * cz,
+                    sx * sy + cx * cy * sz, cx * cz, cx * sy * sz - sx * cy,
+                    sx * cy * sz - cx * sy, sx * cz, cx * cy + sx * sy * sz);
+            case RotationOrder::yxz:
+                return Mat3(
+                    cy * cz + sx * sy * sz, sx * sy * cz - cy * sz, cx * sy,
+                    cx * sz, cx * cz, -sx,
+                    sx * cy * sz - sy * cz, sy * sz + sx * cy * cz, cx * cy);
+            case RotationOrder::yzx:
+                return Mat3(
+                    cy * cz, sx * sy - cx * cy * sz, cx * sy + sx * cy * sz,
+                    sz, cx * cz, -sx * cz,
+                    -sy * cz, sx * cy + cx * sy * sz, cx * cy - sx * sy * sz);
+            case RotationOrder::zxy:
+                return Mat3(
+                    cy * cz - sx * sy * sz, -cx * sz, sy * cz + sx * cy * sz,
+                    cy * sz + sx * sy * cz, cx * cz, sy * sz - sx * cy * cz,
+                    -cx * sy, sx, cx * cy);
+            case RotationOrder::zyx:
+            default:
+                return Mat3(
+                    cy * cz, sx * sy * cz - cx * sz, sx * sz + cx * sy * cz,
+                    cy * sz, cx * cz + sx * sy * sz, cx * sy * sz - sx * cz,
+                    -sy, sx * cy, cx * cy);
         }
+    }
 
-        Mat3 rot_y;
-        if(theta_y != 1) {
-            float cos_theta = std::cos(theta_y);
-            float sin_theta = std::sin(theta_y);
-            rot_y = Mat3( cos_theta,  0.0f, sin_theta,
-                          0.0f,       1.0f,      0.0f,
-                         -sin_theta,  0.0f, cos_theta);
-        }
-        else {
-            rot_y = identity;
-        }
+    Mat3 Mat3::populate_rotation(float theta_x, float theta_y, float theta_z,
+                                 RotationOrder order) {
+        float sx, cx, sy, cy, sz, cz;
+        fastmath::sincos(theta_x, sx, cx);
+        fastmath::sincos(theta_y, sy, cy);
+        fastmath::sincos(theta_z, sz, cz);
 
-        Mat3 rot_z;
-        if(theta_z != 1) {
-            float cos_theta = std::cos(theta_z);
-            float sin_theta = std::sin(theta_z);
-            rot_z = Mat3(cos_theta, -sin_theta, 0.0f,
-                         sin_theta,  cos_theta, 0.0f,
-                         0.0f,       0.0f,      1.0f);
-        }
-        else {
-            rot_z = identity;
+        return euler_to_mat3(sx, cx, sy, cy, sz, cz, order);
+    }
+
+    using SincosKernel = void (*)(const float *x, float *s, float *c,
+                                  std::size_t count);
+
+    static void populate_rotations_block(std::span<const Vec3> thetas,
+                                         std::span<Mat3> out,
+                                         RotationOrder order,
+                                         const SincosKernel sincos) {
+        static constexpr std::size_t block_size = 16;
+
+        float angles[3][block_size] = {};
+        float sines[3][block_size];
+        float cosines[3][block_size];
+
+        for(std::size_t first = 0; first < thetas.size();
+            first += block_size) {
+            std::size_t lanes = std::min(block_size, thetas.size() - first);
+
+            for(std::size_t i = 0; i < lanes; ++i) {
+                angles[0][i] = thetas[first + i]._x;
+                angles[1][i] = thetas[first + i]._y;
+                angles[2][i] = thetas[first + i]._z;
+            }
+
+            // One sincos sweep over all three axes of the block, from the
+            // kernel table for the CPU's widest tier.
+            sincos(angles[0], sines[0], cosines[0], 3 * block_size);
+
+            for(std::size_t i = 0; i < lanes; ++i) {
+                out[first + i] = euler_to_mat3(sines[0][i], cosines[0][i],
+                                               sines[1][i], cosines[1][i],
+                                               sines[2][i], cosines[2][i],
+                                               order);
+            }
         }
+    }
 
-        return rot_x * rot_y * rot_z;
+    void Mat3::populate_rotations(std::span<const Vec3> thetas,
+                                  std::span<Mat3> out, RotationOrder order,
+                                  Accuracy accuracy) {
+        const kernels::Table &k = kernels::active();
+
+        switch(accuracy) {
+            case Accuracy::exact:
+                populate_rotations_block(thetas, out, order, k.sincos_exact);
+                break;
+            case Accuracy::low:
+                populate_rotations_block(thetas, out, order, k.sincos_low);
+                break;
+            case Accuracy::high:
+            default:
+                populate_rotations_block(thetas, out, order, k.sincos_high);
+                break;
+        }
     }
 
     Mat3 Mat3::transposed() const {
-        return Mat3(_m[0][0], _m[1][0], _m[2][0],
-                    _m[0][1], _m[1][1], _m[2][1],
-                    _m[0][2], _m[1][2], _m[2][2]);
+        Mat3 t;
+        detail::transpose<3, 3>(_m, t._m);
+        return t;
     }
 
+    // The adjugate is the transposed cofactors, so the scale and transpose
+    // happen together as the result is built.
     Mat3 Mat3::inverted() const {
-        return (1.0f/determinant()) * matrix_of_cofactors().transposed();
+        Mat3  c = matrix_of_cofactors();
+        float s = 1.0f / determinant();
+
+        return Mat3(c._m[0][0] * s, c._m[1][0] * s, c._m[2][0] * s,
+                    c._m[0][1] * s, c._m[1][1] * s, c._m[2][1] * s,
+                    c._m[0][2] * s, c._m[1][2] * s, c._m[2][2] * s);
     }
 
     float Mat3::determinant() const {
@@ -81,7 +161,7 @@ namespace pdm {
         /* 0,2 */ (_m[1][0] * _m[2][1]) - (_m[1][1] * _m[2][0]),
         /* 1,0 */ (_m[0][1] * _m[2][2]) - (_m[0][2] * _m[2][1]),
         /* 1,1 */ (_m[0][0] * _m[2][2]) - (_m[0][2] * _m[2][0]),
-        /* 1,2 */ (_m[0][0] * _m[2][1]) - (_m[0][1] * _m[0][2]),
+        /* 1,2 */ (_m[0][0] * _m[2][1]) - (_m[0][1] * _m[2][0]),
         /* 2,0 */ (_m[0][1] * _m[1][2]) - (_m[0][2] * _m[1][1]),
         /* 2,1 */ (_m[0][0] * _m[1][2]) - (_m[0][2] * _m[1][0]),
         /* 2,2 */ (_m[0][0] * _m[1][1]) - (_m[0][1] * _m[1][0])
@@ -95,7 +175,7 @@ namespace pdm {
         /* 0,2 */ +((_m[1][0] * _m[2][1]) - (_m[1][1] * _m[2][0])),
         /* 1,0 */ -((_m[0][1] * _m[2][2]) - (_m[0][2] * _m[2][1])),
         /* 1,1 */ +((_m[0][0] * _m[2][2]) - (_m[0][2] * _m[2][0])),
-        /* 1,2 */ -((_m[0][0] * _m[2][1]) - (_m[0][1] * _m[0][2])),
+        /* 1,2 */ -((_m[0][0] * _m[2][1]) - (_m[0][1] * _m[2][0])),
         /* 2,0 */ +((_m[0][1] * _m[1][2]) - (_m[0][2] * _m[1][1])),
         /* 2,1 */ -((_m[0][0] * _m[1][2]) - (_m[0][2] * _m[1][0])),
         /* 2,2 */ +((_m[0][0] * _m[1][1]) - (_m[0][1] * _m[1][0]))
@@ -110,7 +190,7 @@ namespace pdm {
         −cxczsy + sxsz    czsx + cxsysz    cxcy
     --------------------------------------------------------------------------*/
     void Mat3::get_euler_xyz(Vec3 &ans1, Vec3 &ans2) const {
-        float theta_y1 = std::asin(_m[0][2]);
+        float theta_y1 = fastmath::asin(_m[0][2]);
         float theta_y2 = 0.0f;
 
         if(theta_y1 >= 0.0f) {
@@ -120,8 +200,8 @@ namespace pdm {
             theta_y2 = -std::numbers::pi_v<float> - theta_y1;
         }
 
-        float cos_theta_y1 = std::cos(theta_y1);
-        float cos_theta_y2 = std::cos(theta_y2);
+        float cos_theta_y1 = fastmath::cos<fastmath::portable>(theta_y1);
+        float cos_theta_y2 = fastmath::cos<fastmath::portable>(theta_y2);
 
         float cos_z1 =  _m[0][0]/cos_theta_y1;
         float sin_z1 = -_m[0][1]/cos_theta_y1;
@@ -135,11 +215,11 @@ namespace pdm {
         float sin_x2 = -_m[1][2]/cos_theta_y2;
         float cos_x2 =  _m[2][2]/cos_theta_y2;
 
-        float theta_z1 = atan2f(sin_z1, cos_z1);
-        float theta_z2 = atan2f(sin_z2, cos_z2);
+        float theta_z1 = fastmath::atan2(sin_z1, cos_z1);
+        float theta_z2 = fastmath::atan2(sin_z2, cos_z2);
 
-        float theta_x1 = atan2f(sin_x1, cos_x1);
-        float theta_x2 = atan2f(sin_x2, cos_x2);
+        float theta_x1 = fastmath::atan2(sin_x1, cos_x1);
+        float theta_x2 = fastmath::atan2(sin_x2, cos_x2);
 
         ans1._x = theta_x1;
         ans1._y = theta_y1;
@@ -165,7 +245,7 @@ namespace pdm {
         -SyCz    ...    ...
     --------------------------------------------------------------------------*/
     void Mat3::get_euler_zxy(Vec3 &ans1, Vec3 &ans2) const {
-        float theta_z1 = std::asin(_m[1][0]);
+        float theta_z1 = fastmath::asin(_m[1][0]);
         float theta_z2 = 0.0f;
 
         if(theta_z1 >= 0.0f) {
@@ -175,8 +255,8 @@ namespace pdm {
             theta_z2 = -std::numbers::pi_v<float> - theta_z1;
         }
 
-        float cos_theta_z1 = std::cos(theta_z1);
-        float cos_theta_z2 = std::cos(theta_z2);
+        float cos_theta_z1 = fastmath::cos<fastmath::portable>(theta_z1);
+        float cos_theta_z2 = fastmath::cos<fastmath::portable>(theta_z2);
 
         float sin_x1 = -_m[1][2]/cos_theta_z1;
         float sin_x2 = -_m[1][2]/cos_theta_z2;
@@ -188,11 +268,11 @@ namespace pdm {
         float cos_y1 =  _m[0][0]/cos_theta_z1;
         float cos_y2 =  _m[0][0]/cos_theta_z2;
 
-        float theta_x1 = atan2f(sin_x1, cos_x1);
-        float theta_x2 = atan2f(sin_x2, cos_x2);
+        float theta_x1 = fastmath::atan2(sin_x1, cos_x1);
+        float theta_x2 = fastmath::atan2(sin_x2, cos_x2);
 
-        float theta_y1 = atan2f(sin_y1, cos_y1);
-        float theta_y2 = atan2f(sin_y2, cos_y2);
+        float theta_y1 = fastmath::atan2(sin_y1, cos_y1);
+        float theta_y2 = fastmath::atan2(sin_y2, cos_y2);
 
         ans1._x = theta_x1;
         ans1._y = theta_y1;
@@ -242,143 +322,35 @@ namespace pdm {
     }
 
     const Mat3& Mat3::operator*=(const Mat3 &m) {
-        float x1 = (_m[0][0] * m._m[0][0]) +
-                   (_m[0][1] * m._m[1][0]) +
-                   (_m[0][2] * m._m[2][0]);    
-        float y1 = (_m[0][0] * m._m[0][1]) +
-                   (_m[0][1] * m._m[1][1]) +
-                   (_m[0][2] * m._m[2][1]);
-        float z1 = (_m[0][0] * m._m[0][2]) +
-                   (_m[0][1] * m._m[1][2]) +
-                   (_m[0][2] * m._m[2][2]);
-
-        float x2 = (_m[1][0] * m._m[0][0]) +
-                   (_m[1][1] * m._m[1][0]) +
-                   (_m[1][2] * m._m[2][0]);
-        float y2 = (_m[1][0] * m._m[0][1]) +
-                   (_m[1][1] * m._m[1][1]) +
-                   (_m[1][2] * m._m[2][1]);
-        float z2 = (_m[1][0] * m._m[0][2]) +
-                   (_m[1][1] * m._m[1][2]) +
-                   (_m[1][2] * m._m[2][2]);
-
-        float x3 = (_m[2][0] * m._m[0][0]) +
-                   (_m[2][1] * m._m[1][0]) +
-                   (_m[2][2] * m._m[2][0]);
-        float y3 = (_m[2][0] * m._m[0][1]) +
-                   (_m[2][1] * m._m[1][1]) +
-                   (_m[2][2] * m._m[2][1]);
-        float z3 = (_m[2][0] * m._m[0][2]) +
-                   (_m[2][1] * m._m[1][2]) +
-                   (_m[2][2] * m._m[2][2]);
-
-        _m[0][0] = x1;
-        _m[1][0] = x2;
-        _m[2][0] = x3;
-
-        _m[0][1] = y1;
-        _m[1][1] = y2;
-        _m[2][1] = y3;
-
-        _m[0][2] = z1;
-        _m[1][2] = z2;
-        _m[2][2] = z3;
-
+        *this = *this * m;
         return *this;
     }
 
     const Mat3& Mat3::operator*=(const float scalar) {
-        this->_m[0][0] *= scalar;
-        this->_m[1][0] *= scalar;
-        this->_m[2][0] *= scalar;
-
-        this->_m[0][1] *= scalar;
-        this->_m[1][1] *= scalar;
-        this->_m[2][1] *= scalar;
-
-        this->_m[0][2] *= scalar;
-        this->_m[1][2] *= scalar;
-        this->_m[2][2] *= scalar;
-
+        *this = *this * scalar;
         return *this;
     }
 
     const Mat3& Mat3::operator+=(const Mat3 &m) {
-        this->_m[0][0] += m._m[0][0];
-        this->_m[1][0] += m._m[1][0];
-        this->_m[2][0] += m._m[2][0];
-
-        this->_m[0][1] += m._m[0][1];
-        this->_m[1][1] += m._m[1][1];
-        this->_m[2][1] += m._m[2][1];
-
-        this->_m[0][2] += m._m[0][2];
-        this->_m[1][2] += m._m[1][2];
-        this->_m[2][2] += m._m[2][2];
-
+        *this = *this + m;
         return *this;
     }
 
     const Mat3& Mat3::operator-=(const Mat3 &m) {
-        this->_m[0][0] -= m._m[0][0];
-        this->_m[1][0] -= m._m[1][0];
-        this->_m[2][0] -= m._m[2][0];
-
-        this->_m[0][1] -= m._m[0][1];
-        this->_m[1][1] -= m._m[1][1];
-        this->_m[2][1] -= m._m[2][1];
-
-        this->_m[0][2] -= m._m[0][2];
-        this->_m[1][2] -= m._m[1][2];
-        this->_m[2][2] -= m._m[2][2];
-
+        *this = *this - m;
         return *this;
     }
 
     Mat3 operator*(const Mat3 &m, const Mat3 &n) {
-        return Mat3(m._m[0][0] * n._m[0][0] +
-                    m._m[0][1] * n._m[1][0] +
-                    m._m[0][2] * n._m[2][0],                    
-                    m._m[0][0] * n._m[0][1] +
-                    m._m[0][1] * n._m[1][1] +
-                    m._m[0][2] * n._m[2][1],
-                    m._m[0][0] * n._m[0][2] +
-                    m._m[0][1] * n._m[1][2] +
-                    m._m[0][2] * n._m[2][2],
-
-                    m._m[1][0] * n._m[0][0] +
-                    m._m[1][1] * n._m[1][0] +
-                    m._m[1][2] * n._m[2][0],
-                    m._m[1][0] * n._m[0][1] +
-                    m._m[1][1] * n._m[1][1] +
-                    m._m[1][2] * n._m[2][1],
-                    m._m[1][0] * n._m[0][2] +
-                    m._m[1][1] * n._m[1][2] +
-                    m._m[1][2] * n._m[2][2],
-
-                    m._m[2][0] * n._m[0][0] +
-                    m._m[2][1] * n._m[1][0] +
-                    m._m[2][2] * n._m[2][0],
-                    m._m[2][0] * n._m[0][1] +
-                    m._m[2][1] * n._m[1][1] +
-                    m._m[2][2] * n._m[2][1],
-                    m._m[2][0] * n._m[0][2] +
-                    m._m[2][1] * n._m[1][2] +
-                    m._m[2][2] * n._m[2][2]);
+        Mat3 r;
+        detail::mul<3, 3, 3>(m._m, n._m, r._m);
+        return r;
     }
 
     Mat3 operator*(const Mat3 &m, const float scalar) {
-        return Mat3(m._m[0][0] * scalar,
-                    m._m[0][1] * scalar,
-                    m._m[0][2] * scalar,
-
-                    m._m[1][0] * scalar,
-                    m._m[1][1] * scalar,
-                    m._m[1][2] * scalar,
-
-                    m._m[2][0] * scalar,
-                    m._m[2][1] * scalar,
-                    m._m[2][2] * scalar);
+        Mat3 r;
+        detail::scale<3, 3>(m._m, scalar, r._m);
+        return r;
     }
 
     Mat3 operator*(const float scalar, const Mat3 &m) {
@@ -386,59 +358,29 @@ namespace pdm {
     }
 
     Mat3 operator+(const Mat3 &m, const Mat3 &n) {
-        return Mat3(m._m[0][0] + n._m[0][0],
-                    m._m[0][1] + n._m[0][1],
-                    m._m[0][2] + n._m[0][2],
-
-                    m._m[1][0] + n._m[1][0],
-                    m._m[1][1] + n._m[1][1],
-                    m._m[1][2] + n._m[1][2],
-
-                    m._m[2][0] + n._m[2][0],
-                    m._m[2][1] + n._m[2][1],
-                    m._m[2][2] + n._m[2][2]);
+        Mat3 r;
+        detail::add<3, 3>(m._m, n._m, r._m);
+        return r;
     }
 
     Mat3 operator-(const Mat3 &m, const Mat3 &n) {
-        return Mat3(m._m[0][0] - n._m[0][0],
-                    m._m[0][1] - n._m[0][1],
-                    m._m[0][2] - n._m[0][2],
-
-                    m._m[1][0] - n._m[1][0],
-                    m._m[1][1] - n._m[1][1],
-                    m._m[1][2] - n._m[1][2],
-                    
-                    m._m[2][0] - n._m[2][0],
-                    m._m[2][1] - n._m[2][1],
-                    m._m[2][2] - n._m[2][2]);
+        Mat3 r;
+        detail::sub<3, 3>(m._m, n._m, r._m);
+        return r;
     }
 
     Point3 operator*(const Mat3 &m, const Point3 &p) {
-        return Point3(p._x * m._m[0][0] +
-                      p._y * m._m[0][1] +
-                      p._z * m._m[0][2],
-
-                      p._x * m._m[1][0] +
-                      p._y * m._m[1][1] +
-                      p._z * m._m[1][2],
-
-                      p._x * m._m[2][0] +
-                      p._y * m._m[2][1] +
-                      p._z * m._m[2][2]);
+        const float x[3] = {p._x, p._y, p._z};
+        float r[3];
+        detail::mul<3, 3>(m._m, x, r);
+        return Point3(r[0], r[1], r[2]);
     }
 
     Vec3 operator*(const Mat3 &m, const Vec3 &v) {
-        return Vec3(v._x * m._m[0][0] +
-                    v._y * m._m[0][1] +
-                    v._z * m._m[0][2],
-
-                    v._x * m._m[1][0] +
-                    v._y * m._m[1][1] +
-                    v._z * m._m[1][2],
-                    
-                    v._x * m._m[2][0] +
-                    v._y * m._m[2][1] +
-                    v._z * m._m[2][2]);
+        const float x[3] = {v._x, v._y, v._z};
+        float r[3];
+        detail::mul<3, 3>(m._m, x, r);
+        return Vec3(r[0], r[1], r[2]);
     }
 
     std::ostream& operator<<(std::ostream &os, const Mat3 &m) {
@@ -5,10 +5,47 @@
 #include "pdmath/Point4.hpp"
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Matrix3.hpp"
+#include "pdmath/Vector.hpp"
+#include "pdmath/Matrix.hpp"
+#include "pdmath/instrument.hpp"
+#include "pdmath/profile.hpp"
 
 #include <iomanip>
 
 namespace pdm {
+    /*--------------------------------------------------------------------------
+        Mat4 stores its rows the way Mat4f does, and Vec4 and Point4 are four
+        packed floats, so the arithmetic runs the generic kernels in
+        Matrix.hpp straight on _m. What stays here is what only a transform
+        has: TRS inverses, scale and axis queries, and the batch below.
+    --------------------------------------------------------------------------*/
+
+#if defined(PDMATH_SIMD_SSE2)
+    static inline __m128 load(const Point4 &p) { return _mm_load_ps(&p._x); }
+
+    static inline void store(Point4 &p, const __m128 r) {
+        _mm_store_ps(&p._x, r);
+    }
+
+    // A batch reuses one matrix for every point, so it pays for a single
+    // transpose into columns up front and then only broadcasts each point.
+    // Each lane still adds its four products in the scalar order.
+    static inline void load_columns(const Mat4 &m, __m128 (&c)[4]) {
+        c[0] = _mm_load_ps(m._m[0]);
+        c[1] = _mm_load_ps(m._m[1]);
+        c[2] = _mm_load_ps(m._m[2]);
+        c[3] = _mm_load_ps(m._m[3]);
+        _MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+    }
+
+    static inline __m128 mul_columns(const __m128 (&c)[4], const __m128 v) {
+        __m128 r = _mm_mul_ps(c[0], _mm_shuffle_ps(v, v, 0x00));
+        r = _mm_add_ps(r, _mm_mul_ps(c[1], _mm_shuffle_ps(v, v, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(c[2], _mm_shuffle_ps(v, v, 0xAA)));
+        return _mm_add_ps(r, _mm_mul_ps(c[3], _mm_shuffle_ps(v, v, 0xFF)));
+    }
+#endif
+
     const Mat4 Mat4::identity(1.0f, 0.0f, 0.0f, 0.0f,
                               0.0f, 1.0f, 0.0f, 0.0f,
                               0.0f, 0.0f, 1.0f, 0.0f,
@@ -164,6 +201,8 @@ namespace pdm {
     }
 
     Mat4 Mat4::inverted() const {
+        PDMATH_TIME(mat4_inverted);
+
         float A2323 = _m[2][2] * _m[3][3] - _m[2][3] * _m[3][2];
         float A1323 = _m[2][1] * _m[3][3] - _m[2][3] * _m[3][1];
         float A1223 = _m[2][1] * _m[3][2] - _m[2][2] * _m[3][1];
@@ -210,12 +249,11 @@ namespace pdm {
     }
 
     Mat4 Mat4::transposed() const {
-        return Mat4(_m[0][0], _m[1][0], _m[2][0], _m[3][0],
-                    _m[0][1], _m[1][1], _m[2][1], _m[3][1],
-                    _m[0][2], _m[1][2], _m[2][2], _m[3][2],
-                    _m[0][3], _m[1][3], _m[2][3], _m[3][3]);
+        Mat4 t;
+        detail::transpose<4, 4>(_m, t._m);
+        return t;
     }
-    
+
     const Mat4& Mat4::set_translation(const Vec4& v) {
         _m[0][3] = v._x;
         _m[1][3] = v._y;
@@ -336,259 +374,35 @@ namespace pdm {
     }
 
     const Mat4& Mat4::operator*=(const Mat4 &m) {
-        float x1 = (_m[0][0] * m._m[0][0]) +
-                   (_m[0][1] * m._m[1][0]) +
-                   (_m[0][2] * m._m[2][0]) +
-                   (_m[0][3] * m._m[3][0]);    
-        float y1 = (_m[0][0] * m._m[0][1]) +
-                   (_m[0][1] * m._m[1][1]) +
-                   (_m[0][2] * m._m[2][1]) +
-                   (_m[0][3] * m._m[3][1]);
-        float z1 = (_m[0][0] * m._m[0][2]) +
-                   (_m[0][1] * m._m[1][2]) +
-                   (_m[0][2] * m._m[2][2]) +
-                   (_m[0][3] * m._m[3][2]);
-        float w1 = (_m[0][0] * m._m[0][3]) +
-                   (_m[0][1] * m._m[1][3]) +
-                   (_m[0][2] * m._m[2][3]) +
-                   (_m[0][3] * m._m[3][3]);
-
-        float x2 = (_m[1][0] * m._m[0][0]) +
-                   (_m[1][1] * m._m[1][0]) +
-                   (_m[1][2] * m._m[2][0]) +
-                   (_m[1][3] * m._m[3][0]);    
-        float y2 = (_m[1][0] * m._m[0][1]) +
-                   (_m[1][1] * m._m[1][1]) +
-                   (_m[1][2] * m._m[2][1]) +
-                   (_m[1][3] * m._m[3][1]);
-        float z2 = (_m[1][0] * m._m[0][2]) +
-                   (_m[1][1] * m._m[1][2]) +
-                   (_m[1][2] * m._m[2][2]) +
-                   (_m[1][3] * m._m[3][2]);
-        float w2 = (_m[1][0] * m._m[0][3]) +
-                   (_m[1][1] * m._m[1][3]) +
-                   (_m[1][2] * m._m[2][3]) +
-                   (_m[1][3] * m._m[3][3]);
-
-        float x3 = (_m[2][0] * m._m[0][0]) +
-                   (_m[2][1] * m._m[1][0]) +
-                   (_m[2][2] * m._m[2][0]) +
-                   (_m[2][3] * m._m[3][0]);    
-        float y3 = (_m[2][0] * m._m[0][1]) +
-                   (_m[2][1] * m._m[1][1]) +
-                   (_m[2][2] * m._m[2][1]) +
-                   (_m[2][3] * m._m[3][1]);
-        float z3 = (_m[2][0] * m._m[0][2]) +
-                   (_m[2][1] * m._m[1][2]) +
-                   (_m[2][2] * m._m[2][2]) +
-                   (_m[2][3] * m._m[3][2]);
-        float w3 = (_m[2][0] * m._m[0][3]) +
-                   (_m[2][1] * m._m[1][3]) +
-                   (_m[2][2] * m._m[2][3]) +
-                   (_m[2][3] * m._m[3][3]);
-
-        float x4 = (_m[3][0] * m._m[0][0]) +
-                   (_m[3][1] * m._m[1][0]) +
-                   (_m[3][2] * m._m[2][0]) +
-                   (_m[3][3] * m._m[3][0]);    
-        float y4 = (_m[3][0] * m._m[0][1]) +
-                   (_m[3][1] * m._m[1][1]) +
-                   (_m[3][2] * m._m[2][1]) +
-                   (_m[3][3] * m._m[3][1]);
-        float z4 = (_m[3][0] * m._m[0][2]) +
-                   (_m[3][1] * m._m[1][2]) +
-                   (_m[3][2] * m._m[2][2]) +
-                   (_m[3][3] * m._m[3][2]);
-        float w4 = (_m[3][0] * m._m[0][3]) +
-                   (_m[3][1] * m._m[1][3]) +
-                   (_m[3][2] * m._m[2][3]) +
-                   (_m[3][3] * m._m[3][3]);
-
-        _m[0][0] = x1;
-        _m[1][0] = x2;
-        _m[2][0] = x3;
-        _m[3][0] = x4;
-
-        _m[0][1] = y1;
-        _m[1][1] = y2;
-        _m[2][1] = y3;
-        _m[3][1] = y4;
-
-        _m[0][2] = z1;
-        _m[1][2] = z2;
-        _m[2][2] = z3;
-        _m[3][2] = z4;
-
-        _m[0][3] = w1;
-        _m[1][3] = w2;
-        _m[2][3] = w3;
-        _m[3][3] = w4;
-
+        *this = *this * m;
         return *this;
     }
 
     const Mat4& Mat4::operator*=(const float scalar) {
-        this->_m[0][0] *= scalar;
-        this->_m[1][0] *= scalar;
-        this->_m[2][0] *= scalar;
-        this->_m[3][0] *= scalar;
-
-        this->_m[0][1] *= scalar;
-        this->_m[1][1] *= scalar;
-        this->_m[2][1] *= scalar;
-        this->_m[3][1] *= scalar;
-
-        this->_m[0][2] *= scalar;
-        this->_m[1][2] *= scalar;
-        this->_m[2][2] *= scalar;
-        this->_m[3][2] *= scalar;
-
-        this->_m[0][3] *= scalar;
-        this->_m[1][3] *= scalar;
-        this->_m[2][3] *= scalar;
-        this->_m[3][3] *= scalar;
-
+        *this = *this * scalar;
         return *this;
     }
 
     const Mat4& Mat4::operator+=(const Mat4 &m) {
-        this->_m[0][0] += m._m[0][0];
-        this->_m[1][0] += m._m[1][0];
-        this->_m[2][0] += m._m[2][0];
-        this->_m[3][0] += m._m[3][0];
-
-        this->_m[0][1] += m._m[0][1];
-        this->_m[1][1] += m._m[1][1];
-        this->_m[2][1] += m._m[2][1];
-        this->_m[3][1] += m._m[3][1];
-
-        this->_m[0][2] += m._m[0][2];
-        this->_m[1][2] += m._m[1][2];
-        this->_m[2][2] += m._m[2][2];
-        this->_m[3][2] += m._m[3][2];
-
-        this->_m[0][3] += m._m[0][3];
-        this->_m[1][3] += m._m[1][3];
-        this->_m[2][3] += m._m[2][3];
-        this->_m[3][3] += m._m[3][3];
-
+        *this = *this + m;
         return *this;
     }
 
     const Mat4& Mat4::operator-=(const Mat4 &m) {
-        this->_m[0][0] -= m._m[0][0];
-        this->_m[1][0] -= m._m[1][0];
-        this->_m[2][0] -= m._m[2][0];
-        this->_m[3][0] -= m._m[3][0];
-
-        this->_m[0][1] -= m._m[0][1];
-        this->_m[1][1] -= m._m[1][1];
-        this->_m[2][1] -= m._m[2][1];
-        this->_m[3][1] -= m._m[3][1];
-
-        this->_m[0][2] -= m._m[0][2];
-        this->_m[1][2] -= m._m[1][2];
-        this->_m[2][2] -= m._m[2][2];
-        this->_m[3][2] -= m._m[3][2];
-
-        this->_m[0][3] -= m._m[0][3];
-        this->_m[1][3] -= m._m[1][3];
-        this->_m[2][3] -= m._m[2][3];
-        this->_m[3][3] -= m._m[3][3];
-
+        *this = *this - m;
         return *this;
     }
 
     Mat4 operator*(const Mat4 &m, const Mat4 &n) {
-        return Mat4(m._m[0][0] * n._m[0][0] +
-                    m._m[0][1] * n._m[1][0] +
-                    m._m[0][2] * n._m[2][0] +
-                    m._m[0][3] * n._m[3][0],
-                    m._m[0][0] * n._m[0][1] +
-                    m._m[0][1] * n._m[1][1] +
-                    m._m[0][2] * n._m[2][1] +
-                    m._m[0][3] * n._m[3][1],
-                    m._m[0][0] * n._m[0][2] +
-                    m._m[0][1] * n._m[1][2] +
-                    m._m[0][2] * n._m[2][2] +
-                    m._m[0][3] * n._m[3][2],
-                    m._m[0][0] * n._m[0][3] +
-                    m._m[0][1] * n._m[1][3] +
-                    m._m[0][2] * n._m[2][3] +
-                    m._m[0][3] * n._m[3][3],
-
-                    m._m[1][0] * n._m[0][0] +
-                    m._m[1][1] * n._m[1][0] +
-                    m._m[1][2] * n._m[2][0] +
-                    m._m[1][3] * n._m[3][0],
-                    m._m[1][0] * n._m[0][1] +
-                    m._m[1][1] * n._m[1][1] +
-                    m._m[1][2] * n._m[2][1] +
-                    m._m[1][3] * n._m[3][1],
-                    m._m[1][0] * n._m[0][2] +
-                    m._m[1][1] * n._m[1][2] +
-                    m._m[1][2] * n._m[2][2] +
-                    m._m[1][3] * n._m[3][2],
-                    m._m[1][0] * n._m[0][3] +
-                    m._m[1][1] * n._m[1][3] +
-                    m._m[1][2] * n._m[2][3] +
-                    m._m[1][3] * n._m[3][3],
-
-                    m._m[2][0] * n._m[0][0] +
-                    m._m[2][1] * n._m[1][0] +
-                    m._m[2][2] * n._m[2][0] +
-                    m._m[2][3] * n._m[3][0],
-                    m._m[2][0] * n._m[0][1] +
-                    m._m[2][1] * n._m[1][1] +
-                    m._m[2][2] * n._m[2][1] +
-                    m._m[2][3] * n._m[3][1],
-                    m._m[2][0] * n._m[0][2] +
-                    m._m[2][1] * n._m[1][2] +
-                    m._m[2][2] * n._m[2][2] +
-                    m._m[2][3] * n._m[3][2],
-                    m._m[2][0] * n._m[0][3] +
-                    m._m[2][1] * n._m[1][3] +
-                    m._m[2][2] * n._m[2][3] +
-                    m._m[2][3] * n._m[3][3],
-
-                    m._m[3][0] * n._m[0][0] +
-                    m._m[3][1] * n._m[1][0] +
-                    m._m[3][2] * n._m[2][0] +
-                    m._m[3][3] * n._m[3][0],
-                    m._m[3][0] * n._m[0][1] +
-                    m._m[3][1] * n._m[1][1] +
-                    m._m[3][2] * n._m[2][1] +
-                    m._m[3][3] * n._m[3][1],
-                    m._m[3][0] * n._m[0][2] +
-                    m._m[3][1] * n._m[1][2] +
-                    m._m[3][2] * n._m[2][2] +
-                    m._m[3][3] * n._m[3][2],
-                    m._m[3][0] * n._m[0][3] +
-                    m._m[3][1] * n._m[1][3] +
-                    m._m[3][2] * n._m[2][3] +
-                    m._m[3][3] * n._m[3][3]);
+        Mat4 r;
+        detail::mul<4, 4, 4>(m._m, n._m, r._m);
+        return r;
     }
 
     Mat4 operator*(const Mat4 &m, const float scalar) {
-        return Mat4(m._m[0][0] * scalar,
-                    m._m[0][1] * scalar,
-                    m._m[0][2] * scalar,
-                    m._m[0][3] * scalar,
-
-                    m._m[1][0] * scalar,
-                    m._m[1][1] * scalar,
-                    m._m[1][2] * scalar,
-                    m._m[1][3] * scalar,
-
-                    m._m[2][0] * scalar,
-                    m._m[2][1] * scalar,
-                    m._m[2][2] * scalar,
-                    m._m[2][3] * scalar,
-
-                    m._m[3][0] * scalar,
-                    m._m[3][1] * scalar,
-                    m._m[3][2] * scalar,
-                    m._m[3][3] * scalar);
+        Mat4 r;
+        detail::scale<4, 4>(m._m, scalar, r._m);
+        return r;
     }
 
     Mat4 operator*(const float scalar, const Mat4 &m) {
@@ -596,118 +410,61 @@ namespace pdm {
     }
 
     Mat4 operator+(const Mat4 &m, const Mat4 &n) {
-        return Mat4(m._m[0][0] + n._m[0][0],
-                    m._m[0][1] + n._m[0][1],
-                    m._m[0][2] + n._m[0][2],
-                    m._m[0][3] + n._m[0][3],
-
-                    m._m[1][0] + n._m[1][0],
-                    m._m[1][1] + n._m[1][1],
-                    m._m[1][2] + n._m[1][2],
-                    m._m[1][3] + n._m[1][3],
-                    
-                    m._m[2][0] + n._m[2][0],
-                    m._m[2][1] + n._m[2][1],
-                    m._m[2][2] + n._m[2][2],
-                    m._m[2][3] + n._m[2][3],
-                    
-                    m._m[3][0] + n._m[3][0],
-                    m._m[3][1] + n._m[3][1],
-                    m._m[3][2] + n._m[3][2],
-                    m._m[3][3] + n._m[3][3]);
+        Mat4 r;
+        detail::add<4, 4>(m._m, n._m, r._m);
+        return r;
     }
 
     Mat4 operator-(const Mat4 &m, const Mat4 &n) {
-        return Mat4(m._m[0][0] - n._m[0][0],
-                    m._m[0][1] - n._m[0][1],
-                    m._m[0][2] - n._m[0][2],
-                    m._m[0][3] - n._m[0][3],
-
-                    m._m[1][0] - n._m[1][0],
-                    m._m[1][1] - n._m[1][1],
-                    m._m[1][2] - n._m[1][2],
-                    m._m[1][3] - n._m[1][3],
-                    
-                    m._m[2][0] - n._m[2][0],
-                    m._m[2][1] - n._m[2][1],
-                    m._m[2][2] - n._m[2][2],
-                    m._m[2][3] - n._m[2][3],
-                    
-                    m._m[3][0] - n._m[3][0],
-                    m._m[3][1] - n._m[3][1],
-                    m._m[3][2] - n._m[3][2],
-                    m._m[3][3] - n._m[3][3]);
+        Mat4 r;
+        detail::sub<4, 4>(m._m, n._m, r._m);
+        return r;
     }
 
     Point4 operator*(const Mat4 &m, const Point4 &p) {
-        return Point4((m._m[0][0] * p._x) +
-                      (m._m[0][1] * p._y) +
-                      (m._m[0][2] * p._z) +
-                      (m._m[0][3] * p._w),
-                      (m._m[1][0] * p._x) +
-                      (m._m[1][1] * p._y) +
-                      (m._m[1][2] * p._z) +
-                      (m._m[1][3] * p._w),
-                      (m._m[2][0] * p._x) +
-                      (m._m[2][1] * p._y) +
-                      (m._m[2][2] * p._z) +
-                      (m._m[2][3] * p._w),
-                      (m._m[3][0] * p._x) +
-                      (m._m[3][1] * p._y) +
-                      (m._m[3][2] * p._z) +
-                      (m._m[3][3] * p._w));
+        Point4 r;
+        detail::mul<4, 4>(m._m, &p._x, &r._x);
+        return r;
     }
 
     Vec4 operator*(const Mat4 &m, const Vec4 &v) {
-        return Vec4((m._m[0][0] * v._x) +
-                    (m._m[0][1] * v._y) +
-                    (m._m[0][2] * v._z) +
-                    (m._m[0][3] * v._w), 
-                    (m._m[1][0] * v._x) +
-                    (m._m[1][1] * v._y) +
-                    (m._m[1][2] * v._z) +
-                    (m._m[1][3] * v._w),
-                    (m._m[2][0] * v._x) +
-                    (m._m[2][1] * v._y) +
-                    (m._m[2][2] * v._z) +
-                    (m._m[2][3] * v._w),
-                    (m._m[3][0] * v._x) +
-                    (m._m[3][1] * v._y) +
-                    (m._m[3][2] * v._z) +
-                    (m._m[3][3] * v._w));
+        Vec4 r;
+        detail::mul<4, 4>(m._m, &v._x, &r._x);
+        return r;
+    }
+
+    void Mat4::transform(std::span<const Point4> points,
+                         std::span<Point4> out) const {
+        PDMATH_ZONE("Mat4::transform");
+
+#if defined(PDMATH_SIMD_SSE2)
+        __m128 c[4];
+        load_columns(*this, c);
+
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            store(out[i], mul_columns(c, load(points[i])));
+        }
+#else
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            out[i] = *this * points[i];
+        }
+#endif
     }
 
+    // Only the top three rows reach a Point3 or Vec3.
     Point3 operator*(const Mat4 &m, const Point3 &p) {
-        Point4 intermediate((m._m[0][0] * p._x) +
-                            (m._m[0][1] * p._y) +
-                            (m._m[0][2] * p._z) +
-                            (m._m[0][3] * 1.0f),
-                            (m._m[1][0] * p._x) +
-                            (m._m[1][1] * p._y) +
-                            (m._m[1][2] * p._z) +
-                            (m._m[1][3] * 1.0f),
-                            (m._m[2][0] * p._x) +
-                            (m._m[2][1] * p._y) +
-                            (m._m[2][2] * p._z) +
-                            (m._m[2][3] * 1.0f),
-                            (m._m[3][0] * p._x) +
-                            (m._m[3][1] * p._y) +
-                            (m._m[3][2] * p._z) +
-                            (m._m[3][3] * 1.0f));
-
-        return Point3(intermediate._x, intermediate._y, intermediate._z);
+        const float x[4] = {p._x, p._y, p._z, 1.0f};
+        float r[3];
+        detail::mul<3, 4>(m._m, x, r);
+        return Point3(r[0], r[1], r[2]);
     }
 
+    // A direction has w = 0, so the translation column drops out.
     Vec3 operator*(const Mat4 &m, const Vec3 &v) {
-        return Vec3((m._m[0][0] * v._x) +
-                    (m._m[0][1] * v._y) +
-                    (m._m[0][2] * v._z),
-                    (m._m[1][0] * v._x) +
-                    (m._m[1][1] * v._y) +
-                    (m._m[1][2] * v._z),
-                    (m._m[2][0] * v._x) +
-                    (m._m[2][1] * v._y) +
-                    (m._m[2][2] * v._z));
+        const float x[4] = {v._x, v._y, v._z, 0.0f};
+        float r[3];
+        detail::mul<3, 4>(m._m, x, r);
+        return Vec3(r[0], r[1], r[2]);
     }
 
     std::ostream& operator<<(std::ostream &os, const Mat4 &m) {
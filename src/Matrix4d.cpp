@@ -0,0 +1,145 @@
+#include "pdmath/Matrix4d.hpp"
+
+#include "pdmath/util.hpp"
+
+#include <iomanip>
+#include <cmath>
+
+namespace pdm {
+    const Mat4d Mat4d::identity(1.0, 0.0, 0.0, 0.0,
+                                0.0, 1.0, 0.0, 0.0,
+                                0.0, 0.0, 1.0, 0.0,
+                                0.0, 0.0, 0.0, 1.0);
+
+    Point3d Mat4d::get_world_position() const {
+        return Point3d(_m[0][3], _m[1][3], _m[2][3]);
+    }
+
+    const Mat4d& Mat4d::set_translation(const Point3d &p) {
+        _m[0][3] = p._x;
+        _m[1][3] = p._y;
+        _m[2][3] = p._z;
+        _m[3][3] = 1.0;
+
+        return *this;
+    }
+
+    Mat4 Mat4d::relative_to(const Point3d &origin) const {
+        Mat4 relative;
+        relative_to(std::span<const Mat4d>(this, 1), origin,
+                    std::span<Mat4>(&relative, 1));
+        return relative;
+    }
+
+    /*--------------------------------------------------------------------------
+        Rebases each world matrix onto origin, usually the camera's position.
+        Rotation and scale are already small numbers and convert straight to
+        float. The translation is subtracted in double first, so whatever is
+        near the origin keeps its full float precision.
+
+        Each row is a flat run of four conversions, which the compiler packs
+        into double->float vector converts.
+    --------------------------------------------------------------------------*/
+    void Mat4d::relative_to(std::span<const Mat4d> worlds,
+                            const Point3d &origin,
+                            std::span<Mat4> relative) {
+        const double offset[4] = {origin._x, origin._y, origin._z, 0.0};
+
+        for(std::size_t i = 0; i < worlds.size(); ++i) {
+            const Mat4d &world = worlds[i];
+            Mat4 &out = relative[i];
+
+            for(std::size_t row = 0; row < 4; ++row) {
+                double translation = world._m[row][3] -
+                                     offset[row] * world._m[3][3];
+
+                out._m[row][0] = static_cast<float>(world._m[row][0]);
+                out._m[row][1] = static_cast<float>(world._m[row][1]);
+                out._m[row][2] = static_cast<float>(world._m[row][2]);
+                out._m[row][3] = static_cast<float>(translation);
+            }
+        }
+    }
+
+    Mat4d::Mat4d(const double x1, const double y1, const double z1,
+                 const double w1,
+                 const double x2, const double y2, const double z2,
+                 const double w2,
+                 const double x3, const double y3, const double z3,
+                 const double w3,
+                 const double x4, const double y4, const double z4,
+                 const double w4) noexcept :
+        _m{{x1, y1, z1, w1},
+           {x2, y2, z2, w2},
+           {x3, y3, z3, w3},
+           {x4, y4, z4, w4}}
+    { }
+
+    Mat4d::Mat4d(const Mat4 &m) noexcept {
+        for(std::size_t row = 0; row < 4; ++row) {
+            for(std::size_t col = 0; col < 4; ++col) {
+                _m[row][col] = m._m[row][col];
+            }
+        }
+    }
+
+    bool Mat4d::operator==(const Mat4d &m) const {
+        for(std::size_t row = 0; row < 4; ++row) {
+            for(std::size_t col = 0; col < 4; ++col) {
+                if(std::fabs(_m[row][col] - m._m[row][col]) >=
+                   double_epsilon) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const Mat4d& Mat4d::operator*=(const Mat4d &m) {
+        *this = *this * m;
+        return *this;
+    }
+
+    Mat4d operator*(const Mat4d &m, const Mat4d &n) {
+        Mat4d result;
+
+        for(std::size_t row = 0; row < 4; ++row) {
+            for(std::size_t col = 0; col < 4; ++col) {
+                result._m[row][col] = (m._m[row][0] * n._m[0][col]) +
+                                      (m._m[row][1] * n._m[1][col]) +
+                                      (m._m[row][2] * n._m[2][col]) +
+                                      (m._m[row][3] * n._m[3][col]);
+            }
+        }
+
+        return result;
+    }
+
+    Point3d operator*(const Mat4d &m, const Point3d &p) {
+        return Point3d((m._m[0][0] * p._x) +
+                       (m._m[0][1] * p._y) +
+                       (m._m[0][2] * p._z) +
+                        m._m[0][3],
+                       (m._m[1][0] * p._x) +
+                       (m._m[1][1] * p._y) +
+                       (m._m[1][2] * p._z) +
+                        m._m[1][3],
+                       (m._m[2][0] * p._x) +
+                       (m._m[2][1] * p._y) +
+                       (m._m[2][2] * p._z) +
+                        m._m[2][3]);
+    }
+
+    std::ostream& operator<<(std::ostream &os, const Mat4d &m) {
+        os << std::fixed << std::setprecision(double_precision);
+        for(std::size_t row = 0; row < 4; ++row) {
+            os << "[" << m._m[row][0] << ", " << m._m[row][1] << ", "
+               << m._m[row][2] << ", " << m._m[row][3] << "]";
+            if(row < 3) {
+                os << "\n";
+            }
+        }
+        return os;
+    }
+} // namespace pdm
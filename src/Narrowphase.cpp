@@ -0,0 +1,188 @@
+#include "pdmath/Narrowphase.hpp"
+
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+namespace pdm {
+
+namespace {
+
+template<Shape S>
+const auto& shape(const Colliders &c, const uint32_t index) {
+    if constexpr(S == Shape::sphere) {
+        return c.spheres[index];
+    }
+    else if constexpr(S == Shape::aabb) {
+        return c.aabbs[index];
+    }
+    else if constexpr(S == Shape::obb) {
+        return c.obbs[index];
+    }
+    else if constexpr(S == Shape::line) {
+        return c.lines[index];
+    }
+    else {
+        return c.planes[index];
+    }
+}
+
+[[maybe_unused]] bool in_range(const Colliders &c, const ShapeRef &ref) {
+    switch(ref.type) {
+        case Shape::sphere: return ref.index < c.spheres.size();
+        case Shape::aabb:   return ref.index < c.aabbs.size();
+        case Shape::obb:    return ref.index < c.obbs.size();
+        case Shape::line:   return ref.index < c.lines.size();
+        case Shape::plane:  return ref.index < c.planes.size();
+    }
+    return false;
+}
+
+bool planes_meet(const Plane &a, const Plane &b) {
+    constexpr float tolerance = 1.0e-6f;
+
+    Vec3 na = a.normal();
+    Vec3 nb = b.normal();
+    Vec3 axis = na.cross(nb);
+    if(axis.dot(axis) > tolerance * tolerance * na.dot(na) * nb.dot(nb)) {
+        return true;
+    }
+
+    // Parallel, so only the same plane touches.
+    Vec3 offset(b.point()._x - a.point()._x,
+                b.point()._y - a.point()._y,
+                b.point()._z - a.point()._z);
+    return std::abs(na.dot(offset)) <= tolerance * std::sqrt(na.dot(na));
+}
+
+// Each shape class has the tests it has; the rest are filled in here.
+template<typename A, typename B>
+bool test(const A &a, const B &b) {
+    if constexpr(requires { a.collides(b); }) {
+        return a.collides(b);
+    }
+    else if constexpr(std::is_same_v<A, AABBox>) {
+        return OBBox(a).collides(b);
+    }
+    else {
+        return planes_meet(a, b);
+    }
+}
+
+/*------------------------------------------------------------------------------
+    One loop per combination, with A <= B. A pair can list its shapes
+    either way round, which is the only branch left in here.
+------------------------------------------------------------------------------*/
+template<Shape A, Shape B>
+void kernel(const Colliders &colliders,
+            std::span<const CollisionPair> pairs,
+            const uint32_t *order, const std::size_t count, uint8_t *hits) {
+    for(std::size_t i = 0; i < count; ++i) {
+        const CollisionPair &pair = pairs[order[i]];
+        bool swapped = pair.a.type != A;
+        uint32_t a = swapped ? pair.b.index : pair.a.index;
+        uint32_t b = swapped ? pair.a.index : pair.b.index;
+
+        hits[order[i]] = test(shape<A>(colliders, a),
+                              shape<B>(colliders, b)) ? 1 : 0;
+    }
+}
+
+using Kernel = void (*)(const Colliders &colliders,
+                        std::span<const CollisionPair> pairs,
+                        const uint32_t *order, std::size_t count,
+                        uint8_t *hits);
+
+// In combination() order: sphere with everything, then aabb with aabb
+// onwards, and so on.
+constexpr std::array<Kernel, Narrowphase::combination_count> kernels = {
+    kernel<Shape::sphere, Shape::sphere>,
+    kernel<Shape::sphere, Shape::aabb>,
+    kernel<Shape::sphere, Shape::obb>,
+    kernel<Shape::sphere, Shape::line>,
+    kernel<Shape::sphere, Shape::plane>,
+    kernel<Shape::aabb,   Shape::aabb>,
+    kernel<Shape::aabb,   Shape::obb>,
+    kernel<Shape::aabb,   Shape::line>,
+    kernel<Shape::aabb,   Shape::plane>,
+    kernel<Shape::obb,    Shape::obb>,
+    kernel<Shape::obb,    Shape::line>,
+    kernel<Shape::obb,    Shape::plane>,
+    kernel<Shape::line,   Shape::line>,
+    kernel<Shape::line,   Shape::plane>,
+    kernel<Shape::plane,  Shape::plane>
+};
+
+} // namespace
+
+std::size_t Narrowphase::combination(const Shape a, const Shape b) {
+    auto lo = static_cast<std::size_t>(std::min(a, b));
+    auto hi = static_cast<std::size_t>(std::max(a, b));
+
+    // Rows before lo hold shape_count, shape_count - 1, ... entries.
+    return lo * shape_count - lo * (lo - 1) / 2 + (hi - lo);
+}
+
+void Narrowphase::run(const Colliders &colliders,
+                      std::span<const CollisionPair> pairs,
+                      std::span<uint8_t> hits) {
+    PDMATH_ZONE("Narrowphase::run");
+    assert(hits.size() >= pairs.size());
+
+    // Counting sort of pair indices by combination.
+    std::array<uint32_t, combination_count> counts{};
+    for(const CollisionPair &pair : pairs) {
+        assert(in_range(colliders, pair.a) && in_range(colliders, pair.b));
+        ++counts[combination(pair.a.type, pair.b.type)];
+    }
+
+    _offsets[0] = 0;
+    for(std::size_t i = 0; i < combination_count; ++i) {
+        _offsets[i + 1] = _offsets[i] + counts[i];
+    }
+
+    _order.resize(pairs.size());
+    std::array<uint32_t, combination_count> next;
+    std::copy_n(_offsets.begin(), combination_count, next.begin());
+    for(std::size_t i = 0; i < pairs.size(); ++i) {
+        const CollisionPair &pair = pairs[i];
+        _order[next[combination(pair.a.type, pair.b.type)]++] =
+            static_cast<uint32_t>(i);
+    }
+
+    // A piece of the sorted list can straddle buckets; each part of it
+    // goes to its own kernel.
+    const uint32_t *order = _order.data();
+    _jobs->parallel_for(0, pairs.size(), grain,
+                        [&](std::size_t first, std::size_t last) {
+        PDMATH_ZONE("Narrowphase::batch");
+
+        std::size_t bucket = static_cast<std::size_t>(
+            std::upper_bound(_offsets.begin(), _offsets.end(), first) -
+            _offsets.begin()) - 1;
+
+        while(first < last) {
+            std::size_t end = std::min<std::size_t>(last,
+                                                    _offsets[bucket + 1]);
+            kernels[bucket](colliders, pairs, order + first, end - first,
+                            hits.data());
+            first = end;
+            ++bucket;
+        }
+    });
+}
+
+std::size_t Narrowphase::bucket_size(const Shape a, const Shape b) const {
+    std::size_t i = combination(a, b);
+    return _offsets[i + 1] - _offsets[i];
+}
+
+Narrowphase::Narrowphase(JobSystem &jobs) :
+    _offsets{},
+    _jobs{&jobs}
+{ }
+
+} // namespace pdm
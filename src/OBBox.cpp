@@ -1,18 +1,23 @@
 #include "pdmath/OBBox.hpp"
 
 #include "pdmath/util.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/fastmath.hpp"
 #include "pdmath/Point4.hpp"
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Vector4.hpp"
 #include "pdmath/BSphere.hpp"
 #include "pdmath/Plane.hpp"
 #include "pdmath/Line.hpp"
+#include "pdmath/instrument.hpp"
 
 #include <cmath>
 
 namespace pdm {
 
 bool OBBox::collides(const OBBox &other) const {
+    PDMATH_TIME(obbox_collides);
+
     // using cross products to get face normals
     Vec3 sideside_cross = side().cross(other.side());
     Vec3 upside_cross   = up().cross(other.side());
@@ -32,41 +37,56 @@ bool OBBox::collides(const OBBox &other) const {
     // length of the projection of the center-to-center vector onto the
     // related axes
     float side_center_dist_this =
-        std::abs(center_dist.dot(side())) / side().length();
+        std::abs(center_dist.dot(side())) *
+        fastmath::rsqrt<Accuracy::high>(side().dot(side()));
     float side_center_dist_other =
-        std::abs(center_dist.dot(other.side())) / other.side().length();
+        std::abs(center_dist.dot(other.side())) *
+        fastmath::rsqrt<Accuracy::high>(other.side().dot(other.side()));
 
     float up_center_dist_this =
-        std::abs(center_dist.dot(up())) / up().length();
+        std::abs(center_dist.dot(up())) *
+        fastmath::rsqrt<Accuracy::high>(up().dot(up()));
     float up_center_dist_other =
-        std::abs(center_dist.dot(other.up())) / other.up().length();
+        std::abs(center_dist.dot(other.up())) *
+        fastmath::rsqrt<Accuracy::high>(other.up().dot(other.up()));
 
     float fwd_center_dist_this =
-        std::abs(center_dist.dot(forward())) / forward().length();
+        std::abs(center_dist.dot(forward())) *
+        fastmath::rsqrt<Accuracy::high>(forward().dot(forward()));
     float fwd_center_dist_other =
-        std::abs(center_dist.dot(other.forward())) / other.forward().length();
+        std::abs(center_dist.dot(other.forward())) *
+        fastmath::rsqrt<Accuracy::high>(other.forward().dot(other.forward()));
 
     // same as above, except now it's the cross product axes of the two boxes
     float sideside_center_dist =
-        std::abs(center_dist.dot(sideside_cross)) / sideside_cross.length();
+        std::abs(center_dist.dot(sideside_cross)) *
+        fastmath::rsqrt<Accuracy::high>(sideside_cross.dot(sideside_cross));
     float upside_center_dist   =
-        std::abs(center_dist.dot(upside_cross)) / upside_cross.length();
+        std::abs(center_dist.dot(upside_cross)) *
+        fastmath::rsqrt<Accuracy::high>(upside_cross.dot(upside_cross));
     float fwdside_center_dist  =
-        std::abs(center_dist.dot(fwdside_cross)) / fwdside_cross.length();
+        std::abs(center_dist.dot(fwdside_cross)) *
+        fastmath::rsqrt<Accuracy::high>(fwdside_cross.dot(fwdside_cross));
 
     float sideup_center_dist   =
-        std::abs(center_dist.dot(sideup_cross)) / sideup_cross.length();
+        std::abs(center_dist.dot(sideup_cross)) *
+        fastmath::rsqrt<Accuracy::high>(sideup_cross.dot(sideup_cross));
     float upup_center_dist     =
-        std::abs(center_dist.dot(upup_cross)) / upup_cross.length();
+        std::abs(center_dist.dot(upup_cross)) *
+        fastmath::rsqrt<Accuracy::high>(upup_cross.dot(upup_cross));
     float fwdup_center_dist    =
-        std::abs(center_dist.dot(fwdup_cross)) / fwdup_cross.length();
+        std::abs(center_dist.dot(fwdup_cross)) *
+        fastmath::rsqrt<Accuracy::high>(fwdup_cross.dot(fwdup_cross));
 
     float sidefwd_center_dist  =
-        std::abs(center_dist.dot(sidefwd_cross)) / sidefwd_cross.length();
+        std::abs(center_dist.dot(sidefwd_cross)) *
+        fastmath::rsqrt<Accuracy::high>(sidefwd_cross.dot(sidefwd_cross));
     float upfwd_center_dist    =
-        std::abs(center_dist.dot(upfwd_cross)) / upfwd_cross.length();
+        std::abs(center_dist.dot(upfwd_cross)) *
+        fastmath::rsqrt<Accuracy::high>(upfwd_cross.dot(upfwd_cross));
     float fwdfwd_center_dist   = 
-        std::abs(center_dist.dot(fwdfwd_cross)) / fwdfwd_cross.length();
+        std::abs(center_dist.dot(fwdfwd_cross)) *
+        fastmath::rsqrt<Accuracy::high>(fwdfwd_cross.dot(fwdfwd_cross));
 
     // sum of the length of the projections of each "best" diagonal onto the
     // related axes
@@ -155,8 +175,9 @@ bool OBBox::collides(const OBBox &other) const {
     // pairs report overlap, there is intersection.
     //
     // Also, if any vectors were facing the same direction, their cross is the
-    // zero vector, which will give NaN for these cacluations. If that happens,
-    // just skip the vector.
+    // zero vector. The fast 1/sqrt of zero is large but finite, so both sides
+    // come out as zero and the axis passes; the NaN checks still skip it if a
+    // degenerate box gets there some other way.
 
     return ((std::isnan(side_center_dist_this) ||
              std::isnan(side_proj_this)) ||
@@ -220,62 +241,29 @@ bool OBBox::collides(const OBBox &other) const {
 }
 
 bool OBBox::collides(const Point3 &point) const {
+    PDMATH_TIME(obbox_collides);
     Point3 local_point = _local * point;
     return _min._x < local_point._x && local_point._x < _max._x &&
            _min._y < local_point._y && local_point._y < _max._y &&
            _min._z < local_point._z && local_point._z < _max._z;
 }
 
-//bool OBBox::collides(const Line &line) const {
-//    Line local = to_local(line);
-//
-//    if(line.vec()._x == 0.0f) {
-//        if(line.point_a()._x < _min._x || line.point_a()._x > _max._x) {
-//            // std::cout << "\nline's x value is zero and outside." << std::endl;
-//            return false;
-//        }
-//    }
-//    if(line.vec()._y == 0.0f) {
-//        if(line.point_a()._y < _min._y || line.point_a()._y > _max._y) {
-//            // std::cout << "\nline's y value is zero and outside." << std::endl;
-//            return false;
-//        }
-//    }
-//    if(line.vec()._z == 0.0f) {
-//        if(line.point_a()._z < _min._z || line.point_a()._z > _max._z) {
-//            // std::cout << "\nline's z value is zero and outside." << std::endl;
-//            return false;
-//        }
-//    }
-//
-//    float ax = (_min._x - line.point_a()._x) / line.vec()._x;
-//    float bx = (_max._x - line.point_a()._x) / line.vec()._x;
-//
-//    float sx = (ax < bx ? ax : bx);
-//    float tx = (ax > bx ? ax : bx);
-//
-//    float ay = (_min._y - line.point_a()._y) / line.vec()._y;
-//    float by = (_max._y - line.point_a()._y) / line.vec()._y;
-//
-//    float sy = (ay < by ? ay : by);
-//    float ty = (ay > by ? ay : by);
-//
-//    float az = (_min._z - line.point_a()._z) / line.vec()._z;
-//    float bz = (_max._z - line.point_a()._z) / line.vec()._z;
-//
-//    float sz = (az < bz ? az : bz);
-//    float tz = (az > bz ? az : bz);
-//
-//    return overlap(sx, tx, sy, ty) &&
-//        overlap(sy, ty, sz, tz) &&
-//        overlap(sz, tz, sx, tx);
-//}
+// In local space the box is axis aligned, so the AABBox slab test does it.
+// A line made from a point and a vector has no second point, so the
+// direction is carried over instead.
+bool OBBox::collides(const Line &line) const {
+    PDMATH_TIME(obbox_collides);
+    Line local(to_local(line.point_a()), to_local(line.vec()));
+    return AABBox(_min, _max).collides(local);
+}
 
 bool OBBox::collides(const BSphere &sphere) const {
+    PDMATH_TIME(obbox_collides);
     return sphere.collides(*this);
 }
 
 bool OBBox::collides(const Plane &plane) const {
+    PDMATH_TIME(obbox_collides);
     Point3 world_center = center_world();
     float  scale = get_proj_scale();
     float  proj_max = max_projection(*this, plane.normal());
@@ -350,7 +338,8 @@ Point4 OBBox::to_world(const Point4 &p) const {
 }
 
 float OBBox::get_proj_scale() const {
-    return powf(_world.get_x_scale(), 2.0f);
+    float s = _world.get_x_scale();
+    return s * s;
 }
 
 float OBBox::max_projection(const OBBox &local, const Vec3 &v) {
@@ -366,7 +355,8 @@ float OBBox::max_projection(const OBBox &local, const Vec3 &v) {
 
     return (std::abs(local_v._x * local.best_diag()._x) +
             std::abs(local_v._y * local.best_diag()._y) +
-            std::abs(local_v._z * local.best_diag()._z)) / v.length();
+            std::abs(local_v._z * local.best_diag()._z)) *
+           fastmath::rsqrt<Accuracy::high>(v.dot(v));
                                                  // use the original length!
 }
 
@@ -387,7 +377,8 @@ float OBBox::max_projection(const Vec3 &v) {
 
     return (std::abs(local_v._x * best_diag()._x) +
             std::abs(local_v._y * best_diag()._y) +
-            std::abs(local_v._z * best_diag()._z)) / v.length();
+            std::abs(local_v._z * best_diag()._z)) *
+           fastmath::rsqrt<Accuracy::high>(v.dot(v));
                                                  // use the original length!
 }
 
@@ -407,7 +398,14 @@ std::pair<float, float> OBBox::z_interval() const {
     return std::pair<float, float>(_min._z, _max._z);
 }
 
+// A box's world transform is always affine, so this keeps only the top
+// three rows.
 OBBox::OBBox(const Point3 &min, const Point3 &max, const Mat4 &world) noexcept:
+    OBBox(min, max, Affine3(world))
+{ }
+
+OBBox::OBBox(const Point3 &min, const Point3 &max,
+             const Affine3 &world) noexcept:
     _min{min},
     _max{max},
     _world{world},
@@ -421,4 +419,19 @@ OBBox::OBBox(const Point3 &min, const Point3 &max, const Mat4 &world) noexcept:
     _center_world = _world * _center;
 }
 
+// Both transforms are the identity, so there's nothing to invert and the
+// world values are the local ones.
+OBBox::OBBox(const AABBox &box) noexcept:
+    _min{box.min()},
+    _max{box.max()},
+    _min_world{box.min()},
+    _max_world{box.max()},
+    _world{Affine3::identity},
+    _local{Affine3::identity}
+{
+    _center       = (_max + _min) / 2.0f;
+    _best_diag    = (_max - _min) / 2.0f;
+    _center_world = _center;
+}
+
 } // namespace pdm
\ No newline at end of file
@@ -0,0 +1,349 @@
+#include "pdmath/OcclusionBuffer.hpp"
+
+#include "pdmath/Camera.hpp"
+#include "pdmath/Point4.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Vector.hpp"
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pdm {
+
+static constexpr float empty_depth = std::numeric_limits<float>::max();
+
+void OcclusionBuffer::clear() {
+    _occluders.clear();
+    _screen_tris.clear();
+    std::fill(_depth.begin(), _depth.end(), empty_depth);
+    std::fill(_tile_max.begin(), _tile_max.end(), empty_depth);
+}
+
+void OcclusionBuffer::add_occluder(const Point3 &a, const Point3 &b,
+                                   const Point3 &c) {
+    _occluders.push_back(a);
+    _occluders.push_back(b);
+    _occluders.push_back(c);
+}
+
+void OcclusionBuffer::rasterize(const Camera &camera) {
+    PDMATH_ZONE("OcclusionBuffer::rasterize");
+
+    float scale_x = static_cast<float>(_width)  / camera.x_res();
+    float scale_y = static_cast<float>(_height) / camera.y_res();
+
+    _screen_tris.clear();
+    std::fill(_depth.begin(), _depth.end(), empty_depth);
+
+    for(std::size_t i = 0; i < _occluders.size(); i += 3) {
+        ScreenTri tri;
+        bool clipped = false;
+
+        for(std::size_t v = 0; v < 3; ++v) {
+            Point4 vertex(_occluders[i + v]);
+
+            // Anything touching the near plane is dropped rather than clipped;
+            // losing an occluder only makes the buffer more conservative.
+            if(camera.view(vertex)._z > -camera.near_plane()) {
+                clipped = true;
+                break;
+            }
+
+            Point4 screen = camera.persp_screen(vertex);
+            tri.x[v] = screen._x * scale_x;
+            tri.y[v] = screen._y * scale_y;
+            tri.z[v] = screen._z;
+        }
+
+        if(!clipped) {
+            _screen_tris.push_back(tri);
+        }
+    }
+
+    bin_triangles();
+
+    // Tiles cost very different amounts, so by default they're handed out
+    // one at a time and left to work stealing to balance; a thread count
+    // caps the split at that many pieces.
+    std::size_t tile_count = static_cast<std::size_t>(_tiles_x) * _tiles_y;
+    std::size_t grain = 1;
+    if(_thread_count > 0) {
+        grain = (tile_count + _thread_count - 1) / _thread_count;
+    }
+
+    _jobs->parallel_for(0, tile_count, grain,
+                        [this](std::size_t first, std::size_t last) {
+        for(std::size_t tile = first; tile < last; ++tile) {
+            rasterize_tile(static_cast<uint32_t>(tile));
+        }
+    });
+}
+
+void OcclusionBuffer::bin_triangles() {
+    PDMATH_ZONE("OcclusionBuffer::bin_triangles");
+
+    for(auto &bin : _bins) {
+        bin.clear();
+    }
+
+    for(std::size_t i = 0; i < _screen_tris.size(); ++i) {
+        const ScreenTri &tri = _screen_tris[i];
+
+        float min_x = std::min({tri.x[0], tri.x[1], tri.x[2]});
+        float max_x = std::max({tri.x[0], tri.x[1], tri.x[2]});
+        float min_y = std::min({tri.y[0], tri.y[1], tri.y[2]});
+        float max_y = std::max({tri.y[0], tri.y[1], tri.y[2]});
+
+        if(max_x < 0.0f || max_y < 0.0f ||
+           min_x >= static_cast<float>(_width) ||
+           min_y >= static_cast<float>(_height)) {
+            continue;
+        }
+
+        auto first_x = static_cast<uint32_t>(std::max(min_x, 0.0f)) /
+                       tile_width;
+        auto first_y = static_cast<uint32_t>(std::max(min_y, 0.0f)) /
+                       tile_height;
+        auto last_x  = static_cast<uint32_t>(
+            std::min(max_x, static_cast<float>(_width  - 1))) / tile_width;
+        auto last_y  = static_cast<uint32_t>(
+            std::min(max_y, static_cast<float>(_height - 1))) / tile_height;
+
+        for(uint32_t ty = first_y; ty <= last_y; ++ty) {
+            for(uint32_t tx = first_x; tx <= last_x; ++tx) {
+                _bins[ty * _tiles_x + tx].push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::rasterize_tile(uint32_t tile) {
+    PDMATH_ZONE("OcclusionBuffer::rasterize_tile");
+
+    uint32_t x0 = (tile % _tiles_x) * tile_width;
+    uint32_t y0 = (tile / _tiles_x) * tile_height;
+    uint32_t x1 = std::min(x0 + tile_width,  _width);
+    uint32_t y1 = std::min(y0 + tile_height, _height);
+
+    for(uint32_t index : _bins[tile]) {
+        rasterize_tri(_screen_tris[index], x0, y0, x1, y1);
+    }
+
+    float tile_max = 0.0f;
+    for(uint32_t y = y0; y < y1; ++y) {
+        const float *row = &_depth[y * _width];
+        for(uint32_t x = x0; x < x1; ++x) {
+            tile_max = std::max(tile_max, row[x]);
+        }
+    }
+
+    _tile_max[tile] = tile_max;
+}
+
+/*------------------------------------------------------------------------------
+    Each edge function is kept in the form e(x, y) = a*x + b*y + c, so a row of
+    the tile only needs one multiply-add per pixel per edge. With SSE2 a row
+    goes four pixels at a time: the three edge tests and the depth test are
+    packed compares, and the depth write is a blend. Each lane does the same
+    operations as the scalar loop, which finishes the row, so both write the
+    same depths.
+------------------------------------------------------------------------------*/
+void OcclusionBuffer::rasterize_tri(const ScreenTri &tri,
+                                    uint32_t x0, uint32_t y0,
+                                    uint32_t x1, uint32_t y1) {
+    float a[3];
+    float b[3];
+    float c[3];
+
+    for(std::size_t e = 0; e < 3; ++e) {
+        std::size_t i = (e + 1) % 3;
+        std::size_t j = (e + 2) % 3;
+
+        a[e] = tri.y[i] - tri.y[j];
+        b[e] = tri.x[j] - tri.x[i];
+        c[e] = tri.x[i] * tri.y[j] - tri.x[j] * tri.y[i];
+    }
+
+    float area = c[0] + c[1] + c[2];
+    if(std::abs(area) < std::numeric_limits<float>::epsilon()) {
+        return;
+    }
+
+    // Normalize the winding so "inside" is always non-negative.
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+    for(std::size_t e = 0; e < 3; ++e) {
+        a[e] *= sign;
+        b[e] *= sign;
+        c[e] *= sign;
+    }
+    area *= sign;
+
+    float z_a = (a[0] * tri.z[0] + a[1] * tri.z[1] + a[2] * tri.z[2]) / area;
+    float z_b = (b[0] * tri.z[0] + b[1] * tri.z[1] + b[2] * tri.z[2]) / area;
+    float z_c = (c[0] * tri.z[0] + c[1] * tri.z[1] + c[2] * tri.z[2]) / area;
+
+    float min_x = std::min({tri.x[0], tri.x[1], tri.x[2]});
+    float max_x = std::max({tri.x[0], tri.x[1], tri.x[2]});
+    float min_y = std::min({tri.y[0], tri.y[1], tri.y[2]});
+    float max_y = std::max({tri.y[0], tri.y[1], tri.y[2]});
+
+    x0 = std::max(x0, static_cast<uint32_t>(
+        std::clamp(min_x, 0.0f, static_cast<float>(x1))));
+    y0 = std::max(y0, static_cast<uint32_t>(
+        std::clamp(min_y, 0.0f, static_cast<float>(y1))));
+    x1 = std::min(x1, static_cast<uint32_t>(
+        std::clamp(max_x + 1.0f, 0.0f, static_cast<float>(x1))));
+    y1 = std::min(y1, static_cast<uint32_t>(
+        std::clamp(max_y + 1.0f, 0.0f, static_cast<float>(y1))));
+
+    for(uint32_t y = y0; y < y1; ++y) {
+        float py = static_cast<float>(y) + 0.5f;
+
+        float row_e0 = b[0] * py + c[0];
+        float row_e1 = b[1] * py + c[1];
+        float row_e2 = b[2] * py + c[2];
+        float row_z  = z_b  * py + z_c;
+
+        float *row = &_depth[y * _width];
+        uint32_t x = x0;
+
+#if defined(PDMATH_SIMD_SSE2)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 four = _mm_set1_ps(4.0f);
+
+        const __m128 a0 = _mm_set1_ps(a[0]);
+        const __m128 a1 = _mm_set1_ps(a[1]);
+        const __m128 a2 = _mm_set1_ps(a[2]);
+        const __m128 za = _mm_set1_ps(z_a);
+
+        const __m128 r0 = _mm_set1_ps(row_e0);
+        const __m128 r1 = _mm_set1_ps(row_e1);
+        const __m128 r2 = _mm_set1_ps(row_e2);
+        const __m128 rz = _mm_set1_ps(row_z);
+
+        float first_px = static_cast<float>(x) + 0.5f;
+        __m128 px = _mm_setr_ps(first_px,        first_px + 1.0f,
+                                first_px + 2.0f, first_px + 3.0f);
+
+        for(; x + 4 <= x1; x += 4) {
+            __m128 e0 = _mm_add_ps(r0, _mm_mul_ps(a0, px));
+            __m128 e1 = _mm_add_ps(r1, _mm_mul_ps(a1, px));
+            __m128 e2 = _mm_add_ps(r2, _mm_mul_ps(a2, px));
+            __m128 z  = _mm_add_ps(rz, _mm_mul_ps(za, px));
+
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero),
+                                                  _mm_cmpge_ps(e1, zero)),
+                                       _mm_cmpge_ps(e2, zero));
+
+            __m128 depth  = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_and_ps(inside, _mm_cmplt_ps(z, depth));
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(nearer, z),
+                                             _mm_andnot_ps(nearer, depth)));
+
+            px = _mm_add_ps(px, four);
+        }
+#endif
+
+        for(; x < x1; ++x) {
+            float px = static_cast<float>(x) + 0.5f;
+
+            float e0 = row_e0 + a[0] * px;
+            float e1 = row_e1 + a[1] * px;
+            float e2 = row_e2 + a[2] * px;
+            float z  = row_z  + z_a  * px;
+
+            bool inside = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f);
+            row[x] = (inside && z < row[x]) ? z : row[x];
+        }
+    }
+}
+
+bool OcclusionBuffer::visible(const Camera &camera, const AABBox &box) const {
+    return visible(camera, camera.projected_bounds(box));
+}
+
+bool OcclusionBuffer::visible(const Camera &camera,
+                              const BSphere &sphere) const {
+    return visible(camera, camera.projected_bounds(sphere));
+}
+
+bool OcclusionBuffer::visible(const Camera &camera,
+                              const ScreenBounds &bounds) const {
+    if(!bounds.valid) {
+        return true;
+    }
+
+    float scale_x = static_cast<float>(_width)  / camera.x_res();
+    float scale_y = static_cast<float>(_height) / camera.y_res();
+
+    return visible(bounds.min_x * scale_x, bounds.min_y * scale_y,
+                   bounds.max_x * scale_x, bounds.max_y * scale_y,
+                   bounds.min_depth);
+}
+
+bool OcclusionBuffer::visible(float min_x, float min_y,
+                              float max_x, float max_y,
+                              float min_depth) const {
+    if(max_x < 0.0f || max_y < 0.0f ||
+       min_x >= static_cast<float>(_width) ||
+       min_y >= static_cast<float>(_height)) {
+        return false;
+    }
+
+    auto x0 = static_cast<uint32_t>(std::max(min_x, 0.0f));
+    auto y0 = static_cast<uint32_t>(std::max(min_y, 0.0f));
+    auto x1 = static_cast<uint32_t>(
+        std::min(max_x, static_cast<float>(_width  - 1)));
+    auto y1 = static_cast<uint32_t>(
+        std::min(max_y, static_cast<float>(_height - 1)));
+
+    for(uint32_t ty = y0 / tile_height; ty <= y1 / tile_height; ++ty) {
+        for(uint32_t tx = x0 / tile_width; tx <= x1 / tile_width; ++tx) {
+            // Coarse level first: the whole tile is already nearer.
+            if(min_depth > _tile_max[ty * _tiles_x + tx]) {
+                continue;
+            }
+
+            uint32_t px0 = std::max(x0, tx * tile_width);
+            uint32_t py0 = std::max(y0, ty * tile_height);
+            uint32_t px1 = std::min(x1, tx * tile_width  + tile_width  - 1);
+            uint32_t py1 = std::min(y1, ty * tile_height + tile_height - 1);
+
+            for(uint32_t y = py0; y <= py1; ++y) {
+                for(uint32_t x = px0; x <= px1; ++x) {
+                    if(min_depth <= _depth[y * _width + x]) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+float OcclusionBuffer::depth(uint32_t x, uint32_t y) const {
+    return _depth[y * _width + x];
+}
+
+float OcclusionBuffer::tile_depth(uint32_t x, uint32_t y) const {
+    return _tile_max[(y / tile_height) * _tiles_x + (x / tile_width)];
+}
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height,
+                                 uint32_t thread_count, JobSystem &jobs) :
+    _width{width},
+    _height{height},
+    _tiles_x{(width  + tile_width  - 1) / tile_width},
+    _tiles_y{(height + tile_height - 1) / tile_height},
+    _thread_count{thread_count},
+    _jobs{&jobs},
+    _depth(static_cast<std::size_t>(width) * height, empty_depth),
+    _tile_max(static_cast<std::size_t>(_tiles_x) * _tiles_y, empty_depth),
+    _bins(static_cast<std::size_t>(_tiles_x) * _tiles_y)
+{ }
+
+} // namespace pdm
@@ -0,0 +1,70 @@
+#include "pdmath/Point3d.hpp"
+
+#include "pdmath/util.hpp"
+#include "pdmath/Point3.hpp"
+#include "pdmath/Vector3.hpp"
+
+#include <iomanip>
+#include <cmath>
+
+namespace pdm {
+// The subtraction happens in double, so only the (small) offset from the
+// origin gets rounded to float.
+Point3 Point3d::relative_to(const Point3d &origin) const {
+    return Point3(static_cast<float>(_x - origin._x),
+                  static_cast<float>(_y - origin._y),
+                  static_cast<float>(_z - origin._z));
+}
+
+Point3d::Point3d() noexcept :
+    _x{0.0}, _y{0.0}, _z{0.0}
+{ }
+
+Point3d::Point3d(const double x, const double y, const double z) noexcept :
+    _x{x}, _y{y}, _z{z}
+{ }
+
+Point3d::Point3d(const Point3 &p) noexcept :
+    _x{p._x}, _y{p._y}, _z{p._z}
+{ }
+
+bool Point3d::operator==(const Point3d &p) const {
+    return std::fabs(_x - p._x) < double_epsilon &&
+           std::fabs(_y - p._y) < double_epsilon &&
+           std::fabs(_z - p._z) < double_epsilon;
+}
+
+const Point3d& Point3d::operator+=(const Vec3 &v) {
+    this->_x += v._x;
+    this->_y += v._y;
+    this->_z += v._z;
+    return *this;
+}
+
+const Point3d& Point3d::operator-=(const Vec3 &v) {
+    this->_x -= v._x;
+    this->_y -= v._y;
+    this->_z -= v._z;
+    return *this;
+}
+
+Point3d operator+(const Point3d &p, const Vec3 &v) {
+    return Point3d(p._x + v._x,
+                   p._y + v._y,
+                   p._z + v._z);
+}
+
+Point3d operator-(const Point3d &p, const Vec3 &v) {
+    return Point3d(p._x - v._x,
+                   p._y - v._y,
+                   p._z - v._z);
+}
+
+std::ostream& operator<<(std::ostream &os, const Point3d &p) {
+    os << std::fixed << std::setprecision(double_precision) << "("
+        << p._x << ", "
+        << p._y << ", "
+        << p._z << ")";
+    return os;
+}
+} // namespace pdm
@@ -1,6 +1,10 @@
 #include "pdmath/Quaternion.hpp"
 
 #include "pdmath/util.hpp"
+#include "pdmath/fastmath.hpp"
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Vector.hpp"
 
 #include <cmath>
 #include <numbers>
@@ -15,9 +19,10 @@ namespace pdm {
             return;
         }
         
-        _w = std::cos(theta/2.0f);
+        float sin_half;
+        fastmath::sincos<fastmath::portable>(theta/2.0f, sin_half, _w);
         _v = axis.normalized();
-        _v *= std::sin(theta/2.0f);
+        _v *= sin_half;
     }
 
     Quat::Quat(float theta, float x, float y, float z) noexcept {
@@ -27,11 +32,11 @@ namespace pdm {
 
     const Quat Quat::identity(1.0f, 0.0f, 0.0f, 0.0f);
 
-    Quat Quat::inverted() {
+    Quat Quat::inverted() const {
         return Quat(this->_w, -this->_v._x, -this->_v._y, -this->_v._z);
     }
 
-    Quat Quat::normalized() {
+    Quat Quat::normalized() const {
         float _length = length();
 
         if(fabsf(_length - 1.0f) < float_epsilon) {
@@ -45,10 +50,346 @@ namespace pdm {
         }
     }
 
-    float Quat::length() {
+    float Quat::length() const {
         return sqrtf(_w*_w + _v._x*_v._x + _v._y*_v._y + _v._z*_v._z);
     }
 
+    float Quat::dot(const Quat &q) const {
+        return _w * q._w + _v.dot(q._v);
+    }
+
+    /*--------------------------------------------------------------------------
+        q * v * q^-1 for a unit quaternion, expanded down to two cross
+        products:
+
+            t  = 2 * (q.v x v)
+            v' = v + w * t + (q.v x t)
+    --------------------------------------------------------------------------*/
+    Vec3 Quat::rotate(const Vec3 &v) const {
+        float tx = 2.0f * (_v._y * v._z - _v._z * v._y);
+        float ty = 2.0f * (_v._z * v._x - _v._x * v._z);
+        float tz = 2.0f * (_v._x * v._y - _v._y * v._x);
+
+        return Vec3(v._x + _w * tx + (_v._y * tz - _v._z * ty),
+                    v._y + _w * ty + (_v._z * tx - _v._x * tz),
+                    v._z + _w * tz + (_v._x * ty - _v._y * tx));
+    }
+
+    Quat Quat::slerp(const Quat &a, const Quat &b, const float t) {
+        float cos_theta = a.dot(b);
+        float sign = 1.0f;
+
+        // take the short way around
+        if(cos_theta < 0.0f) {
+            cos_theta = -cos_theta;
+            sign = -1.0f;
+        }
+
+        // nearly parallel, sin(theta) heads to zero and nlerp is just as good
+        if(cos_theta > 0.9995f) {
+            return nlerp(a, b, t);
+        }
+
+        using fastmath::portable;
+        float theta     = fastmath::acos<portable>(cos_theta);
+        float sin_theta = fastmath::sin<portable>(theta);
+        float weight_a  = fastmath::sin<portable>((1.0f - t) * theta)
+                        / sin_theta;
+        float weight_b  = sign * fastmath::sin<portable>(t * theta)
+                        / sin_theta;
+
+        return Quat(weight_a * a._w    + weight_b * b._w,
+                    weight_a * a._v._x + weight_b * b._v._x,
+                    weight_a * a._v._y + weight_b * b._v._y,
+                    weight_a * a._v._z + weight_b * b._v._z);
+    }
+
+    Quat Quat::nlerp(const Quat &a, const Quat &b, const float t) {
+        float weight_a = 1.0f - t;
+        float weight_b = a.dot(b) < 0.0f ? -t : t;
+
+        float w = weight_a * a._w    + weight_b * b._w;
+        float x = weight_a * a._v._x + weight_b * b._v._x;
+        float y = weight_a * a._v._y + weight_b * b._v._y;
+        float z = weight_a * a._v._z + weight_b * b._v._z;
+
+        float inv_length = 1.0f / std::sqrt(w*w + x*x + y*y + z*z);
+
+        return Quat(w * inv_length, x * inv_length,
+                    y * inv_length, z * inv_length);
+    }
+
+    Mat3 Quat::to_mat3() const {
+        float x = _v._x;
+        float y = _v._y;
+        float z = _v._z;
+
+        float xx = x * x;
+        float yy = y * y;
+        float zz = z * z;
+        float xy = x * y;
+        float xz = x * z;
+        float yz = y * z;
+        float wx = _w * x;
+        float wy = _w * y;
+        float wz = _w * z;
+
+        return Mat3(1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz),
+                    2.0f * (xz + wy),
+                    2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz),
+                    2.0f * (yz - wx),
+                    2.0f * (xz - wy), 2.0f * (yz + wx),
+                    1.0f - 2.0f * (xx + yy));
+    }
+
+    Mat4 Quat::to_mat4() const {
+        return Mat4(to_mat3());
+    }
+
+    /*--------------------------------------------------------------------------
+        Shepperd's method: pull the largest of w, x, y or z out of the
+        diagonal first, so the square root never gets close to zero, then
+        recover the other three from the off-diagonal sums and differences.
+    --------------------------------------------------------------------------*/
+    Quat Quat::from_mat3(const Mat3 &m) {
+        float trace = m._m[0][0] + m._m[1][1] + m._m[2][2];
+
+        if(trace > 0.0f) {
+            float s = 2.0f * std::sqrt(trace + 1.0f);
+            return Quat(0.25f * s,
+                        (m._m[2][1] - m._m[1][2]) / s,
+                        (m._m[0][2] - m._m[2][0]) / s,
+                        (m._m[1][0] - m._m[0][1]) / s);
+        }
+
+        if(m._m[0][0] > m._m[1][1] && m._m[0][0] > m._m[2][2]) {
+            float s = 2.0f * std::sqrt(1.0f + m._m[0][0] -
+                                       m._m[1][1] - m._m[2][2]);
+            return Quat((m._m[2][1] - m._m[1][2]) / s,
+                        0.25f * s,
+                        (m._m[0][1] + m._m[1][0]) / s,
+                        (m._m[0][2] + m._m[2][0]) / s);
+        }
+
+        if(m._m[1][1] > m._m[2][2]) {
+            float s = 2.0f * std::sqrt(1.0f + m._m[1][1] -
+                                       m._m[0][0] - m._m[2][2]);
+            return Quat((m._m[0][2] - m._m[2][0]) / s,
+                        (m._m[0][1] + m._m[1][0]) / s,
+                        0.25f * s,
+                        (m._m[1][2] + m._m[2][1]) / s);
+        }
+
+        float s = 2.0f * std::sqrt(1.0f + m._m[2][2] -
+                                   m._m[0][0] - m._m[1][1]);
+        return Quat((m._m[1][0] - m._m[0][1]) / s,
+                    (m._m[0][2] + m._m[2][0]) / s,
+                    (m._m[1][2] + m._m[2][1]) / s,
+                    0.25f * s);
+    }
+
+#if defined(PDMATH_SIMD_SSE2)
+    /*--------------------------------------------------------------------------
+        The batched rotate, nlerp and to_mat3 take four quaternions at a
+        time, transposed so each register holds one component of all four.
+        Each lane does the single version's arithmetic in the same order,
+        so the results are identical; the last few go through the single
+        version. Vec3 and Mat3 aren't 16 bytes wide, so they go in and out
+        a float at a time.
+    --------------------------------------------------------------------------*/
+    static_assert(sizeof(Quat) == 4 * sizeof(float));
+
+    namespace {
+    struct Quat4 {
+        __m128 w;
+        __m128 x;
+        __m128 y;
+        __m128 z;
+    };
+
+    struct Vec3x4 {
+        __m128 x;
+        __m128 y;
+        __m128 z;
+    };
+    } // namespace
+
+    static inline Quat4 load4(const Quat *q) {
+        Quat4 r{_mm_loadu_ps(&q[0]._w), _mm_loadu_ps(&q[1]._w),
+                _mm_loadu_ps(&q[2]._w), _mm_loadu_ps(&q[3]._w)};
+        _MM_TRANSPOSE4_PS(r.w, r.x, r.y, r.z);
+        return r;
+    }
+
+    static inline void store4(Quat *q, Quat4 r) {
+        _MM_TRANSPOSE4_PS(r.w, r.x, r.y, r.z);
+        _mm_storeu_ps(&q[0]._w, r.w);
+        _mm_storeu_ps(&q[1]._w, r.x);
+        _mm_storeu_ps(&q[2]._w, r.y);
+        _mm_storeu_ps(&q[3]._w, r.z);
+    }
+
+    static inline Vec3x4 load4(const Vec3 *v) {
+        return Vec3x4{_mm_setr_ps(v[0]._x, v[1]._x, v[2]._x, v[3]._x),
+                      _mm_setr_ps(v[0]._y, v[1]._y, v[2]._y, v[3]._y),
+                      _mm_setr_ps(v[0]._z, v[1]._z, v[2]._z, v[3]._z)};
+    }
+
+    static inline void store4(Vec3 *v, const Vec3x4 &r) {
+        alignas(16) float x[4];
+        alignas(16) float y[4];
+        alignas(16) float z[4];
+        _mm_store_ps(x, r.x);
+        _mm_store_ps(y, r.y);
+        _mm_store_ps(z, r.z);
+
+        for(std::size_t i = 0; i < 4; ++i) {
+            v[i] = Vec3(x[i], y[i], z[i]);
+        }
+    }
+
+    static inline __m128 mul(const __m128 a, const __m128 b) {
+        return _mm_mul_ps(a, b);
+    }
+
+    static inline __m128 add(const __m128 a, const __m128 b) {
+        return _mm_add_ps(a, b);
+    }
+
+    static inline __m128 sub(const __m128 a, const __m128 b) {
+        return _mm_sub_ps(a, b);
+    }
+#endif
+
+    void Quat::rotate(std::span<const Quat> q, std::span<const Vec3> v,
+                      std::span<Vec3> out) {
+        std::size_t i = 0;
+
+#if defined(PDMATH_SIMD_SSE2)
+        const __m128 two = _mm_set1_ps(2.0f);
+
+        for(; i + 4 <= q.size(); i += 4) {
+            Quat4  r = load4(&q[i]);
+            Vec3x4 p = load4(&v[i]);
+
+            __m128 tx = mul(two, sub(mul(r.y, p.z), mul(r.z, p.y)));
+            __m128 ty = mul(two, sub(mul(r.z, p.x), mul(r.x, p.z)));
+            __m128 tz = mul(two, sub(mul(r.x, p.y), mul(r.y, p.x)));
+
+            store4(&out[i], Vec3x4{
+                add(add(p.x, mul(r.w, tx)), sub(mul(r.y, tz), mul(r.z, ty))),
+                add(add(p.y, mul(r.w, ty)), sub(mul(r.z, tx), mul(r.x, tz))),
+                add(add(p.z, mul(r.w, tz)), sub(mul(r.x, ty), mul(r.y, tx)))
+            });
+        }
+#endif
+
+        for(; i < q.size(); ++i) {
+            out[i] = q[i].rotate(v[i]);
+        }
+    }
+
+    void Quat::slerp(std::span<const Quat> a, std::span<const Quat> b,
+                     const float t, std::span<Quat> out) {
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = slerp(a[i], b[i], t);
+        }
+    }
+
+    void Quat::nlerp(std::span<const Quat> a, std::span<const Quat> b,
+                     const float t, std::span<Quat> out) {
+        std::size_t i = 0;
+
+#if defined(PDMATH_SIMD_SSE2)
+        const __m128 one      = _mm_set1_ps(1.0f);
+        const __m128 zero     = _mm_setzero_ps();
+        const __m128 sign     = _mm_set1_ps(-0.0f);
+        const __m128 weight_a = _mm_set1_ps(1.0f - t);
+        const __m128 t4       = _mm_set1_ps(t);
+
+        for(; i + 4 <= a.size(); i += 4) {
+            Quat4 qa = load4(&a[i]);
+            Quat4 qb = load4(&b[i]);
+
+            // -t where the two are in opposite hemispheres
+            __m128 dot = add(mul(qa.w, qb.w),
+                             add(add(mul(qa.x, qb.x), mul(qa.y, qb.y)),
+                                 mul(qa.z, qb.z)));
+            __m128 weight_b = _mm_xor_ps(
+                t4, _mm_and_ps(_mm_cmplt_ps(dot, zero), sign));
+
+            Quat4 r{add(mul(weight_a, qa.w), mul(weight_b, qb.w)),
+                    add(mul(weight_a, qa.x), mul(weight_b, qb.x)),
+                    add(mul(weight_a, qa.y), mul(weight_b, qb.y)),
+                    add(mul(weight_a, qa.z), mul(weight_b, qb.z))};
+
+            __m128 length_sq = add(add(add(mul(r.w, r.w), mul(r.x, r.x)),
+                                       mul(r.y, r.y)),
+                                   mul(r.z, r.z));
+            __m128 inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_sq));
+
+            store4(&out[i], Quat4{mul(r.w, inv_length), mul(r.x, inv_length),
+                                  mul(r.y, inv_length), mul(r.z, inv_length)});
+        }
+#endif
+
+        for(; i < a.size(); ++i) {
+            out[i] = nlerp(a[i], b[i], t);
+        }
+    }
+
+    void Quat::to_mat3(std::span<const Quat> q, std::span<Mat3> out) {
+        std::size_t i = 0;
+
+#if defined(PDMATH_SIMD_SSE2)
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+
+        for(; i + 4 <= q.size(); i += 4) {
+            Quat4 r = load4(&q[i]);
+
+            __m128 xx = mul(r.x, r.x);
+            __m128 yy = mul(r.y, r.y);
+            __m128 zz = mul(r.z, r.z);
+            __m128 xy = mul(r.x, r.y);
+            __m128 xz = mul(r.x, r.z);
+            __m128 yz = mul(r.y, r.z);
+            __m128 wx = mul(r.w, r.x);
+            __m128 wy = mul(r.w, r.y);
+            __m128 wz = mul(r.w, r.z);
+
+            alignas(16) float m[3][3][4];
+            _mm_store_ps(m[0][0], sub(one, mul(two, add(yy, zz))));
+            _mm_store_ps(m[0][1], mul(two, sub(xy, wz)));
+            _mm_store_ps(m[0][2], mul(two, add(xz, wy)));
+            _mm_store_ps(m[1][0], mul(two, add(xy, wz)));
+            _mm_store_ps(m[1][1], sub(one, mul(two, add(xx, zz))));
+            _mm_store_ps(m[1][2], mul(two, sub(yz, wx)));
+            _mm_store_ps(m[2][0], mul(two, sub(xz, wy)));
+            _mm_store_ps(m[2][1], mul(two, add(yz, wx)));
+            _mm_store_ps(m[2][2], sub(one, mul(two, add(xx, yy))));
+
+            for(std::size_t j = 0; j < 4; ++j) {
+                for(std::size_t row = 0; row < 3; ++row) {
+                    for(std::size_t col = 0; col < 3; ++col) {
+                        out[i + j]._m[row][col] = m[row][col][j];
+                    }
+                }
+            }
+        }
+#endif
+
+        for(; i < q.size(); ++i) {
+            out[i] = q[i].to_mat3();
+        }
+    }
+
+    void Quat::from_mat3(std::span<const Mat3> m, std::span<Quat> out) {
+        for(std::size_t i = 0; i < m.size(); ++i) {
+            out[i] = from_mat3(m[i]);
+        }
+    }
+
     bool Quat::operator==(const Quat &q) const {
         float diff = fabsf(this->_w) - fabsf(q._w);
         return fabsf(diff) < float_epsilon && this->_v == q._v;
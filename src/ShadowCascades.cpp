@@ -0,0 +1,146 @@
+#include "pdmath/ShadowCascades.hpp"
+
+#include "pdmath/Point3.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pdm {
+
+/*------------------------------------------------------------------------------
+    Blend of the logarithmic and uniform split schemes:
+
+        log_i = near * (far / near)^(i / N)
+        lin_i = near + (far - near) * (i / N)
+        split = lambda * log_i + (1 - lambda) * lin_i
+
+    splits.size() is the number of cascades plus one.
+------------------------------------------------------------------------------*/
+void ShadowCascades::split_distances(const float near, const float far,
+                                     const float lambda,
+                                     std::span<float> splits) {
+    std::size_t count = splits.size() - 1;
+
+    for(std::size_t i = 0; i <= count; ++i) {
+        float ratio = static_cast<float>(i) / static_cast<float>(count);
+        float log   = near * std::pow(far / near, ratio);
+        float lin   = near + (far - near) * ratio;
+
+        splits[i] = lambda * log + (1.0f - lambda) * lin;
+    }
+
+    splits[0]     = near;
+    splits[count] = far;
+}
+
+void ShadowCascades::fit(const Camera &view, const Vec3 &light_dir) {
+    PDMATH_ZONE("ShadowCascades::fit");
+
+    split_distances(view.near_plane(), view.far_plane(), _lambda,
+                    std::span<float>(_splits.data(), _count + 1));
+
+    Vec3 up(0.0f, 1.0f, 0.0f);
+    if(std::abs(light_dir.normalized().dot(up)) > 0.99f) {
+        up = Vec3(1.0f, 0.0f, 0.0f);
+    }
+
+    // Every cascade shares the light's orientation, only the ortho box moves.
+    Camera light(Vec3::zero, light_dir, up);
+    _light_view = light.world_to_view();
+
+    for(std::size_t i = 0; i < _count; ++i) {
+        std::array<Point3, 8> corners =
+            view.frustum_corners(_splits[i], _splits[i + 1]);
+
+        Vec3 center = Vec3::zero;
+        for(const Point3 &corner : corners) {
+            center += corner;
+        }
+        center /= 8.0f;
+
+        // A bounding sphere keeps the box size fixed as the view rotates,
+        // which is half of what stops the shadow edges from crawling.
+        float radius = 0.0f;
+        for(const Point3 &corner : corners) {
+            radius = std::max(radius, (Vec3(corner) - center).length());
+        }
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // The other half: only ever move the box by whole texels.
+        float  texel  = (2.0f * radius) / _resolution;
+        Point3 origin = _light_view * Point3(center);
+        origin._x = std::floor(origin._x / texel) * texel;
+        origin._y = std::floor(origin._y / texel) * texel;
+
+        float near_z = origin._z;
+        float far_z  = origin._z;
+        for(const Point3 &corner : corners) {
+            float z = (_light_view * corner)._z;
+            near_z = std::max(near_z, z);
+            far_z  = std::min(far_z,  z);
+        }
+
+        _bounds[i] = LightBounds{origin._x - radius, origin._x + radius,
+                                 origin._y - radius, origin._y + radius,
+                                 near_z, far_z};
+
+        // view space looks down -z, so the distances flip sign
+        _lights[i] = light;
+        _lights[i].set_ortho(_bounds[i].left,  _bounds[i].right,
+                             _bounds[i].top,   _bounds[i].bottom,
+                             -near_z - _extrusion, -far_z,
+                             _resolution, _resolution, 1.0f);
+    }
+}
+
+/*------------------------------------------------------------------------------
+    Casters only need to overlap a cascade's box when seen from the light, and
+    sit anywhere between the far side of the box and the extruded near plane.
+    Bit i of masks[c] is set when caster c can throw a shadow into cascade i.
+------------------------------------------------------------------------------*/
+void ShadowCascades::cull(std::span<const BSphere> casters,
+                          std::span<uint32_t>      masks) const {
+    PDMATH_ZONE("ShadowCascades::cull");
+
+    for(std::size_t c = 0; c < casters.size(); ++c) {
+        Point3 center = _light_view * casters[c].center_world();
+        float  radius = casters[c].scaled_radius();
+
+        uint32_t mask = 0;
+
+        for(std::size_t i = 0; i < _count; ++i) {
+            const LightBounds &b = _bounds[i];
+
+            bool inside = center._x + radius >= b.left   &&
+                          center._x - radius <= b.right  &&
+                          center._y + radius >= b.bottom &&
+                          center._y - radius <= b.top    &&
+                          center._z + radius >= b.far_z  &&
+                          center._z - radius <= b.near_z + _extrusion;
+
+            mask |= static_cast<uint32_t>(inside) << i;
+        }
+
+        masks[c] = mask;
+    }
+}
+
+Mat4 ShadowCascades::light_ndc(const std::size_t cascade) const {
+    return _lights[cascade].ortho_ndc() * _lights[cascade].world_to_view();
+}
+
+ShadowCascades::ShadowCascades(const std::size_t count, const float lambda,
+                               const float resolution,
+                               const float extrusion) noexcept :
+    _count{std::clamp<std::size_t>(count, 1, max_cascades)},
+    _lambda{lambda},
+    _resolution{resolution},
+    _extrusion{extrusion},
+    _splits{},
+    _lights{},
+    _bounds{}
+{ }
+
+} // namespace pdm
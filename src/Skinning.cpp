@@ -0,0 +1,127 @@
+#include "pdmath/Skinning.hpp"
+
+#include "kernels/kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pdm {
+
+// Vertices are skinned in blocks: a gather step pulls each lane's blended
+// transform into small SoA arrays, then the transform and bounds loops run
+// over whole lanes from the kernel table, built for each instruction set.
+static constexpr std::size_t block_size = kernels::skin_block;
+
+namespace {
+
+struct Bounds {
+    float min[3] = { std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max() };
+    float max[3] = { std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest() };
+
+    AABBox box() const {
+        return AABBox(Point3(min[0], min[1], min[2]),
+                      Point3(max[0], max[1], max[2]));
+    }
+};
+
+} // namespace
+
+AABBox skin_linear(const SkinStream &in, std::span<const Mat4> palette,
+                   const SkinnedStream &out) {
+    const kernels::Table &k = kernels::active();
+    Bounds bounds;
+    std::size_t count = in.x.size();
+
+    for(std::size_t first = 0; first < count; first += block_size) {
+        std::size_t lanes = std::min(block_size, count - first);
+
+        // Only the top three rows of each matrix matter for points.
+        float m[12][block_size] = {};
+
+        for(std::size_t k = 0; k < max_influences; ++k) {
+            for(std::size_t lane = 0; lane < lanes; ++lane) {
+                float weight = in.weights[k][first + lane];
+                const Mat4 &bone = palette[in.bones[k][first + lane]];
+
+                for(std::size_t e = 0; e < 12; ++e) {
+                    m[e][lane] += weight * bone._m[e / 4][e % 4];
+                }
+            }
+        }
+
+        const float *x = in.x.data() + first;
+        const float *y = in.y.data() + first;
+        const float *z = in.z.data() + first;
+
+        float *out_x = out.x.data() + first;
+        float *out_y = out.y.data() + first;
+        float *out_z = out.z.data() + first;
+
+        k.skin_linear(m, x, y, z, out_x, out_y, out_z, lanes);
+        k.bounds(out_x, out_y, out_z, lanes, bounds.min, bounds.max);
+    }
+
+    return bounds.box();
+}
+
+/*------------------------------------------------------------------------------
+    Every influence is flipped onto the same hemisphere as the first before
+    blending, so that q and -q (the same rotation) don't cancel out. The
+    blend is then normalized by the length of its real part and applied as
+
+        p' = p + 2v x (v x p + w p) + 2(w d - d_w v + v x d)
+
+    with (w, v) the real part and (d_w, d) the dual part.
+------------------------------------------------------------------------------*/
+AABBox skin_dual_quat(const SkinStream &in,
+                      std::span<const DualQuat> palette,
+                      const SkinnedStream &out) {
+    const kernels::Table &k = kernels::active();
+    Bounds bounds;
+    std::size_t count = in.x.size();
+
+    for(std::size_t first = 0; first < count; first += block_size) {
+        std::size_t lanes = std::min(block_size, count - first);
+
+        float q[8][block_size] = {};
+
+        for(std::size_t lane = 0; lane < lanes; ++lane) {
+            const Quat &pivot = palette[in.bones[0][first + lane]]._real;
+
+            for(std::size_t k = 0; k < max_influences; ++k) {
+                const DualQuat &bone = palette[in.bones[k][first + lane]];
+                float weight = in.weights[k][first + lane];
+                weight = std::copysign(weight, pivot.dot(bone._real));
+
+                q[0][lane] += weight * bone._real._w;
+                q[1][lane] += weight * bone._real._v._x;
+                q[2][lane] += weight * bone._real._v._y;
+                q[3][lane] += weight * bone._real._v._z;
+                q[4][lane] += weight * bone._dual._w;
+                q[5][lane] += weight * bone._dual._v._x;
+                q[6][lane] += weight * bone._dual._v._y;
+                q[7][lane] += weight * bone._dual._v._z;
+            }
+        }
+
+        const float *x = in.x.data() + first;
+        const float *y = in.y.data() + first;
+        const float *z = in.z.data() + first;
+
+        float *out_x = out.x.data() + first;
+        float *out_y = out.y.data() + first;
+        float *out_z = out.z.data() + first;
+
+        k.skin_dual_quat(q, x, y, z, out_x, out_y, out_z, lanes);
+        k.bounds(out_x, out_y, out_z, lanes, bounds.min, bounds.max);
+    }
+
+    return bounds.box();
+}
+
+} // namespace pdm
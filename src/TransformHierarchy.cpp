@@ -0,0 +1,205 @@
+#include "pdmath/TransformHierarchy.hpp"
+
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+
+namespace pdm {
+
+uint32_t TransformHierarchy::add_node(const uint32_t parent,
+                                      const Vec3 &translation,
+                                      const Quat &rotation,
+                                      const Vec3 &scale) {
+    auto node = static_cast<uint32_t>(_parents.size());
+
+    // A parent has to come first; anything else is added as a root.
+    uint32_t checked = parent < node ? parent : no_parent;
+    uint32_t depth   = checked == no_parent ? 0 : _depths[checked] + 1;
+
+    _parents.push_back(checked);
+    _translations.push_back(translation);
+    _rotations.push_back(rotation);
+    _scales.push_back(scale);
+    _worlds.push_back(Mat4::identity);
+    _dirty.push_back(0);
+    _depths.push_back(depth);
+    _sphere_slots.push_back(no_slot);
+    _box_slots.push_back(no_slot);
+
+    _first_child.push_back(no_node);
+    _next_sibling.push_back(checked == no_parent ? no_node
+                                                 : _first_child[checked]);
+    if(checked != no_parent) {
+        _first_child[checked] = node;
+    }
+
+    if(depth == _pending.size()) {
+        _pending.emplace_back();
+    }
+
+    mark_dirty(node);
+    return node;
+}
+
+void TransformHierarchy::set_local(const uint32_t node,
+                                   const Vec3 &translation,
+                                   const Quat &rotation, const Vec3 &scale) {
+    _translations[node] = translation;
+    _rotations[node]    = rotation;
+    _scales[node]       = scale;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_translation(const uint32_t node,
+                                         const Vec3 &translation) {
+    _translations[node] = translation;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_rotation(const uint32_t node,
+                                      const Quat &rotation) {
+    _rotations[node] = rotation;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::set_scale(const uint32_t node, const Vec3 &scale) {
+    _scales[node] = scale;
+    mark_dirty(node);
+}
+
+void TransformHierarchy::attach_sphere(const uint32_t node,
+                                       const Point3 &center,
+                                       const float radius) {
+    if(_sphere_slots[node] == no_slot) {
+        _sphere_slots[node] = static_cast<uint32_t>(_spheres.size());
+        _spheres.emplace_back(center, radius, _worlds[node]);
+        _sphere_centers.push_back(center);
+        _sphere_radii.push_back(radius);
+    }
+    else {
+        _sphere_centers[_sphere_slots[node]] = center;
+        _sphere_radii[_sphere_slots[node]]   = radius;
+    }
+
+    mark_dirty(node);
+}
+
+void TransformHierarchy::attach_box(const uint32_t node, const Point3 &min,
+                                    const Point3 &max) {
+    if(_box_slots[node] == no_slot) {
+        _box_slots[node] = static_cast<uint32_t>(_boxes.size());
+        _boxes.emplace_back(min, max, _worlds[node]);
+        _box_mins.push_back(min);
+        _box_maxs.push_back(max);
+    }
+    else {
+        _box_mins[_box_slots[node]] = min;
+        _box_maxs[_box_slots[node]] = max;
+    }
+
+    mark_dirty(node);
+}
+
+/*------------------------------------------------------------------------------
+    Changed nodes are sorted into their depth's pending list, then depths
+    are processed in order and each one is finished before the next starts,
+    so every parent's world matrix is final before its children read it.
+    The children of everything rebuilt at one depth are queued at the next,
+    which is how a change reaches its whole subtree; a child that was
+    changed itself is already queued, which the dirty flag tells apart.
+    Nothing outside the changed subtrees is looked at.
+------------------------------------------------------------------------------*/
+void TransformHierarchy::update() {
+    PDMATH_ZONE("TransformHierarchy::update");
+
+    for(uint32_t node : _dirty_nodes) {
+        _pending[_depths[node]].push_back(node);
+    }
+    _dirty_nodes.clear();
+    _rebuilt = 0;
+
+    for(std::size_t depth = 0; depth < _pending.size(); ++depth) {
+        std::vector<uint32_t> &level = _pending[depth];
+        if(level.empty()) {
+            continue;
+        }
+
+        // Narrow levels near the root aren't worth splitting.
+        if(_thread_count == 1 || level.size() < min_parallel_level) {
+            update_level(level, 0, level.size());
+        }
+        else {
+            // A thread count caps the split at that many pieces.
+            std::size_t grain = batch_size;
+            if(_thread_count > 1) {
+                grain = std::max(grain, (level.size() + _thread_count - 1) /
+                                        _thread_count);
+            }
+
+            _jobs->parallel_for(0, level.size(), grain,
+                                [&](std::size_t first, std::size_t last) {
+                update_level(level, first, last);
+            });
+        }
+
+        for(uint32_t node : level) {
+            for(uint32_t child = _first_child[node]; child != no_node;
+                child = _next_sibling[child]) {
+                if(!_dirty[child]) {
+                    _dirty[child] = 1;
+                    _pending[depth + 1].push_back(child);
+                }
+            }
+            _dirty[node] = 0;
+        }
+
+        _rebuilt += level.size();
+        level.clear();
+    }
+}
+
+void TransformHierarchy::update_level(const std::vector<uint32_t> &level,
+                                      const std::size_t first,
+                                      const std::size_t last) {
+    PDMATH_ZONE("TransformHierarchy::update_level");
+
+    for(std::size_t i = first; i < last; ++i) {
+        update_node(level[i]);
+    }
+}
+
+void TransformHierarchy::mark_dirty(const uint32_t node) {
+    if(!_dirty[node]) {
+        _dirty[node] = 1;
+        _dirty_nodes.push_back(node);
+    }
+}
+
+void TransformHierarchy::update_node(const uint32_t node) {
+    uint32_t parent = _parents[node];
+
+    Mat4 local = _rotations[node].to_mat4();
+    local.apply_scale(_scales[node]);
+    local.set_translation(_translations[node]);
+
+    _worlds[node] = parent == no_parent ? local : _worlds[parent] * local;
+
+    if(uint32_t slot = _sphere_slots[node]; slot != no_slot) {
+        _spheres[slot] = BSphere(_sphere_centers[slot], _sphere_radii[slot],
+                                 _worlds[node]);
+    }
+
+    if(uint32_t slot = _box_slots[node]; slot != no_slot) {
+        _boxes[slot] = OBBox(_box_mins[slot], _box_maxs[slot],
+                             _worlds[node]);
+    }
+}
+
+TransformHierarchy::TransformHierarchy(uint32_t thread_count,
+                                       JobSystem &jobs) :
+    _thread_count{thread_count},
+    _jobs{&jobs},
+    _rebuilt{0}
+{ }
+
+} // namespace pdm
@@ -0,0 +1,312 @@
+#include "pdmath/Vec3Stream.hpp"
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/profile.hpp"
+
+#include "kernels/kernels.hpp"
+
+#include <cassert>
+
+namespace pdm {
+
+// A stream's three columns are separate allocations, so loops that only
+// touch this stream's own columns are static functions taking them as
+// __restrict parameters (compilers only trust restrict on parameters) and
+// vectorize without a runtime overlap check. Loops that also read another
+// stream or a caller's span can't promise that, since it may be this
+// stream (a.cross(a)) or one of its columns, and the compiler versions
+// them instead. The heavier ones live in kernels/, built once per
+// instruction set tier.
+
+static void cross_columns(float *__restrict x, float *__restrict y,
+                          float *__restrict z, const std::size_t count,
+                          const Vec3 v) {
+    for(std::size_t i = 0; i < count; ++i) {
+        float cx = y[i] * v._z - z[i] * v._y;
+        float cy = z[i] * v._x - x[i] * v._z;
+        float cz = x[i] * v._y - y[i] * v._x;
+        x[i] = cx;
+        y[i] = cy;
+        z[i] = cz;
+    }
+}
+
+static void project_columns(float *__restrict x, float *__restrict y,
+                            float *__restrict z, const std::size_t count,
+                            const Vec3 v) {
+    float vx = v._x;
+    float vy = v._y;
+    float vz = v._z;
+    float inv_length_sq = 1.0f / (vx * vx + vy * vy + vz * vz);
+
+    for(std::size_t i = 0; i < count; ++i) {
+        float t = (x[i] * vx + y[i] * vy + z[i] * vz) * inv_length_sq;
+        x[i] = vx * t;
+        y[i] = vy * t;
+        z[i] = vz * t;
+    }
+}
+
+static void offset_columns(float *__restrict x, float *__restrict y,
+                           float *__restrict z, const std::size_t count,
+                           const Vec3 v) {
+    for(std::size_t i = 0; i < count; ++i) {
+        x[i] += v._x;
+        y[i] += v._y;
+        z[i] += v._z;
+    }
+}
+
+static void scale_columns(float *__restrict x, float *__restrict y,
+                          float *__restrict z, const std::size_t count,
+                          const float scalar) {
+    for(std::size_t i = 0; i < count; ++i) {
+        x[i] *= scalar;
+        y[i] *= scalar;
+        z[i] *= scalar;
+    }
+}
+
+Vec3 Vec3Stream::get(const std::size_t i) const {
+    return Vec3(_x[i], _y[i], _z[i]);
+}
+
+void Vec3Stream::set(const std::size_t i, const Vec3 &v) {
+    _x[i] = v._x;
+    _y[i] = v._y;
+    _z[i] = v._z;
+}
+
+void Vec3Stream::resize(const std::size_t count) {
+    _x.resize(count, 0.0f);
+    _y.resize(count, 0.0f);
+    _z.resize(count, 0.0f);
+}
+
+void Vec3Stream::push_back(const Vec3 &v) {
+    _x.push_back(v._x);
+    _y.push_back(v._y);
+    _z.push_back(v._z);
+}
+
+void Vec3Stream::clear() {
+    _x.clear();
+    _y.clear();
+    _z.clear();
+}
+
+void Vec3Stream::gather(std::span<const Vec3> v) {
+    resize(v.size());
+    float *x = _x.data();
+    float *y = _y.data();
+    float *z = _z.data();
+
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        x[i] = v[i]._x;
+        y[i] = v[i]._y;
+        z[i] = v[i]._z;
+    }
+}
+
+void Vec3Stream::gather(const Vec3View &v) {
+    resize(v.size());
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        set(i, v.get(i));
+    }
+}
+
+void Vec3Stream::scatter(std::span<Vec3> v) const {
+    const float *x = _x.data();
+    const float *y = _y.data();
+    const float *z = _z.data();
+
+    for(std::size_t i = 0; i < v.size() && i < size(); ++i) {
+        v[i]._x = x[i];
+        v[i]._y = y[i];
+        v[i]._z = z[i];
+    }
+}
+
+void Vec3Stream::scatter(Vec3View v) const {
+    for(std::size_t i = 0; i < v.size() && i < size(); ++i) {
+        v.set(i, get(i));
+    }
+}
+
+void Vec3Stream::dot(const Vec3 &v, std::span<float> out) const {
+    assert(out.size() >= size());
+
+    const float *x = _x.data();
+    const float *y = _y.data();
+    const float *z = _z.data();
+    float       *d = out.data();
+
+    for(std::size_t i = 0; i < size(); ++i) {
+        d[i] = x[i] * v._x + y[i] * v._y + z[i] * v._z;
+    }
+}
+
+void Vec3Stream::dot(const Vec3Stream &v, std::span<float> out) const {
+    assert(v.size() >= size());
+    assert(out.size() >= size());
+
+    kernels::active().dot(_x.data(), _y.data(), _z.data(),
+                          v._x.data(), v._y.data(), v._z.data(),
+                          out.data(), size());
+}
+
+void Vec3Stream::length(std::span<float> out) const {
+    assert(out.size() >= size());
+
+    kernels::active().length(_x.data(), _y.data(), _z.data(), out.data(),
+                             size());
+}
+
+void Vec3Stream::cross(const Vec3 &v) {
+    cross_columns(_x.data(), _y.data(), _z.data(), size(), v);
+}
+
+void Vec3Stream::cross(const Vec3Stream &v) {
+    assert(v.size() >= size());
+
+    float       *x  = _x.data();
+    float       *y  = _y.data();
+    float       *z  = _z.data();
+    const float *vx = v._x.data();
+    const float *vy = v._y.data();
+    const float *vz = v._z.data();
+
+    for(std::size_t i = 0; i < size(); ++i) {
+        float cx = y[i] * vz[i] - z[i] * vy[i];
+        float cy = z[i] * vx[i] - x[i] * vz[i];
+        float cz = x[i] * vy[i] - y[i] * vx[i];
+        x[i] = cx;
+        y[i] = cy;
+        z[i] = cz;
+    }
+}
+
+void Vec3Stream::normalize(const Accuracy accuracy) {
+    const kernels::Table &k = kernels::active();
+
+    switch(accuracy) {
+        case Accuracy::exact:
+            k.normalize_exact(_x.data(), _y.data(), _z.data(), size());
+            break;
+        case Accuracy::low:
+            k.normalize_low(_x.data(), _y.data(), _z.data(), size());
+            break;
+        case Accuracy::high:
+        default:
+            k.normalize_high(_x.data(), _y.data(), _z.data(), size());
+            break;
+    }
+}
+
+void Vec3Stream::project_onto(const Vec3 &v) {
+    project_columns(_x.data(), _y.data(), _z.data(), size(), v);
+}
+
+void Vec3Stream::project_onto(const Vec3Stream &v) {
+    assert(v.size() >= size());
+
+    float       *x  = _x.data();
+    float       *y  = _y.data();
+    float       *z  = _z.data();
+    const float *vx = v._x.data();
+    const float *vy = v._y.data();
+    const float *vz = v._z.data();
+
+    for(std::size_t i = 0; i < size(); ++i) {
+        float t = (x[i] * vx[i] + y[i] * vy[i] + z[i] * vz[i]) /
+                  (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+        x[i] = vx[i] * t;
+        y[i] = vy[i] * t;
+        z[i] = vz[i] * t;
+    }
+}
+
+void Vec3Stream::add_scaled(const Vec3Stream &v, const float scale) {
+    assert(v.size() >= size());
+
+    kernels::active().add_scaled(_x.data(), _y.data(), _z.data(),
+                                 v._x.data(), v._y.data(), v._z.data(),
+                                 scale, size());
+}
+
+/*------------------------------------------------------------------------------
+    All three transforms share one kernel: the upper 3x3 and an optional
+    translation, with the twelve matrix entries hoisted into registers.
+------------------------------------------------------------------------------*/
+
+void Vec3Stream::transform(const Mat3 &m) {
+    PDMATH_ZONE("Vec3Stream::transform");
+
+    const float rows[3][4] = {
+        {m._m[0][0], m._m[0][1], m._m[0][2], 0.0f},
+        {m._m[1][0], m._m[1][1], m._m[1][2], 0.0f},
+        {m._m[2][0], m._m[2][1], m._m[2][2], 0.0f}
+    };
+    kernels::active().transform(_x.data(), _y.data(), _z.data(), size(),
+                                rows);
+}
+
+void Vec3Stream::transform(const Mat4 &m) {
+    PDMATH_ZONE("Vec3Stream::transform");
+
+    const float rows[3][4] = {
+        {m._m[0][0], m._m[0][1], m._m[0][2], 0.0f},
+        {m._m[1][0], m._m[1][1], m._m[1][2], 0.0f},
+        {m._m[2][0], m._m[2][1], m._m[2][2], 0.0f}
+    };
+    kernels::active().transform(_x.data(), _y.data(), _z.data(), size(),
+                                rows);
+}
+
+void Vec3Stream::transform_points(const Mat4 &m) {
+    PDMATH_ZONE("Vec3Stream::transform_points");
+
+    const float rows[3][4] = {
+        {m._m[0][0], m._m[0][1], m._m[0][2], m._m[0][3]},
+        {m._m[1][0], m._m[1][1], m._m[1][2], m._m[1][3]},
+        {m._m[2][0], m._m[2][1], m._m[2][2], m._m[2][3]}
+    };
+    kernels::active().transform(_x.data(), _y.data(), _z.data(), size(),
+                                rows);
+}
+
+const Vec3Stream& Vec3Stream::operator+=(const Vec3Stream &v) {
+    add_scaled(v, 1.0f);
+    return *this;
+}
+
+const Vec3Stream& Vec3Stream::operator-=(const Vec3Stream &v) {
+    add_scaled(v, -1.0f);
+    return *this;
+}
+
+const Vec3Stream& Vec3Stream::operator+=(const Vec3 &v) {
+    offset_columns(_x.data(), _y.data(), _z.data(), size(), v);
+    return *this;
+}
+
+const Vec3Stream& Vec3Stream::operator*=(const float scalar) {
+    scale_columns(_x.data(), _y.data(), _z.data(), size(), scalar);
+    return *this;
+}
+
+Vec3Stream::Vec3Stream() noexcept :
+    _x{}, _y{}, _z{}
+{ }
+
+Vec3Stream::Vec3Stream(const std::size_t count) :
+    _x(count, 0.0f), _y(count, 0.0f), _z(count, 0.0f)
+{ }
+
+Vec3Stream::Vec3Stream(std::span<const Vec3> v) :
+    Vec3Stream()
+{
+    gather(v);
+}
+
+} // namespace pdm
@@ -0,0 +1,24 @@
+#include "pdmath/Vector.hpp"
+
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Vector4.hpp"
+
+namespace pdm {
+
+Vec3f to_vec(const Vec3 &v) {
+    return Vec3f(v._x, v._y, v._z);
+}
+
+Vec4f to_vec(const Vec4 &v) {
+    return Vec4f(v._x, v._y, v._z, v._w);
+}
+
+Vec3 to_vec3(const Vec3f &v) {
+    return Vec3(v._e[0], v._e[1], v._e[2]);
+}
+
+Vec4 to_vec4(const Vec4f &v) {
+    return Vec4(v._e[0], v._e[1], v._e[2], v._e[3]);
+}
+
+} // namespace pdm
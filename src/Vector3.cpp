@@ -35,6 +35,29 @@ Vec3 Vec3::normalized() const {
                 _z / _length);
 }
 
+// normalized() keeps its exact divide; this one lets a hot loop trade the
+// last few bits for a reciprocal square root estimate.
+Vec3 Vec3::normalized(const Accuracy accuracy) const {
+    float length_sq = dot(*this);
+    float inv_length;
+
+    switch(accuracy) {
+        case Accuracy::exact:
+            return normalized();
+        case Accuracy::low:
+            inv_length = fastmath::rsqrt<Accuracy::low>(length_sq);
+            break;
+        case Accuracy::high:
+        default:
+            inv_length = fastmath::rsqrt<Accuracy::high>(length_sq);
+            break;
+    }
+
+    return Vec3(_x * inv_length,
+                _y * inv_length,
+                _z * inv_length);
+}
+
 Vec3 Vec3::cross(const Vec3 &v) const {
     return Vec3(this->_y * v._z - this->_z * v._y,
                 this->_z * v._x - this->_x * v._z,
@@ -63,6 +86,31 @@ bool Vec3::is_perpendicular(const Vec3 &v) const {
     return dot(v) == 0.0f;
 }
 
+template<Accuracy A>
+static void normalize_all(std::span<Vec3> v) {
+    for(Vec3 &u : v) {
+        float inv_length = fastmath::rsqrt<A>(u.dot(u));
+        u._x *= inv_length;
+        u._y *= inv_length;
+        u._z *= inv_length;
+    }
+}
+
+void Vec3::normalize(std::span<Vec3> v, const Accuracy accuracy) {
+    switch(accuracy) {
+        case Accuracy::exact:
+            normalize_all<Accuracy::exact>(v);
+            break;
+        case Accuracy::low:
+            normalize_all<Accuracy::low>(v);
+            break;
+        case Accuracy::high:
+        default:
+            normalize_all<Accuracy::high>(v);
+            break;
+    }
+}
+
 Vec3::Vec3() noexcept :
     _x{0.0f}, _y{0.0f}, _z{0.0f}
 { }
@@ -4,18 +4,40 @@
 #include "pdmath/Point3.hpp"
 #include "pdmath/Point4.hpp"
 #include "pdmath/Vector3.hpp"
+#include "pdmath/Vector.hpp"
 
+#include <bit>
 #include <iomanip>
 #include <cmath>
 
 namespace pdm {
+// Vec4 and Point4 have Vec4f's layout, so the arithmetic below is the
+// generic kernels in Vector.hpp. Vec4's own operators treat it as a
+// direction: x, y and z take part and w comes back zero.
+static inline Vec4f core(const Vec4 &v)   { return std::bit_cast<Vec4f>(v); }
+static inline Vec4f core(const Point4 &p) { return std::bit_cast<Vec4f>(p); }
+
+static inline Vec4f core(const Vec3 &v) {
+    return Vec4f(v._x, v._y, v._z, 0.0f);
+}
+
+static inline Vec4f core(const Point3 &p) {
+    return Vec4f(p._x, p._y, p._z, 0.0f);
+}
+
+static inline Vec3f core3(const Vec4 &v) {
+    return Vec3f(v._x, v._y, v._z);
+}
+
+static inline Vec4 direction(const Vec4f &v) {
+    return Vec4(v[0], v[1], v[2]);
+}
+
 const Vec4 Vec4::zero = Vec4(0.0f, 0.0f, 0.0f, 0.0f);
 const Vec4 Vec4::one  = Vec4(1.0f, 1.0f, 1.0f, 0.0f);
 
 float Vec4::dot(const Vec4 &v) const {
-    return this->_x * v._x +
-           this->_y * v._y +
-           this->_z * v._z;
+    return core3(*this).dot(core3(v));
 }
 
 Vec4 Vec4::normalized() const {
@@ -24,15 +46,12 @@ Vec4 Vec4::normalized() const {
     if(fabsf(_length - 1.0f) < float_epsilon) {
         return Vec4(*this);
     }
-    return Vec4(_x / _length,
-                _y / _length,
-                _z / _length);
+    return direction(core(*this) / _length);
 }
 
 Vec4 Vec4::cross(const Vec4 &v) const {
-    return Vec4(this->_y * v._z - this->_z * v._y,
-                this->_z * v._x - this->_x * v._z,
-                this->_x * v._y - this->_y * v._x);
+    Vec3f c = core3(*this).cross(core3(v));
+    return Vec4(c[0], c[1], c[2]);
 }
 
 Vec4 Vec4::project_onto(const Vec4 &v) const {
@@ -57,87 +76,59 @@ bool Vec4::operator==(const Vec4 &p) const {
            w_diff < float_epsilon;
 }
 Vec4 operator+(const Vec4 &v, const Vec3 &w) {
-    return Vec4(v._x + w._x,
-                v._y + w._y,
-                v._z + w._z);
+    return direction(core(v) + core(w));
 }
 
 Vec4 operator-(const Vec4 &v, const Vec3 &w) {
-    return Vec4(v._x - w._x,
-                v._y - w._y,
-                v._z - w._z);
+    return direction(core(v) - core(w));
 }
 
 Vec4 operator+(const Vec4 &v, const Vec4 &w) {
-    return Vec4(v._x + w._x,
-                v._y + w._y,
-                v._z + w._z);
+    return direction(core(v) + core(w));
 }
 
 Vec4 operator-(const Vec4 &v, const Vec4 &w) {
-    return Vec4(v._x - w._x,
-                v._y - w._y,
-                v._z - w._z);
+    return direction(core(v) - core(w));
 }
 
 Vec4 operator+(const Vec4 &v, const Point3 &p) {
-    return Vec4(v._x + p._x,
-                v._y + p._y,
-                v._z + p._z);
+    return direction(core(v) + core(p));
 }
 
 Vec4 operator-(const Vec4 &v, const Point3 &p) {
-    return Vec4(v._x - p._x,
-                v._y - p._y,
-                v._z - p._z);
+    return direction(core(v) - core(p));
 }
 
 Vec4 operator+(const Vec4 &v, const Point4 &p) {
-    return Vec4(v._x + p._x,
-                v._y + p._y,
-                v._z + p._z);
+    return direction(core(v) + core(p));
 }
 
 Vec4 operator-(const Vec4 &v, const Point4 &p) {
-    return Vec4(v._x - p._x,
-                v._y - p._y,
-                v._z - p._z);
+    return direction(core(v) - core(p));
 }
 
 Vec4 operator-(const Point4 &p, const Point4 &t) {
-    return Vec4(p._x - t._x,
-                p._y - t._y,
-                p._z - t._z);
+    return direction(core(p) - core(t));
 }
 
 Vec4 operator-(const Point4 &p, const Point3 &t) {
-    return Vec4(p._x - t._x,
-                p._y - t._y,
-                p._z - t._z);
+    return direction(core(p) - core(t));
 }
 
 Vec4 operator+(const Vec4 &v, const float scalar) {
-    return Vec4(v._x + scalar,
-                v._y + scalar,
-                v._z + scalar);
+    return direction(core(v) + Vec4f(scalar));
 }
 
 Vec4 operator-(const Vec4 &v, const float scalar) {
-    return Vec4(v._x - scalar,
-                v._y - scalar,
-                v._z - scalar);
+    return direction(core(v) - Vec4f(scalar));
 }
 
 Vec4 operator*(const Vec4 &v, const float scalar) {
-    return Vec4(v._x * scalar,
-                v._y * scalar,
-                v._z * scalar);
+    return direction(core(v) * scalar);
 }
 
 Vec4 operator/(const Vec4 &v, const float scalar) {
-    return Vec4(v._x / scalar,
-                v._y / scalar,
-                v._z / scalar);
+    return direction(core(v) / scalar);
 }
 
 Vec4 operator+(const float scalar, const Vec4 &v) {
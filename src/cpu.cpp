@@ -0,0 +1,134 @@
+#include "pdmath/cpu.hpp"
+
+#include "kernels/kernels.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(_MSC_VER) && defined(PDMATH_KERNELS_X86)
+#include <intrin.h>
+#endif
+
+namespace pdm {
+
+#if defined(_MSC_VER) && defined(PDMATH_KERNELS_X86)
+// CPUID feature bits plus the XCR0 check that the OS saves the wider
+// registers; GCC and Clang do the same inside __builtin_cpu_supports.
+static Isa detect() {
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse42   = (info[2] & (1 << 20)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx     = (info[2] & (1 << 28)) != 0;
+
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool ymm_saved = (xcr0 & 0x06) == 0x06;
+    bool zmm_saved = (xcr0 & 0xE6) == 0xE6;
+
+    bool avx2    = false;
+    bool avx512f = false;
+    if(max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2    = (info[1] & (1 << 5))  != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+    }
+
+    if(avx512f && zmm_saved) {
+        return Isa::avx512;
+    }
+    if(avx && avx2 && ymm_saved) {
+        return Isa::avx2;
+    }
+    return sse42 ? Isa::sse42 : Isa::scalar;
+}
+#elif defined(PDMATH_KERNELS_X86)
+static Isa detect() {
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) {
+        return Isa::avx512;
+    }
+    if(__builtin_cpu_supports("avx2")) {
+        return Isa::avx2;
+    }
+    if(__builtin_cpu_supports("sse4.2")) {
+        return Isa::sse42;
+    }
+    return Isa::scalar;
+}
+#else
+static Isa detect() {
+    return Isa::scalar;
+}
+#endif
+
+// PDMATH_ISA as a tier, or the given fallback if it's unset or unknown.
+static Isa from_environment(const Isa fallback) {
+    const char *value = std::getenv("PDMATH_ISA");
+    if(!value) {
+        return fallback;
+    }
+
+    for(Isa isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if(std::strcmp(value, cpu::name(isa)) == 0) {
+            return isa;
+        }
+    }
+    return std::strcmp(value, "sse42") == 0 ? Isa::sse42 : fallback;
+}
+
+namespace cpu {
+
+Isa supported() {
+    static const Isa isa = detect();
+    return isa;
+}
+
+Isa selected() {
+    static const Isa isa = [] {
+        Isa wanted = from_environment(supported());
+        return wanted < supported() ? wanted : supported();
+    }();
+    return isa;
+}
+
+const char* name(const Isa isa) {
+    switch(isa) {
+        case Isa::sse42:  return "sse4.2";
+        case Isa::avx2:   return "avx2";
+        case Isa::avx512: return "avx512";
+        case Isa::scalar:
+        default:          return "scalar";
+    }
+}
+
+} // namespace cpu
+
+namespace kernels {
+
+const Table& table(const Isa isa) {
+#if defined(PDMATH_KERNELS_X86)
+    switch(isa) {
+        case Isa::avx512: return avx512::table;
+        case Isa::avx2:   return avx2::table;
+        case Isa::sse42:  return sse42::table;
+        case Isa::scalar:
+        default:          return scalar::table;
+    }
+#else
+    (void)isa;
+    return scalar::table;
+#endif
+}
+
+const Table& active() {
+    static const Table &t = table(cpu::selected());
+    return t;
+}
+
+} // namespace kernels
+
+} // namespace pdm
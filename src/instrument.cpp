@@ -0,0 +1,119 @@
+#include "pdmath/instrument.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace pdm::instrument {
+
+static constexpr const char *counter_names[counter_count] = {
+    "OBBox::collides",
+    "Mat4::inverted",
+    "BSphere()"
+};
+
+const char* name(const Counter c) {
+    auto i = static_cast<std::size_t>(c);
+    return i < counter_count ? counter_names[i] : "unknown";
+}
+
+Snapshot Snapshot::operator-(const Snapshot &rhs) const {
+    Snapshot out;
+    for(std::size_t i = 0; i < counter_count; ++i) {
+        out.stats[i].calls = stats[i].calls - rhs.stats[i].calls;
+        out.stats[i].ticks = stats[i].ticks - rhs.stats[i].ticks;
+    }
+    return out;
+}
+
+std::ostream& operator<<(std::ostream &os, const Snapshot &s) {
+    for(std::size_t i = 0; i < counter_count; ++i) {
+        os << counter_names[i] << ": " << s.stats[i].calls << " calls";
+        if(s.stats[i].ticks) {
+            os << ", " << s.stats[i].ticks_per_call() << " ticks/call";
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+#if defined(PDMATH_INSTRUMENT)
+namespace detail {
+
+// Live threads' counters, plus what exited threads left behind so totals
+// never go backwards.
+struct Registry {
+    std::mutex                    mutex;
+    std::vector<ThreadCounters *> threads;
+    Snapshot                      retired;
+    Snapshot                      last_frame;
+};
+
+static Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+static void add_to(Snapshot &s, const ThreadCounters &t) {
+    for(std::size_t i = 0; i < counter_count; ++i) {
+        s.stats[i].calls += t.calls[i].load(std::memory_order_relaxed);
+        s.stats[i].ticks += t.ticks[i].load(std::memory_order_relaxed);
+    }
+}
+
+static Snapshot total(Registry &r) {
+    Snapshot s = r.retired;
+    for(const ThreadCounters *t : r.threads) {
+        add_to(s, *t);
+    }
+    return s;
+}
+
+ThreadCounters::ThreadCounters() {
+    Registry &r = registry();
+    std::lock_guard lock(r.mutex);
+    r.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    Registry &r = registry();
+    std::lock_guard lock(r.mutex);
+    add_to(r.retired, *this);
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+}
+
+thread_local ThreadCounters local_counters;
+std::atomic<bool> timing_on{false};
+
+} // namespace detail
+
+Snapshot snapshot() {
+    detail::Registry &r = detail::registry();
+    std::lock_guard lock(r.mutex);
+    return detail::total(r);
+}
+
+Snapshot frame() {
+    detail::Registry &r = detail::registry();
+    std::lock_guard lock(r.mutex);
+    Snapshot now   = detail::total(r);
+    Snapshot delta = now - r.last_frame;
+    r.last_frame   = now;
+    return delta;
+}
+
+void set_timing(const bool on) {
+    detail::timing_on.store(on, std::memory_order_relaxed);
+}
+
+bool timing() {
+    return detail::timing_on.load(std::memory_order_relaxed);
+}
+#else
+Snapshot snapshot()         { return {};    }
+Snapshot frame()            { return {};    }
+void     set_timing(bool)   {               }
+bool     timing()           { return false; }
+#endif
+
+} // namespace pdm::instrument
@@ -0,0 +1,12 @@
+#include "kernels.hpp"
+
+#include "pdmath/fastmath.hpp"
+
+#include <cmath>
+
+#if defined(PDMATH_KERNELS_X86)
+#define PDMATH_KERNEL_NS  avx512
+#define PDMATH_KERNEL_ISA Isa::avx512
+#define PDMATH_KERNEL_TARGET "avx512f"
+#include "kernels.inl"
+#endif
@@ -0,0 +1,82 @@
+#ifndef PDMATH_KERNELS_HPP
+#define PDMATH_KERNELS_HPP
+
+#include "pdmath/cpu.hpp"
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)
+#define PDMATH_KERNELS_X86 1
+#endif
+
+namespace pdm::kernels {
+
+// Lanes per skinning block: one AVX-512 register of floats.
+static constexpr std::size_t skin_block = 16;
+
+/*------------------------------------------------------------------------------
+    The loops behind Vec3Stream's bulk operations, skinning and
+    Mat3::populate_rotations, built once per Isa tier from kernels.inl.
+    Columns are separate x, y and z arrays of count floats; in-place kernels
+    overwrite them. The skinning kernels take one block of up to skin_block
+    lanes, with each lane's blended transform already gathered into m or q.
+------------------------------------------------------------------------------*/
+struct Table {
+    Isa isa;
+
+    void (*transform)(float *x, float *y, float *z, std::size_t count,
+                      const float (&m)[3][4]);
+
+    void (*normalize_exact)(float *x, float *y, float *z, std::size_t count);
+    void (*normalize_high)(float *x, float *y, float *z, std::size_t count);
+    void (*normalize_low)(float *x, float *y, float *z, std::size_t count);
+
+    void (*dot)(const float *x, const float *y, const float *z,
+                const float *vx, const float *vy, const float *vz,
+                float *out, std::size_t count);
+
+    void (*length)(const float *x, const float *y, const float *z,
+                   float *out, std::size_t count);
+
+    void (*add_scaled)(float *x, float *y, float *z,
+                       const float *vx, const float *vy, const float *vz,
+                       float scale, std::size_t count);
+
+    void (*skin_linear)(const float (*m)[skin_block],
+                        const float *x, const float *y, const float *z,
+                        float *out_x, float *out_y, float *out_z,
+                        std::size_t count);
+
+    void (*skin_dual_quat)(const float (*q)[skin_block],
+                           const float *x, const float *y, const float *z,
+                           float *out_x, float *out_y, float *out_z,
+                           std::size_t count);
+
+    // Widens min and max to take in count points.
+    void (*bounds)(const float *x, const float *y, const float *z,
+                   std::size_t count, float (&min)[3], float (&max)[3]);
+
+    void (*sincos_exact)(const float *x, float *s, float *c,
+                         std::size_t count);
+    void (*sincos_high)(const float *x, float *s, float *c, std::size_t count);
+    void (*sincos_low)(const float *x, float *s, float *c, std::size_t count);
+};
+
+namespace scalar { extern const Table table; }
+
+#if defined(PDMATH_KERNELS_X86)
+namespace sse42  { extern const Table table; }
+namespace avx2   { extern const Table table; }
+namespace avx512 { extern const Table table; }
+#endif
+
+// The table for cpu::selected(), chosen on first use.
+const Table& active();
+
+// The table for a given tier, or the widest below it that was built.
+const Table& table(const Isa isa);
+
+} // namespace pdm::kernels
+
+#endif // PDMATH_KERNELS_HPP
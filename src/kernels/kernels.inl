@@ -0,0 +1,212 @@
+// Included once per tier, after kernels.hpp, fastmath.hpp and <cmath>,
+// with PDMATH_KERNEL_NS naming the tier's namespace and, for the wider
+// tiers, PDMATH_KERNEL_TARGET giving its target string.
+//
+// The target is applied with a pragma instead of -m flags on the file so
+// that only the functions below are built for the wider instruction set.
+// Inline functions from the headers (fastmath, <cmath>) keep the baseline
+// target; any out-of-line copy the linker picks is then safe to call from
+// every tier. Without it, a -mavx512f copy of something like std::sqrt
+// could end up shared with the scalar path.
+//
+// MSVC has no per-function target, so CMake gives its wider tiers /arch
+// for the whole file, and that does reach the header inlines: an
+// out-of-line fastmath::rsqrt or fastmath::sincos emitted there is AVX
+// code, and the linker may keep that copy for every caller. Nothing here
+// is meant to stay out of line (they're small and called from loops), but
+// that's the optimizer's call, not a guarantee. So the loops below use
+// nothing from the headers beyond those two and <cmath>, and write min and
+// max out rather than calling std::min and std::max.
+
+#define PDMATH_KERNEL_PRAGMA_(x) _Pragma(#x)
+#define PDMATH_KERNEL_PRAGMA(x)  PDMATH_KERNEL_PRAGMA_(x)
+
+#if defined(PDMATH_KERNEL_TARGET)
+#if defined(__clang__)
+PDMATH_KERNEL_PRAGMA(clang attribute push(
+    __attribute__((target(PDMATH_KERNEL_TARGET))), apply_to = function))
+#elif defined(__GNUC__)
+#pragma GCC push_options
+PDMATH_KERNEL_PRAGMA(GCC target(PDMATH_KERNEL_TARGET))
+#pragma GCC optimize("fp-contract=off")
+#endif
+#endif
+
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+
+namespace pdm::kernels::PDMATH_KERNEL_NS {
+
+// Loops go through the raw column pointers and nothing else, so each one
+// is a straight line the compiler can vectorize to the tier's width.
+// AVX-512 brings FMA with it, so contraction is turned off above to keep
+// every tier rounding exactly like the scalar code. length and normalize
+// only become packed square roots because the build gives these files
+// -fno-math-errno (a pragma can't: GCC then won't inline std::sqrt).
+
+static void transform(float *x, float *y, float *z, const std::size_t count,
+                      const float (&m)[3][4]) {
+    for(std::size_t i = 0; i < count; ++i) {
+        float tx = m[0][0] * x[i] + m[0][1] * y[i] + m[0][2] * z[i] + m[0][3];
+        float ty = m[1][0] * x[i] + m[1][1] * y[i] + m[1][2] * z[i] + m[1][3];
+        float tz = m[2][0] * x[i] + m[2][1] * y[i] + m[2][2] * z[i] + m[2][3];
+        x[i] = tx;
+        y[i] = ty;
+        z[i] = tz;
+    }
+}
+
+template<Accuracy A>
+static void normalize(float *x, float *y, float *z, const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        float inv_length = fastmath::rsqrt<A>(x[i] * x[i] +
+                                              y[i] * y[i] +
+                                              z[i] * z[i]);
+        x[i] *= inv_length;
+        y[i] *= inv_length;
+        z[i] *= inv_length;
+    }
+}
+
+static void dot(const float *x, const float *y, const float *z,
+                const float *vx, const float *vy, const float *vz,
+                float *out, const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        out[i] = x[i] * vx[i] + y[i] * vy[i] + z[i] * vz[i];
+    }
+}
+
+static void length(const float *x, const float *y, const float *z,
+                   float *out, const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+    }
+}
+
+static void add_scaled(float *x, float *y, float *z,
+                       const float *vx, const float *vy, const float *vz,
+                       const float scale, const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        x[i] += vx[i] * scale;
+        y[i] += vy[i] * scale;
+        z[i] += vz[i] * scale;
+    }
+}
+
+// m holds the top three rows of each lane's blended matrix, one row
+// element per array.
+static void skin_linear(const float (*m)[skin_block],
+                        const float *x, const float *y, const float *z,
+                        float *out_x, float *out_y, float *out_z,
+                        const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        out_x[i] = m[0][i] * x[i] + m[1][i] * y[i] +
+                   m[2][i] * z[i] + m[3][i];
+        out_y[i] = m[4][i] * x[i] + m[5][i] * y[i] +
+                   m[6][i] * z[i] + m[7][i];
+        out_z[i] = m[8][i] * x[i] + m[9][i] * y[i] +
+                   m[10][i] * z[i] + m[11][i];
+    }
+}
+
+// q holds each lane's blended dual quaternion, real w, x, y, z then dual
+// w, x, y, z. See skin_dual_quat in Skinning.cpp for the formula.
+static void skin_dual_quat(const float (*q)[skin_block],
+                           const float *x, const float *y, const float *z,
+                           float *out_x, float *out_y, float *out_z,
+                           const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        float inv_length = 1.0f / std::sqrt(q[0][i] * q[0][i] +
+                                            q[1][i] * q[1][i] +
+                                            q[2][i] * q[2][i] +
+                                            q[3][i] * q[3][i]);
+
+        float w  = q[0][i] * inv_length;
+        float vx = q[1][i] * inv_length;
+        float vy = q[2][i] * inv_length;
+        float vz = q[3][i] * inv_length;
+        float dw = q[4][i] * inv_length;
+        float dx = q[5][i] * inv_length;
+        float dy = q[6][i] * inv_length;
+        float dz = q[7][i] * inv_length;
+
+        // a = v x p + w p
+        float ax = vy * z[i] - vz * y[i] + w * x[i];
+        float ay = vz * x[i] - vx * z[i] + w * y[i];
+        float az = vx * y[i] - vy * x[i] + w * z[i];
+
+        // t = w d - d_w v + v x d
+        float tx = w * dx - dw * vx + (vy * dz - vz * dy);
+        float ty = w * dy - dw * vy + (vz * dx - vx * dz);
+        float tz = w * dz - dw * vz + (vx * dy - vy * dx);
+
+        out_x[i] = x[i] + 2.0f * (vy * az - vz * ay + tx);
+        out_y[i] = y[i] + 2.0f * (vz * ax - vx * az + ty);
+        out_z[i] = z[i] + 2.0f * (vx * ay - vy * ax + tz);
+    }
+}
+
+static void bounds(const float *x, const float *y, const float *z,
+                   const std::size_t count, float (&min)[3], float (&max)[3]) {
+    float min_x = min[0];
+    float min_y = min[1];
+    float min_z = min[2];
+    float max_x = max[0];
+    float max_y = max[1];
+    float max_z = max[2];
+
+    for(std::size_t i = 0; i < count; ++i) {
+        min_x = x[i] < min_x ? x[i] : min_x;
+        min_y = y[i] < min_y ? y[i] : min_y;
+        min_z = z[i] < min_z ? z[i] : min_z;
+        max_x = max_x < x[i] ? x[i] : max_x;
+        max_y = max_y < y[i] ? y[i] : max_y;
+        max_z = max_z < z[i] ? z[i] : max_z;
+    }
+
+    min[0] = min_x;
+    min[1] = min_y;
+    min[2] = min_z;
+    max[0] = max_x;
+    max[1] = max_y;
+    max[2] = max_z;
+}
+
+template<Accuracy A>
+static void sincos(const float *x, float *s, float *c,
+                   const std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        fastmath::sincos<A>(x[i], s[i], c[i]);
+    }
+}
+
+const Table table = {
+    PDMATH_KERNEL_ISA,
+    transform,
+    normalize<Accuracy::exact>,
+    normalize<Accuracy::high>,
+    normalize<Accuracy::low>,
+    dot,
+    length,
+    add_scaled,
+    skin_linear,
+    skin_dual_quat,
+    bounds,
+    sincos<Accuracy::exact>,
+    sincos<Accuracy::high>,
+    sincos<Accuracy::low>
+};
+
+} // namespace pdm::kernels::PDMATH_KERNEL_NS
+
+#if defined(PDMATH_KERNEL_TARGET)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+#undef PDMATH_KERNEL_PRAGMA
+#undef PDMATH_KERNEL_PRAGMA_
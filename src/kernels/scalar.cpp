@@ -0,0 +1,9 @@
+#include "kernels.hpp"
+
+#include "pdmath/fastmath.hpp"
+
+#include <cmath>
+
+#define PDMATH_KERNEL_NS  scalar
+#define PDMATH_KERNEL_ISA Isa::scalar
+#include "kernels.inl"
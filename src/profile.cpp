@@ -0,0 +1,198 @@
+#include "pdmath/profile.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(PDMATH_PROFILE)
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace pdm::profile {
+
+#if defined(PDMATH_PROFILE)
+namespace detail {
+
+using clock = std::chrono::steady_clock;
+
+// Every buffer ever attached. Exited threads' buffers stay until clear()
+// so their zones still make it into the next export.
+struct Registry {
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    uint32_t                                   next_id = 1;
+
+    // Reference point for turning ticks into microseconds.
+    uint64_t          first_tick = ticks();
+    clock::time_point first_time = clock::now();
+};
+
+static Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// Marks the thread's buffer as retired when the thread exits.
+struct Detach {
+    ThreadBuffer *buffer = nullptr;
+
+    ~Detach() {
+        if(buffer) {
+            Registry &r = registry();
+            std::lock_guard lock(r.mutex);
+            buffer->live = false;
+            local_buffer = nullptr;
+        }
+    }
+};
+
+thread_local ThreadBuffer   *local_buffer = nullptr;
+static thread_local Detach   detach;
+std::atomic<bool>            recording_on{true};
+
+ThreadBuffer* attach_thread() {
+    Registry &r = registry();
+    std::lock_guard lock(r.mutex);
+
+    r.buffers.push_back(std::make_unique<ThreadBuffer>());
+    ThreadBuffer *b = r.buffers.back().get();
+    b->id = r.next_id++;
+
+    local_buffer  = b;
+    detach.buffer = b;
+    return b;
+}
+
+static double ticks_per_microsecond(const Registry &r) {
+#if defined(PDMATH_TICKS_RDTSC)
+    // Measure against steady_clock over everything since the registry
+    // was made, waiting out a short interval so the ratio is usable.
+    while(clock::now() - r.first_time < std::chrono::milliseconds(10)) { }
+
+    std::chrono::duration<double, std::micro> elapsed =
+        clock::now() - r.first_time;
+    return static_cast<double>(ticks() - r.first_tick) / elapsed.count();
+#else
+    (void)r;
+    return 1000.0;  // ticks are steady_clock nanoseconds
+#endif
+}
+
+static void write_name(std::ostream &os, const char *name) {
+    os << '"';
+    for(const char *c = name; *c; ++c) {
+        if(*c == '"' || *c == '\\') {
+            os << '\\';
+        }
+        os << *c;
+    }
+    os << '"';
+}
+
+} // namespace detail
+
+void set_recording(const bool on) {
+    detail::recording_on.store(on, std::memory_order_relaxed);
+}
+
+bool recording() {
+    return detail::recording_on.load(std::memory_order_relaxed);
+}
+
+void set_thread_name(const char *name) {
+    detail::ThreadBuffer *b = detail::local_buffer;
+    if(!b) {
+        b = detail::attach_thread();
+    }
+    b->name = name;
+}
+
+void clear() {
+    detail::Registry &r = detail::registry();
+    std::lock_guard lock(r.mutex);
+
+    std::erase_if(r.buffers, [](const auto &b) { return !b->live; });
+    for(auto &b : r.buffers) {
+        b->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+void write_chrome_trace(std::ostream &os) {
+    using detail::events_per_thread;
+
+    detail::Registry &r = detail::registry();
+    std::lock_guard lock(r.mutex);
+
+    double   per_us = detail::ticks_per_microsecond(r);
+    uint64_t origin = ~uint64_t(0);
+
+    // Timestamps run to seconds in microseconds; keep sub-us digits.
+    std::streamsize precision = os.precision(12);
+
+    // Recorded range of each ring, oldest event first.
+    auto range = [](const detail::ThreadBuffer &b) {
+        uint64_t head  = b.head.load(std::memory_order_acquire);
+        uint64_t count = std::min<uint64_t>(head, events_per_thread);
+        return std::make_pair(head - count, head);
+    };
+
+    for(const auto &b : r.buffers) {
+        auto [first, last] = range(*b);
+        for(uint64_t i = first; i < last; ++i) {
+            origin = std::min(origin, b->events[i % events_per_thread].start);
+        }
+    }
+
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    const char *separator = "\n";
+
+    for(const auto &b : r.buffers) {
+        if(b->name) {
+            os << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+               << "\"pid\": 1, \"tid\": " << b->id << ", \"args\": {\"name\": ";
+            detail::write_name(os, b->name);
+            os << "}}";
+            separator = ",\n";
+        }
+
+        auto [first, last] = range(*b);
+        for(uint64_t i = first; i < last; ++i) {
+            const detail::Event &e = b->events[i % events_per_thread];
+            double ts  = static_cast<double>(e.start - origin) / per_us;
+            double dur = static_cast<double>(e.end - e.start) / per_us;
+
+            os << separator << "{\"name\": ";
+            detail::write_name(os, e.name);
+            os << ", \"cat\": \"pdmath\", \"ph\": \"X\", \"pid\": 1, "
+               << "\"tid\": " << b->id << ", \"ts\": " << ts
+               << ", \"dur\": " << dur << "}";
+            separator = ",\n";
+        }
+    }
+
+    os << "\n]}\n";
+    os.precision(precision);
+}
+#else
+void set_recording(bool)           {               }
+bool recording()                   { return false; }
+void set_thread_name(const char *) {               }
+void clear()                       {               }
+
+void write_chrome_trace(std::ostream &os) {
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": []}\n";
+}
+#endif
+
+bool write_chrome_trace(const std::string &path) {
+    std::ofstream os(path);
+    if(!os) {
+        return false;
+    }
+    write_chrome_trace(os);
+    return static_cast<bool>(os);
+}
+
+} // namespace pdm::profile
@@ -0,0 +1,196 @@
+#include "pdmath/Animation.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+static AnimationClip make_clip() {
+    AnimationClip clip;
+
+    std::array<float, 3> times{0.0f, 1.0f, 3.0f};
+    std::array<Vec3, 3> translations{Vec3(0.0f, 0.0f, 0.0f),
+                                     Vec3(2.0f, 4.0f, -2.0f),
+                                     Vec3(2.0f, 0.0f, 6.0f)};
+    std::array<Quat, 3> rotations{
+        Quat::identity,
+        Quat(std::numbers::pi_v<float> / 2.0f, Vec3(0.0f, 1.0f, 0.0f)),
+        Quat(std::numbers::pi_v<float>, Vec3(0.0f, 1.0f, 0.0f))};
+    std::array<Vec3, 3> scales{Vec3(1.0f, 1.0f, 1.0f),
+                               Vec3(2.0f, 2.0f, 2.0f),
+                               Vec3(1.0f, 3.0f, 1.0f)};
+
+    clip.add_track(times, translations, rotations, scales);
+
+    std::array<float, 1> still_time{0.0f};
+    std::array<Vec3, 1> still_translation{Vec3(5.0f, 5.0f, 5.0f)};
+    std::array<Quat, 1> still_rotation{Quat::identity};
+    std::array<Vec3, 1> still_scale{Vec3(1.0f, 1.0f, 1.0f)};
+
+    clip.add_track(still_time, still_translation, still_rotation,
+                   still_scale);
+
+    return clip;
+}
+
+TEST_CASE("Animation clips pack tracks together", "[animation]") {
+    AnimationClip clip = make_clip();
+
+    REQUIRE(clip.track_count() == 2);
+    REQUIRE(clip.key_count() == 4);
+    REQUIRE(clip.duration() == Catch::Approx(3.0f));
+}
+
+TEST_CASE("Animation samplers interpolate keys", "[animation]") {
+    AnimationClip clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    std::vector<Vec3> translations(2);
+    std::vector<Quat> rotations(2);
+    std::vector<Vec3> scales(2);
+
+    sampler.sample(1.0f, translations, rotations, scales);
+    REQUIRE(translations[0] == Vec3(2.0f, 4.0f, -2.0f));
+    REQUIRE(scales[0] == Vec3(2.0f, 2.0f, 2.0f));
+    REQUIRE(std::abs(rotations[0].dot(Quat(std::numbers::pi_v<float> / 2.0f,
+                                           Vec3(0.0f, 1.0f, 0.0f)))) ==
+            Catch::Approx(1.0f));
+    REQUIRE(translations[1] == Vec3(5.0f, 5.0f, 5.0f));
+
+    sampler.sample(2.0f, translations, rotations, scales);
+    REQUIRE(translations[0] == Vec3(2.0f, 2.0f, 2.0f));
+    REQUIRE(scales[0] == Vec3(1.5f, 2.5f, 1.5f));
+
+    Quat expected = Quat::nlerp(
+        Quat(std::numbers::pi_v<float> / 2.0f, Vec3(0.0f, 1.0f, 0.0f)),
+        Quat(std::numbers::pi_v<float>, Vec3(0.0f, 1.0f, 0.0f)), 0.5f);
+    REQUIRE(std::abs(rotations[0].dot(expected)) == Catch::Approx(1.0f));
+
+    // Past either end the first or last key is held.
+    sampler.sample(10.0f, translations, rotations, scales);
+    REQUIRE(translations[0] == Vec3(2.0f, 0.0f, 6.0f));
+
+    sampler.sample(-1.0f, translations, rotations, scales);
+    REQUIRE(translations[0] == Vec3(0.0f, 0.0f, 0.0f));
+}
+
+TEST_CASE("Animation samplers agree playing forward or seeking",
+          "[animation]") {
+    AnimationClip clip = make_clip();
+    AnimationSampler forward(clip);
+
+    std::vector<Vec3> translations(2);
+    std::vector<Quat> rotations(2);
+    std::vector<Vec3> scales(2);
+
+    std::vector<Vec3> seek_translations(2);
+    std::vector<Quat> seek_rotations(2);
+    std::vector<Vec3> seek_scales(2);
+
+    int mismatches = 0;
+    for(int frame = 0; frame <= 40; ++frame) {
+        float time = static_cast<float>(frame) * 0.075f;
+
+        forward.sample(time, translations, rotations, scales);
+
+        AnimationSampler seek(clip);
+        seek.sample(3.0f, seek_translations, seek_rotations, seek_scales);
+        seek.sample(time, seek_translations, seek_rotations, seek_scales);
+
+        for(std::size_t i = 0; i < 2; ++i) {
+            if(!(translations[i] == seek_translations[i]) ||
+               !(scales[i] == seek_scales[i]) ||
+               !(rotations[i] == seek_rotations[i])) {
+                ++mismatches;
+            }
+        }
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Animation samplers build local matrices", "[animation]") {
+    AnimationClip clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    std::vector<Vec3> translations(2);
+    std::vector<Quat> rotations(2);
+    std::vector<Vec3> scales(2);
+    std::vector<Mat4> locals(2);
+
+    sampler.sample(0.4f, translations, rotations, scales);
+    sampler.reset();
+    sampler.sample(0.4f, locals);
+
+    Mat4 expected = rotations[0].to_mat4();
+    expected.apply_scale(scales[0]);
+    expected.set_translation(translations[0]);
+
+    REQUIRE(locals[0] == expected);
+}
+
+TEST_CASE("Animation samplers keep up with the clip's tracks",
+          "[animation]") {
+    AnimationClip clip = make_clip();
+    AnimationSampler sampler(clip);
+
+    // A track with no keys samples as the identity.
+    REQUIRE(clip.add_track({}, {}, {}, {}) == 2);
+    REQUIRE(clip.track_count() == 3);
+
+    // Enough tracks for a few batches of four plus some left over, added
+    // after the sampler was made.
+    for(int i = 0; i < 8; ++i) {
+        float f = static_cast<float>(i);
+        std::array<float, 2> times{0.0f, 1.0f + f};
+        std::array<Vec3, 2> translations{Vec3(f, 0.0f, 0.0f),
+                                         Vec3(0.0f, f, 1.0f)};
+        std::array<Quat, 2> rotations{
+            Quat(0.3f * f, Vec3(1.0f, f, 0.0f)),
+            Quat(-2.0f - 0.4f * f, Vec3(0.0f, 1.0f, f))};
+        std::array<Vec3, 2> scales{Vec3(1.0f, 1.0f, 1.0f),
+                                   Vec3(2.0f, 1.0f + f, 3.0f)};
+        clip.add_track(times, translations, rotations, scales);
+    }
+
+    std::vector<Vec3> translations(clip.track_count());
+    std::vector<Quat> rotations(clip.track_count());
+    std::vector<Vec3> scales(clip.track_count());
+    std::vector<Mat4> locals(clip.track_count());
+
+    sampler.sample(0.7f, translations, rotations, scales);
+    sampler.sample(0.7f, locals);
+
+    REQUIRE(translations[2] == Vec3(0.0f, 0.0f, 0.0f));
+    REQUIRE(rotations[2] == Quat::identity);
+    REQUIRE(scales[2] == Vec3(1.0f, 1.0f, 1.0f));
+    REQUIRE(locals[2] == Mat4::identity);
+
+    // The batched tracks agree with the nlerp they stand in for.
+    int mismatches = 0;
+    for(int i = 0; i < 8; ++i) {
+        float f = static_cast<float>(i);
+        float t = 0.7f / (1.0f + f);
+
+        Quat expected = Quat::nlerp(Quat(0.3f * f, Vec3(1.0f, f, 0.0f)),
+                                    Quat(-2.0f - 0.4f * f,
+                                         Vec3(0.0f, 1.0f, f)), t);
+        Vec3 translation(f - f * t, f * t, t);
+
+        std::size_t track = static_cast<std::size_t>(i) + 3;
+        if(!(rotations[track] == expected) ||
+           !(translations[track] == translation)) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+}
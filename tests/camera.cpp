@@ -1,12 +1,17 @@
 #include "pdmath/Camera.hpp"
 #include "pdmath/Point4.hpp"
 #include "pdmath/Point4.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Matrix4d.hpp"
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/catch_approx.hpp"
 
 #include <numbers>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 using namespace pdm;
 using namespace Catch;
@@ -106,6 +111,33 @@ TEST_CASE("Orthographic camera can pick points in space", "[cameras]") {
             Point4(-5850.112793f, 3824.128418f, -439.796386f));
 }
 
+TEST_CASE("Orthographic camera projects world to screen through ortho NDC",
+          "[cameras][matrices]") {
+    Camera camera(Vec3(2.0f, -1.0f, -4.0f), Vec3(-569.0f, 399.0f, -61.0f),
+                  Vec3(0.0f, 1.0f, 0.0f));
+
+    // No projection yet, so nothing to compose.
+    REQUIRE(camera.world_to_screen() == Mat4::identity);
+    REQUIRE(camera.screen_to_world() == Mat4::identity);
+
+    camera.set_persp(1.0f, 100.0f, 1280.0f, 720.0f,
+                     std::numbers::pi_v<float> / 3.0f, 1.0f);
+    camera.set_ortho(-700, 700, 394, -394, 1, 7000, 1280, 720, 1);
+
+    Mat4 expected = camera.screen() * camera.ortho_ndc() *
+                    camera.world_to_view();
+    REQUIRE(camera.world_to_screen() == expected);
+    REQUIRE(camera.screen_to_world() == expected.inverted());
+
+    // Composed once rather than applied in turn, so only close.
+    Point4 p(-4549.0f, 3260.0f, -259.0f);
+    Point4 composed = camera.world_to_screen() * p;
+    Point4 applied  = camera.ortho_screen(p);
+    REQUIRE(composed._x == Catch::Approx(applied._x).epsilon(1.0e-5));
+    REQUIRE(composed._y == Catch::Approx(applied._y).epsilon(1.0e-5));
+    REQUIRE(composed._z == Catch::Approx(applied._z).epsilon(1.0e-5));
+}
+
 TEST_CASE("Perspective camera gives correct View-to-World matrix",
           "[cameras][matrices]") {
     Mat4 vtw(0.928335f, -0.294833f, -0.226423f,  6.0f,
@@ -278,4 +310,203 @@ TEST_CASE("World space face culling", "[cameras]") {
     REQUIRE(camera_to_p1.dot(g_normal) == Catch::Approx(-21.2952f));
     REQUIRE(camera_to_p1.dot(b_normal) == Catch::Approx(-11.7053f));
     REQUIRE(camera_to_p2.dot(w_normal) == Catch::Approx( 27.91767f));
-}
\ No newline at end of file
+}
+TEST_CASE("Projected AABB bounds match projecting every corner",
+          "[cameras][bounds]") {
+    AABBox box(Point3(60.0f, 130.0f, -135.0f), Point3(70.0f, 140.0f, -120.0f));
+    ScreenBounds bounds = persp.projected_bounds(box);
+
+    float min_x = 1.0e9f;
+    float min_y = 1.0e9f;
+    float max_x = -1.0e9f;
+    float max_y = -1.0e9f;
+    float min_z = 1.0e9f;
+
+    for(int i = 0; i < 8; ++i) {
+        Point4 corner((i & 1) ? box.max()._x : box.min()._x,
+                      (i & 2) ? box.max()._y : box.min()._y,
+                      (i & 4) ? box.max()._z : box.min()._z);
+        Point4 screen = persp.persp_screen(corner);
+
+        min_x = std::min(min_x, screen._x);
+        min_y = std::min(min_y, screen._y);
+        max_x = std::max(max_x, screen._x);
+        max_y = std::max(max_y, screen._y);
+        min_z = std::min(min_z, screen._z);
+    }
+
+    REQUIRE(bounds.valid);
+    REQUIRE(bounds.min_x == Catch::Approx(min_x).epsilon(1.0e-4));
+    REQUIRE(bounds.min_y == Catch::Approx(min_y).epsilon(1.0e-4));
+    REQUIRE(bounds.max_x == Catch::Approx(max_x).epsilon(1.0e-4));
+    REQUIRE(bounds.max_y == Catch::Approx(max_y).epsilon(1.0e-4));
+    REQUIRE(bounds.min_depth == Catch::Approx(min_z).epsilon(1.0e-4));
+}
+
+TEST_CASE("Projected sphere bounds are tight around the silhouette",
+          "[cameras][bounds]") {
+    Mat4 world(Mat4::identity);
+    world.set_translation(Vec3(60.0f, 140.0f, -120.0f));
+    BSphere sphere(Point3(0.0f, 0.0f, 0.0f), 8.0f, world);
+
+    ScreenBounds bounds = persp.projected_bounds(sphere);
+    REQUIRE(bounds.valid);
+
+    // Sample the sphere surface: every sample lands inside the bounds and
+    // the extreme samples come close to touching them.
+    float min_x = 1.0e9f;
+    float max_x = -1.0e9f;
+    float min_y = 1.0e9f;
+    float max_y = -1.0e9f;
+
+    int outside = 0;
+
+    constexpr int steps = 96;
+    for(int i = 0; i <= steps; ++i) {
+        float theta = std::numbers::pi_v<float> * static_cast<float>(i) / steps;
+        for(int j = 0; j < steps * 2; ++j) {
+            float phi = std::numbers::pi_v<float> * static_cast<float>(j) /
+                        steps;
+            Point4 p(60.0f + 8.0f * std::sin(theta) * std::cos(phi),
+                     140.0f + 8.0f * std::sin(theta) * std::sin(phi),
+                     -120.0f + 8.0f * std::cos(theta));
+            Point4 screen = persp.persp_screen(p);
+
+            if(screen._x < bounds.min_x - 0.01f ||
+               screen._x > bounds.max_x + 0.01f ||
+               screen._y < bounds.min_y - 0.01f ||
+               screen._y > bounds.max_y + 0.01f ||
+               screen._z < bounds.min_depth - 1.0e-6f) {
+                ++outside;
+            }
+
+            min_x = std::min(min_x, screen._x);
+            max_x = std::max(max_x, screen._x);
+            min_y = std::min(min_y, screen._y);
+            max_y = std::max(max_y, screen._y);
+        }
+    }
+
+    REQUIRE(outside == 0);
+    REQUIRE(min_x - bounds.min_x < 0.5f);
+    REQUIRE(bounds.max_x - max_x < 0.5f);
+    REQUIRE(min_y - bounds.min_y < 0.5f);
+    REQUIRE(bounds.max_y - max_y < 0.5f);
+}
+
+TEST_CASE("Projected bounds come in batches", "[cameras][bounds]") {
+    std::vector<BSphere> spheres;
+    std::vector<AABBox>  boxes;
+
+    for(int i = 0; i < 16; ++i) {
+        float offset = static_cast<float>(i) * 3.0f;
+        Mat4 world(Mat4::identity);
+        world.set_translation(Vec3(60.0f + offset, 135.0f, -128.0f - offset));
+
+        spheres.emplace_back(Point3(0.0f, 0.0f, 0.0f), 2.0f, world);
+        boxes.emplace_back(Point3(60.0f + offset, 133.0f, -130.0f - offset),
+                           Point3(64.0f + offset, 137.0f, -126.0f - offset));
+    }
+
+    // one sphere sitting on the camera can't be bounded
+    spheres.emplace_back(Point3(6.0f, -1.0f, 3.0f), 1.0f, Mat4::identity);
+
+    std::vector<ScreenBounds> sphere_bounds(spheres.size());
+    std::vector<ScreenBounds> box_bounds(boxes.size());
+    std::vector<float>        sizes(spheres.size());
+
+    persp.projected_bounds(spheres, sphere_bounds);
+    persp.projected_bounds(boxes, box_bounds);
+    persp.projected_size(spheres, sizes);
+
+    for(std::size_t i = 0; i < boxes.size(); ++i) {
+        ScreenBounds single = persp.projected_bounds(boxes[i]);
+        REQUIRE(box_bounds[i].min_x == single.min_x);
+        REQUIRE(box_bounds[i].max_y == single.max_y);
+        REQUIRE(sphere_bounds[i].valid);
+        REQUIRE(sizes[i] == persp.projected_size(spheres[i]));
+    }
+
+    // further away means smaller on screen
+    for(std::size_t i = 1; i < boxes.size(); ++i) {
+        REQUIRE(sizes[i] < sizes[i - 1]);
+    }
+
+    REQUIRE(sphere_bounds.back().valid == false);
+}
+
+TEST_CASE("Perspective camera can pick rays from pixels", "[cameras][lines]") {
+    Point4 p1(65.0f, 135.0f, -128.0f);
+    Point4 screen = persp.persp_screen(p1);
+
+    Line ray = persp.pick_ray(screen._x, screen._y);
+
+    // the ray starts on the near plane and runs through the original point
+    REQUIRE(persp.persp_screen(Point4(ray.point_a()))._z ==
+            Catch::Approx(0.0f).margin(1.0e-4));
+    REQUIRE(persp.persp_screen(Point4(ray.point_b()))._z ==
+            Catch::Approx(1.0f).margin(1.0e-4));
+    REQUIRE(Point3(p1).distance_to_line(ray) ==
+            Catch::Approx(0.0f).margin(1.0e-2));
+
+    // same answer as inverting the whole chain by hand
+    Point4 near = persp.world_to_view().inverted() *
+                  persp.persp_ndc().inverted() *
+                  persp.screen().inverted() *
+                  Point4(screen._x, screen._y, 0.0f);
+    near /= near._w;
+
+    REQUIRE(ray.point_a()._x == Catch::Approx(near._x).epsilon(1.0e-3));
+    REQUIRE(ray.point_a()._y == Catch::Approx(near._y).epsilon(1.0e-3));
+    REQUIRE(ray.point_a()._z == Catch::Approx(near._z).epsilon(1.0e-3));
+}
+
+TEST_CASE("Perspective camera picks rays in batches", "[cameras][lines]") {
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    for(int i = 0; i < 64; ++i) {
+        xs.push_back(static_cast<float>(i * 20));
+        ys.push_back(static_cast<float>((i * 37) % 720));
+    }
+
+    std::vector<Line> rays(xs.size());
+    persp.pick_rays(xs, ys, rays);
+
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        Line single = persp.pick_ray(xs[i], ys[i]);
+        REQUIRE(rays[i].point_a() == single.point_a());
+        REQUIRE(rays[i].vec() == single.vec());
+
+        Point4 far = persp.persp_screen(Point4(rays[i].point_b()));
+        REQUIRE(far._x == Catch::Approx(xs[i]).margin(0.05));
+        REQUIRE(far._y == Catch::Approx(ys[i]).margin(0.05));
+    }
+}
+
+TEST_CASE("Cameras rebase double precision worlds around their origin",
+          "[cameras][matrices]") {
+    Camera camera(Vec3(0.0f, 0.0f, 0.0f),   // position
+                  Vec3(0.0f, 0.0f, -1.0f),  // target
+                  Vec3(0.0f, 1.0f, 0.0f));  // up vector
+    camera.set_origin(Point3d(-52000.0, 300.0, 18000.0));
+
+    Mat4d world(Mat4d::identity);
+    world.set_translation(Point3d(-52000.0, 300.0, 17990.0));
+
+    Mat4 relative = camera.rebase(world);
+    REQUIRE(relative.get_world_position() == Vec3(0.0f, 0.0f, -10.0f));
+    REQUIRE(camera.view(Point4(relative * Point3(0.0f, 0.0f, 0.0f))) ==
+            Point4(0.0f, 0.0f, -10.0f));
+
+    REQUIRE(camera.rebase(Point3d(-51999.5, 300.0, 18000.0)) ==
+            Point3(0.5f, 0.0f, 0.0f));
+
+    std::vector<Mat4d> worlds(8, world);
+    std::vector<Mat4>  rebased(worlds.size());
+    camera.rebase(worlds, rebased);
+
+    for(const Mat4 &m : rebased) {
+        REQUIRE(m == relative);
+    }
+}
@@ -16,6 +16,8 @@
 using namespace pdm;
 using namespace Catch;
 
+#include <numbers>
+
 TEST_CASE("Line - line collision", "[lines][collisions]") {
     Line line1(Point3(4.0f, 2.0f, 4.0f), Vec3(5.0f, 2.0f, 3.0f));
     Line line2(Point3(-6.0f, -2.0f, -2.0f), Vec3(10.0f, 4.0f, 6.0f));
@@ -622,6 +624,36 @@ TEST_CASE("Object bounding box - point collision",
     REQUIRE(box.collides(point) == false);
 }
 
+TEST_CASE("Object bounding box - line collision",
+          "[object bounding boxes][lines][collisions]") {
+    // Twice as long as it is wide, turned 45 degrees about z and moved
+    // along x.
+    Mat4 world(Mat3::populate_rotation(0.0f, 0.0f,
+                                       std::numbers::pi_v<float> / 4.0f));
+    world.set_translation(Vec3(10.0f, 0.0f, 0.0f));
+    OBBox box(Point3(-1.0f, -0.5f, -0.5f), Point3(1.0f, 0.5f, 0.5f), world);
+
+    // Straight through the center, and through the far end of the long
+    // axis.
+    REQUIRE(box.collides(Line(Point3(10.0f, 0.0f, -5.0f),
+                              Point3(10.0f, 0.0f, 5.0f))) == true);
+    REQUIRE(box.collides(Line(Point3(10.6f, 0.6f, -5.0f),
+                              Vec3(0.0f, 0.0f, 1.0f))) == true);
+
+    // Inside the box's world aligned bounds but off its short axis, which
+    // only the rotation rules out.
+    REQUIRE(box.collides(Line(Point3(10.8f, -0.8f, -5.0f),
+                              Vec3(0.0f, 0.0f, 1.0f))) == false);
+    REQUIRE(box.collides(Line(Point3(0.0f, 5.0f, 0.0f),
+                              Vec3(1.0f, 0.0f, 0.0f))) == false);
+
+    // Along the long axis, inside the box's thickness and then outside it.
+    REQUIRE(box.collides(Line(Point3(9.0f, -1.0f, 0.2f),
+                              Point3(11.0f, 1.0f, 0.2f))) == true);
+    REQUIRE(box.collides(Line(Point3(9.0f, -1.0f, 0.8f),
+                              Point3(11.0f, 1.0f, 0.8f))) == false);
+}
+
 TEST_CASE("Object bounding box - plane intersection",
           "[object bounding boxes][planes][collisions]") {
     OBBox box(Point3(-5.75f, -5.625f, -1.75f),
@@ -657,10 +689,18 @@ TEST_CASE("Object bounding box - plane intersection",
     Vec3 s1_minus_p0 = s1 - plane.point();
     Vec3 s2_minus_p0 = s2 - plane.point();
 
-    REQUIRE(s1 == Point3(-21.939632f, -18.42168f, 11.844144f));
-    REQUIRE(s2 == Point3(-11.49319f, 2.471205f, -3.82552f));
-    REQUIRE(s1_minus_p0 == Vec3(-30.939632f, -9.42168f, 2.844145f));
-    REQUIRE(s2_minus_p0 == Vec3(-20.49319f, 11.471205f, -12.82552f));
+    // The projection goes through the fast 1/sqrt, which is within an ulp or
+    // two of the exact one, so the support points are checked to a margin.
+    Catch::Approx near_zero = Catch::Approx(0.0f).margin(1e-5f);
+
+    REQUIRE((s1 - Point3(-21.939632f, -18.42168f, 11.844144f)).length() ==
+            near_zero);
+    REQUIRE((s2 - Point3(-11.49319f, 2.471205f, -3.82552f)).length() ==
+            near_zero);
+    REQUIRE((s1_minus_p0 - Vec3(-30.939632f, -9.42168f, 2.844145f)).length() ==
+            near_zero);
+    REQUIRE((s2_minus_p0 - Vec3(-20.49319f, 11.471205f, -12.82552f)).length() ==
+            near_zero);
 
     float d1 = s1_minus_p0.dot(plane.normal());
     float d2 = s2_minus_p0.dot(plane.normal());
@@ -670,3 +710,47 @@ TEST_CASE("Object bounding box - plane intersection",
 
     REQUIRE(box.collides(plane) == true);
 }
+
+TEST_CASE("Volumes built from an Affine3 match those built from a Mat4",
+          "[collisions]") {
+    Mat4 world(Mat3::populate_rotation(0.3f, 0.2f, -0.5f));
+    world.apply_scale(Vec3(2.0f, 2.0f, 2.0f));
+    world.set_translation(Vec3(1.0f, -4.0f, 3.0f));
+
+    OBBox   box(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 2.0f, 1.0f), world);
+    OBBox   affine_box(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 2.0f, 1.0f),
+                       Affine3(world));
+    BSphere sphere(Point3(0.5f, 0.0f, 0.0f), 1.5f, world);
+    BSphere affine_sphere(Point3(0.5f, 0.0f, 0.0f), 1.5f, Affine3(world));
+
+    REQUIRE(affine_box.get_world() == box.get_world());
+    REQUIRE(affine_box.get_local() == box.get_local());
+    REQUIRE(affine_box.center_world() == box.center_world());
+    REQUIRE(affine_sphere.center_world() == sphere.center_world());
+    REQUIRE(affine_sphere.scaled_radius() ==
+            Catch::Approx(sphere.scaled_radius()));
+
+    Point3 inside(1.2f, -3.5f, 3.1f);
+    REQUIRE(affine_box.collides(inside) == box.collides(inside));
+    REQUIRE(affine_sphere.to_local(inside) == sphere.to_local(inside));
+    REQUIRE(affine_box.collides(affine_sphere) == box.collides(sphere));
+}
+
+TEST_CASE("An AABBox as an OBBox matches one with an identity transform",
+          "[axis aligned bounding boxes][object bounding boxes][collisions]") {
+    AABBox aabb(Point3(-1.0f, -2.0f, 0.5f), Point3(3.0f, 1.0f, 2.0f));
+    OBBox  box(aabb);
+    OBBox  identity(aabb.min(), aabb.max(), Mat4::identity);
+
+    REQUIRE(box.get_world() == identity.get_world());
+    REQUIRE(box.get_local() == identity.get_local());
+    REQUIRE(box.center_world() == identity.center_world());
+    REQUIRE(box.best_diag() == identity.best_diag());
+
+    OBBox other(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f),
+                Mat4(Mat3::populate_rotation(0.4f, 0.0f, 0.7f)));
+    Plane plane(Point3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 1.0f, 1.0f));
+
+    REQUIRE(box.collides(other) == identity.collides(other));
+    REQUIRE(box.collides(plane) == identity.collides(plane));
+}
@@ -0,0 +1,193 @@
+#include "pdmath/fastmath.hpp"
+#include "pdmath/Vec3Stream.hpp"
+#include "pdmath/Vector.hpp"
+#include "pdmath/Matrix.hpp"
+
+#include "../bench/scene.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// FNV-1a over the bit patterns of every float fed to it, so a difference
+// in the last place (or in the sign of a zero) changes the sum.
+class Checksum {
+public:
+    void add(const float f) {
+        uint32_t bits = std::bit_cast<uint32_t>(f);
+        for(int i = 0; i < 4; ++i) {
+            _hash ^= (bits >> (i * 8)) & 0xFFu;
+            _hash *= 0x100000001B3u;
+        }
+    }
+
+    void add(const bool b) { add(b ? 1.0f : 0.0f); }
+
+    void add(const Vec3 &v)   { add(v._x); add(v._y); add(v._z); }
+    void add(const Point3 &p) { add(p._x); add(p._y); add(p._z); }
+    void add(const Vec4 &v)   { add(v._x); add(v._y); add(v._z); add(v._w); }
+    void add(const Quat &q)   { add(q._w); add(q._v); }
+
+    void add(const Mat3 &m) {
+        for(const auto &row : m._m) {
+            for(float f : row) {
+                add(f);
+            }
+        }
+    }
+
+    void add(const Mat4 &m) {
+        for(const auto &row : m._m) {
+            for(float f : row) {
+                add(f);
+            }
+        }
+    }
+
+    void add(const Affine3 &a) {
+        for(const auto &row : a._m) {
+            for(float f : row) {
+                add(f);
+            }
+        }
+    }
+
+    void add(const Mat4f &m) {
+        for(const auto &row : m._m) {
+            for(float f : row) {
+                add(f);
+            }
+        }
+    }
+
+    void add(const Vec4f &v) {
+        for(float f : v._e) {
+            add(f);
+        }
+    }
+
+    uint64_t value() const { return _hash; }
+
+private:
+    uint64_t _hash = 0xCBF29CE484222325u;
+};
+
+Mat4f to_mat4f(const Mat4 &m) {
+    Mat4f r;
+    for(std::size_t i = 0; i < 4; ++i) {
+        for(std::size_t j = 0; j < 4; ++j) {
+            r._m[i][j] = m._m[i][j];
+        }
+    }
+    return r;
+}
+
+// Camera goes through libm, so it's left out.
+uint64_t transforms_checksum() {
+    const bench::Scene scene(256, 7);
+    const std::size_t count = scene.transforms.size();
+    Checksum sum;
+
+    for(std::size_t i = 0; i < count; ++i) {
+        const std::size_t j = (i + 1) % count;
+
+        sum.add(scene.rotations[i]);
+        Vec3 euler_a;
+        Vec3 euler_b;
+        scene.rotations[i].get_euler_xyz(euler_a, euler_b);
+        sum.add(euler_a);
+        sum.add(euler_b);
+        sum.add(scene.transforms[i]);
+        sum.add(scene.transforms[i] * scene.transforms[j]);
+        sum.add(scene.transforms[i].inverted());
+        sum.add(scene.transforms[i] * scene.points[j]);
+        sum.add(scene.transforms[i] * scene.vector4s[j]);
+        sum.add(scene.affines[i] * scene.affines[j]);
+        sum.add(scene.affines[i].inverted());
+
+        sum.add(scene.quats[i]);
+        sum.add(scene.quats[i].to_mat3());
+        sum.add(scene.quats[i] * scene.quats[j]);
+        sum.add(Quat::slerp(scene.quats[i], scene.quats[j], 0.3f));
+        sum.add(Quat::nlerp(scene.quats[i], scene.quats[j], 0.3f));
+
+        sum.add(scene.vectors[i].normalized());
+        sum.add(scene.vectors[i].cross(scene.vectors[j]));
+        sum.add(scene.vectors[i].dot(scene.vectors[j]));
+
+        Mat4f m = to_mat4f(scene.transforms[i]);
+        Mat4f n = to_mat4f(scene.transforms[j]);
+        Vec4f v(scene.vector4s[j]._x, scene.vector4s[j]._y,
+                scene.vector4s[j]._z, scene.vector4s[j]._w);
+        sum.add(m * n);
+        sum.add(m * v);
+        sum.add(v.dot(v));
+    }
+
+    Vec3Stream stream(scene.vectors);
+    stream.transform(scene.transforms[0]);
+    stream.transform_points(scene.transforms[1]);
+    stream.transform(scene.rotations[2]);
+    stream.normalize(Accuracy::high);
+    stream.add_scaled(Vec3Stream(scene.vectors), 0.25f);
+
+    std::vector<float> lengths(stream.size());
+    stream.length(lengths);
+    for(std::size_t i = 0; i < stream.size(); ++i) {
+        sum.add(stream.get(i));
+        sum.add(lengths[i]);
+    }
+
+    return sum.value();
+}
+
+uint64_t collisions_checksum() {
+    const bench::Scene scene(256, 7);
+    const std::size_t count = scene.obbs.size();
+    Checksum sum;
+
+    for(std::size_t i = 0; i < count; ++i) {
+        for(std::size_t j = i + 1; j < count; j += 7) {
+            sum.add(scene.obbs[i].collides(scene.obbs[j]));
+            sum.add(scene.obbs[i].collides(scene.spheres[j]));
+            sum.add(scene.obbs[i].collides(scene.planes[j]));
+            sum.add(scene.spheres[i].collides(scene.spheres[j]));
+            sum.add(scene.aabbs[i].collides(scene.aabbs[j]));
+            sum.add(scene.aabbs[i].collides(scene.lines[j]));
+        }
+        sum.add(scene.spheres[i].center_world());
+        sum.add(scene.spheres[i].scaled_radius());
+    }
+
+    return sum.value();
+}
+
+} // namespace
+
+/*------------------------------------------------------------------------------
+    Only a PDMATH_DETERMINISTIC build checks anything across platforms: the
+    golden values below come from an x86-64 deterministic build, and every
+    platform and kernel tier has to land on the same bits. Any other build
+    just runs each checksum twice in one process, which catches
+    uninitialized reads and nothing else; configure a second build with
+    -DPDMATH_DETERMINISTIC=ON to test the promise itself.
+------------------------------------------------------------------------------*/
+TEST_CASE("Scene results hash the same from run to run", "[determinism]") {
+    uint64_t transforms = transforms_checksum();
+    uint64_t collisions = collisions_checksum();
+
+    CHECK(transforms_checksum() == transforms);
+    CHECK(collisions_checksum() == collisions);
+
+    if constexpr(deterministic) {
+        CHECK(transforms == 0x6BAC578BFA65C9ECu);
+        CHECK(collisions == 0x14E8674F8BC00C3Du);
+    }
+}
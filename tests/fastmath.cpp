@@ -0,0 +1,114 @@
+#include "pdmath/fastmath.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Fast sincos stays within its accuracy tier", "[fastmath]") {
+    std::vector<float> x;
+    for(int i = -4000; i <= 4000; ++i) {
+        x.push_back(static_cast<float>(i) * 0.0123f);
+    }
+
+    std::vector<float> s(x.size());
+    std::vector<float> c(x.size());
+
+    float worst_high = 0.0f;
+    fastmath::sincos<Accuracy::high>(x, s, c);
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        worst_high = std::max({worst_high,
+                               std::abs(s[i] - std::sin(x[i])),
+                               std::abs(c[i] - std::cos(x[i]))});
+    }
+
+    float worst_low = 0.0f;
+    fastmath::sincos<Accuracy::low>(x, s, c);
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        worst_low = std::max({worst_low,
+                              std::abs(s[i] - std::sin(x[i])),
+                              std::abs(c[i] - std::cos(x[i]))});
+    }
+
+    REQUIRE(worst_high < 1.0e-6f);
+    REQUIRE(worst_low  < 1.0e-3f);
+
+    float sin_exact;
+    float cos_exact;
+    fastmath::sincos<Accuracy::exact>(0.5f, sin_exact, cos_exact);
+    REQUIRE(sin_exact == std::sin(0.5f));
+    REQUIRE(cos_exact == std::cos(0.5f));
+}
+
+TEST_CASE("Fast reciprocals stay within their accuracy tier", "[fastmath]") {
+    float worst_rsqrt_high = 0.0f;
+    float worst_rsqrt_low  = 0.0f;
+    float worst_rcp_high   = 0.0f;
+    float worst_rcp_low    = 0.0f;
+
+    for(int i = 1; i < 20000; ++i) {
+        float x = static_cast<float>(i) * 0.173f;
+
+        float rsqrt = 1.0f / std::sqrt(x);
+        float rcp   = 1.0f / x;
+
+        worst_rsqrt_high = std::max(worst_rsqrt_high, std::abs(
+            fastmath::rsqrt<Accuracy::high>(x) - rsqrt) / rsqrt);
+        worst_rsqrt_low  = std::max(worst_rsqrt_low, std::abs(
+            fastmath::rsqrt<Accuracy::low>(x) - rsqrt) / rsqrt);
+        worst_rcp_high   = std::max(worst_rcp_high, std::abs(
+            fastmath::rcp<Accuracy::high>(x) - rcp) / rcp);
+        worst_rcp_low    = std::max(worst_rcp_low, std::abs(
+            fastmath::rcp<Accuracy::low>(x) - rcp) / rcp);
+    }
+
+    REQUIRE(worst_rsqrt_high < 1.0e-5f);
+    REQUIRE(worst_rsqrt_low  < 1.0e-3f);
+    REQUIRE(worst_rcp_high   < 1.0e-5f);
+    REQUIRE(worst_rcp_low    < 1.0e-3f);
+    REQUIRE(fastmath::sqrt(0.0f) == 0.0f);
+    REQUIRE(fastmath::sqrt(16.0f) == Catch::Approx(4.0f));
+}
+
+TEST_CASE("Fast inverse trig stays within its accuracy tier",
+          "[fastmath]") {
+    float worst_asin_high = 0.0f;
+    float worst_asin_low  = 0.0f;
+
+    for(int i = -1000; i <= 1000; ++i) {
+        float x = static_cast<float>(i) * 0.001f;
+
+        worst_asin_high = std::max(worst_asin_high, std::abs(
+            fastmath::asin<Accuracy::high>(x) - std::asin(x)));
+        worst_asin_low  = std::max(worst_asin_low, std::abs(
+            fastmath::asin<Accuracy::low>(x) - std::asin(x)));
+    }
+
+    float worst_atan2_high = 0.0f;
+    float worst_atan2_low  = 0.0f;
+
+    for(int i = 0; i < 3600; ++i) {
+        float angle  = static_cast<float>(i) * 0.1f *
+                       std::numbers::pi_v<float> / 180.0f;
+        float radius = 0.5f + static_cast<float>(i % 11);
+        float y = radius * std::sin(angle);
+        float x = radius * std::cos(angle);
+
+        worst_atan2_high = std::max(worst_atan2_high, std::abs(
+            fastmath::atan2<Accuracy::high>(y, x) - std::atan2(y, x)));
+        worst_atan2_low  = std::max(worst_atan2_low, std::abs(
+            fastmath::atan2<Accuracy::low>(y, x) - std::atan2(y, x)));
+    }
+
+    REQUIRE(worst_asin_high  < 1.0e-5f);
+    REQUIRE(worst_asin_low   < 1.0e-3f);
+    REQUIRE(worst_atan2_high < 1.0e-5f);
+    REQUIRE(worst_atan2_low  < 1.0e-3f);
+    REQUIRE(fastmath::atan2(0.0f, 0.0f) == 0.0f);
+}
@@ -0,0 +1,141 @@
+#include "pdmath/TransformHierarchy.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Matrix4.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <numbers>
+
+static Mat4 make_local(const Vec3 &t, const Quat &r, const Vec3 &s) {
+    Mat4 local = r.to_mat4();
+    local.apply_scale(s);
+    local.set_translation(t);
+    return local;
+}
+
+TEST_CASE("Transform hierarchies chain parent transforms", "[hierarchy]") {
+    TransformHierarchy hierarchy(1);
+
+    Quat turn(std::numbers::pi_v<float> / 2.0f, Vec3(0.0f, 1.0f, 0.0f));
+    Vec3 one(1.0f, 1.0f, 1.0f);
+
+    uint32_t root  = hierarchy.add_node(TransformHierarchy::no_parent,
+                                        Vec3(10.0f, 0.0f, 0.0f), turn, one);
+    uint32_t child = hierarchy.add_node(root, Vec3(0.0f, 0.0f, 5.0f),
+                                        Quat::identity,
+                                        Vec3(2.0f, 2.0f, 2.0f));
+    uint32_t leaf  = hierarchy.add_node(child, Vec3(1.0f, 0.0f, 0.0f),
+                                        turn, one);
+
+    REQUIRE(hierarchy.size() == 3);
+    REQUIRE(hierarchy.level_count() == 3);
+    REQUIRE(hierarchy.parent(leaf) == child);
+
+    hierarchy.update();
+
+    Mat4 expected = make_local(Vec3(10.0f, 0.0f, 0.0f), turn, one) *
+                    make_local(Vec3(0.0f, 0.0f, 5.0f), Quat::identity,
+                               Vec3(2.0f, 2.0f, 2.0f)) *
+                    make_local(Vec3(1.0f, 0.0f, 0.0f), turn, one);
+
+    REQUIRE(hierarchy.world(leaf) == expected);
+    REQUIRE(hierarchy.world(child).get_world_position() ==
+            Vec3(15.0f, 0.0f, 0.0f));
+    REQUIRE(!hierarchy.dirty(leaf));
+}
+
+TEST_CASE("Transform hierarchies only rebuild dirty subtrees",
+          "[hierarchy]") {
+    TransformHierarchy hierarchy(1);
+    Vec3 one(1.0f, 1.0f, 1.0f);
+
+    uint32_t root  = hierarchy.add_node(TransformHierarchy::no_parent,
+                                        Vec3(0.0f, 0.0f, 0.0f),
+                                        Quat::identity, one);
+    uint32_t left  = hierarchy.add_node(root, Vec3(-1.0f, 0.0f, 0.0f),
+                                        Quat::identity, one);
+    uint32_t right = hierarchy.add_node(root, Vec3(1.0f, 0.0f, 0.0f),
+                                        Quat::identity, one);
+    uint32_t leaf  = hierarchy.add_node(left, Vec3(0.0f, 1.0f, 0.0f),
+                                        Quat::identity, one);
+
+    hierarchy.attach_sphere(leaf, Point3(0.0f, 0.0f, 0.0f), 0.5f);
+    hierarchy.attach_box(right, Point3(-1.0f, -1.0f, -1.0f),
+                         Point3(1.0f, 1.0f, 1.0f));
+    hierarchy.update();
+    REQUIRE(hierarchy.rebuilt_count() == 4);
+
+    REQUIRE(hierarchy.has_sphere(leaf));
+    REQUIRE(!hierarchy.has_sphere(right));
+    REQUIRE(hierarchy.sphere(leaf).center_world() ==
+            Point3(-1.0f, 1.0f, 0.0f));
+    REQUIRE(hierarchy.box(right).center_world() == Point3(1.0f, 0.0f, 0.0f));
+
+    hierarchy.set_translation(left, Vec3(-3.0f, 0.0f, 0.0f));
+    REQUIRE(hierarchy.dirty(left));
+    REQUIRE(!hierarchy.dirty(leaf));
+
+    // Only left and the leaf under it are looked at.
+    hierarchy.update();
+    REQUIRE(hierarchy.rebuilt_count() == 2);
+    REQUIRE(!hierarchy.dirty(left));
+
+    REQUIRE(hierarchy.world(leaf).get_world_position() ==
+            Vec3(-3.0f, 1.0f, 0.0f));
+    REQUIRE(hierarchy.sphere(leaf).center_world() ==
+            Point3(-3.0f, 1.0f, 0.0f));
+    REQUIRE(hierarchy.world(right).get_world_position() ==
+            Vec3(1.0f, 0.0f, 0.0f));
+
+    hierarchy.update();
+    REQUIRE(hierarchy.rebuilt_count() == 0);
+
+    // A node changed along with its parent is rebuilt once.
+    hierarchy.set_translation(leaf, Vec3(0.0f, 1.0f, 0.0f));
+    hierarchy.set_scale(root, Vec3(2.0f, 2.0f, 2.0f));
+    hierarchy.update();
+    REQUIRE(hierarchy.rebuilt_count() == 4);
+
+    REQUIRE(hierarchy.sphere(leaf).scaled_radius() == Catch::Approx(1.0f));
+    REQUIRE(hierarchy.box(right).center_world() == Point3(2.0f, 0.0f, 0.0f));
+}
+
+TEST_CASE("Transform hierarchies update wide levels in parallel",
+          "[hierarchy]") {
+    TransformHierarchy serial(1);
+    TransformHierarchy parallel(4);
+    Vec3 one(1.0f, 1.0f, 1.0f);
+
+    for(TransformHierarchy *h : {&serial, &parallel}) {
+        uint32_t root = h->add_node(TransformHierarchy::no_parent,
+                                    Vec3(0.0f, 2.0f, 0.0f),
+                                    Quat(0.3f, Vec3(0.0f, 0.0f, 1.0f)), one);
+
+        for(uint32_t i = 0; i < 2048; ++i) {
+            float x = static_cast<float>(i % 64);
+            float z = static_cast<float>(i / 64);
+            uint32_t node = h->add_node(root, Vec3(x, 0.0f, z),
+                                        Quat(0.01f * x,
+                                             Vec3(0.0f, 1.0f, 0.0f)), one);
+            h->add_node(node, Vec3(0.0f, 1.0f, 0.0f), Quat::identity, one);
+        }
+
+        h->update();
+        h->set_rotation(root, Quat(0.6f, Vec3(1.0f, 0.0f, 0.0f)));
+        h->update();
+    }
+
+    int mismatches = 0;
+    for(uint32_t i = 0; i < serial.size(); ++i) {
+        if(!(serial.world(i) == parallel.world(i))) {
+            ++mismatches;
+        }
+    }
+
+    REQUIRE(mismatches == 0);
+}
@@ -121,11 +121,11 @@ TEST_CASE("Triangular game object transformations", "[vectors][matrices]") {
     Vec3 prev_translation;
     Mat3 prev_rotation;
 
-    Point3 new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                                     prev_translation, prev_rotation);
-    Point3 new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                                     prev_translation, prev_rotation);
-    Point3 new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                                     prev_translation, prev_rotation);
 
     REQUIRE(new_p1 == Point3(-1.414213f, 0.0f, 7.0f));
@@ -136,11 +136,11 @@ TEST_CASE("Triangular game object transformations", "[vectors][matrices]") {
     translation = Vec3(0.0f, 0.0f, 10.0f);
     theta = std::numbers::pi_v<float> / 2.0f;
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
 
     REQUIRE(new_p1 == Point3(7.071067f, 0.0f, 15.485281f));
@@ -152,11 +152,11 @@ TEST_CASE("Triangular game object transformations", "[vectors][matrices]") {
     theta = std::numbers::pi_v<float> / -2.0f;
 
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
 
     REQUIRE(new_p1 == Point3(10.606601f, 0.0f, 9.121319f));
@@ -167,11 +167,11 @@ TEST_CASE("Triangular game object transformations", "[vectors][matrices]") {
     translation = Vec3(0, 0, 6);
     theta = (-3 * std::numbers::pi_v<float>) / 4.0f;
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_translation, prev_rotation);
 
     REQUIRE(new_p1 == Point3(17.263454f, 0.0f, 12.36396f));
@@ -192,11 +192,11 @@ TEST_CASE("Alternative TGO transformations", "[vectors][matrices]") {
     Vec3 translation(0.0f, 0.0f, 7.0f);
     float theta = std::numbers::pi_v<float> / 4.0f;
 
-    Point3 new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                                     prev_transform1);
-    Point3 new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                                     prev_transform2);
-    Point3 new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    Point3 new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                                     prev_transform3);
 
     REQUIRE(new_p1 == Point3(-1.414213f, 0.0f, 7.0f));
@@ -207,11 +207,11 @@ TEST_CASE("Alternative TGO transformations", "[vectors][matrices]") {
     translation = Vec3(0.0f, 0.0f, 10.0f);
     theta = std::numbers::pi_v<float> / 2.0f;
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_transform1);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_transform2);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_transform3);
 
     REQUIRE(new_p1 == Point3(7.071067f, 0.0f, 15.485281f));
@@ -222,11 +222,11 @@ TEST_CASE("Alternative TGO transformations", "[vectors][matrices]") {
     translation = Vec3(0.0f, 0.0f, 7.0f);
     theta = std::numbers::pi_v<float> / -2.0f;
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_transform1);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_transform2);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_transform3);
 
     REQUIRE(new_p1 == Point3(10.606601f, 0.0f, 9.121319f));
@@ -237,11 +237,11 @@ TEST_CASE("Alternative TGO transformations", "[vectors][matrices]") {
     translation = Vec3(0.0f, 0.0f, 6.0f);
     theta = (-3 * std::numbers::pi_v<float>) / 4.0f;
 
-    new_p1 = Mat4::transform(p1, translation, 1, theta, 1, Vec3::one,
+    new_p1 = Mat4::transform(p1, translation, 0, theta, 0, Vec3::one,
                              prev_transform1);
-    new_p2 = Mat4::transform(p2, translation, 1, theta, 1, Vec3::one,
+    new_p2 = Mat4::transform(p2, translation, 0, theta, 0, Vec3::one,
                              prev_transform2);
-    new_p3 = Mat4::transform(p3, translation, 1, theta, 1, Vec3::one,
+    new_p3 = Mat4::transform(p3, translation, 0, theta, 0, Vec3::one,
                              prev_transform3);
 
     REQUIRE(new_p1 == Point3(17.263454f, 0.0f, 12.36396f));
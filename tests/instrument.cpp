@@ -0,0 +1,64 @@
+#include "pdmath/instrument.hpp"
+#include "pdmath/OBBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Point3.hpp"
+#include "pdmath/Vector3.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <thread>
+
+using instrument::Counter;
+
+TEST_CASE("Instrumentation counts hot calls per frame", "[instrument]") {
+    Mat4 world = Mat4::identity;
+    world.set_translation(Vec3(1.0f, 2.0f, 3.0f));
+
+    OBBox a(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f), world);
+    OBBox b(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f),
+            Mat4::identity);
+
+    // Anything counted before this point belongs to the previous frame.
+    instrument::frame();
+    instrument::set_timing(true);
+
+    for(int i = 0; i < 10; ++i) {
+        a.collides(b);
+        a.collides(Point3(1.0f, 2.0f, 3.0f));
+    }
+    for(int i = 0; i < 3; ++i) {
+        BSphere sphere(Point3(0.0f, 0.0f, 0.0f), 1.0f, world);
+    }
+
+    // Calls on another thread land in the same totals.
+    std::thread worker([&world] {
+        for(int i = 0; i < 5; ++i) {
+            world.inverted();
+        }
+    });
+    worker.join();
+
+    instrument::Snapshot frame = instrument::frame();
+    instrument::set_timing(false);
+
+    if constexpr(instrument::compiled_in) {
+        CHECK(frame[Counter::obbox_collides].calls == 20);
+        CHECK(frame[Counter::bsphere_constructed].calls == 3);
+        // Each Mat4 constructor of a BSphere inverts once.
+        CHECK(frame[Counter::mat4_inverted].calls == 8);
+        CHECK(frame[Counter::obbox_collides].ticks > 0);
+
+        // The next frame starts from zero, but the totals keep everything.
+        instrument::Snapshot next = instrument::frame();
+        CHECK(next[Counter::obbox_collides].calls == 0);
+        CHECK(instrument::snapshot()[Counter::obbox_collides].calls >= 20);
+    }
+    else {
+        CHECK(frame[Counter::obbox_collides].calls == 0);
+        CHECK(instrument::snapshot()[Counter::mat4_inverted].calls == 0);
+    }
+}
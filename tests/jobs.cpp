@@ -0,0 +1,242 @@
+#include "pdmath/JobSystem.hpp"
+#include "pdmath/TransformHierarchy.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/Vector3.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Stands in for an engine's own pool: every submitted helper gets a thread,
+// joined when the pool goes away.
+class EnginePool {
+public:
+    static void submit(void *context, void (*run)(void*), void *data) {
+        auto &pool = *static_cast<EnginePool*>(context);
+        std::lock_guard lock(pool._lock);
+        pool._threads.emplace_back(run, data);
+        ++pool._submitted;
+    }
+
+    inline std::size_t submitted() const { return _submitted; }
+
+    void join() {
+        std::lock_guard lock(_lock);
+        for(auto &thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+    }
+
+    ~EnginePool() { join(); }
+
+private:
+    std::mutex               _lock;
+    std::vector<std::thread> _threads;
+    std::size_t              _submitted = 0;
+};
+
+// An engine too busy to get to anything it's given until run() is called.
+class HeldPool {
+public:
+    static void submit(void *context, void (*run)(void*), void *data) {
+        auto &pool = *static_cast<HeldPool*>(context);
+        pool._held.push_back({run, data});
+        ++pool._submitted;
+    }
+
+    inline std::size_t submitted() const { return _submitted; }
+
+    void run() {
+        for(auto &[run, data] : _held) {
+            run(data);
+        }
+        _held.clear();
+    }
+
+private:
+    std::vector<std::pair<void (*)(void*), void*>> _held;
+    std::size_t                                    _submitted = 0;
+};
+
+} // namespace
+
+TEST_CASE("parallel_for covers every index exactly once", "[jobs]") {
+    JobSystem jobs(4);
+    REQUIRE(jobs.thread_count() == 4);
+
+    std::vector<std::atomic<int>> hits(100000);
+    std::atomic<std::size_t> pieces{0};
+    std::atomic<std::size_t> short_pieces{0};
+
+    // Catch's assertions aren't thread safe, so the workers only count.
+    jobs.parallel_for(0, hits.size(), 100,
+                      [&](std::size_t first, std::size_t last) {
+        for(std::size_t i = first; i < last; ++i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+        if(last - first < 100) {
+            ++short_pieces;
+        }
+        ++pieces;
+    });
+
+    int wrong = 0;
+    for(auto &hit : hits) {
+        if(hit.load() != 1) {
+            ++wrong;
+        }
+    }
+    REQUIRE(wrong == 0);
+    REQUIRE(pieces.load() > 1);
+    REQUIRE(short_pieces.load() == 0);
+
+    // Small ranges run on the calling thread in one go.
+    std::size_t calls = 0;
+    std::size_t count = 0;
+    jobs.parallel_for(0, 150, 100, [&](std::size_t first, std::size_t last) {
+        count += last - first;
+        ++calls;
+    });
+    REQUIRE(calls == 1);
+    REQUIRE(count == 150);
+}
+
+TEST_CASE("parallel_for nests inside tasks", "[jobs]") {
+    JobSystem jobs(3);
+    std::atomic<std::size_t> sum{0};
+
+    jobs.parallel_for(0, 16, 1, [&](std::size_t first, std::size_t last) {
+        for(std::size_t i = first; i < last; ++i) {
+            jobs.parallel_for(0, 1000, 10,
+                              [&](std::size_t a, std::size_t b) {
+                sum.fetch_add(b - a, std::memory_order_relaxed);
+            });
+        }
+    });
+
+    REQUIRE(sum.load() == 16 * 1000);
+}
+
+TEST_CASE("Task graphs run tasks after their dependencies", "[jobs]") {
+    JobSystem jobs(4);
+    TaskGraph graph;
+
+    // a -> (b, c) -> d, with e on its own.
+    std::atomic<int> clock{0};
+    int a_at = -1;
+    int b_at = -1;
+    int c_at = -1;
+    int d_at = -1;
+    int e_at = -1;
+
+    TaskGraph::Node a = graph.add([&] { a_at = clock++; });
+    TaskGraph::Node b = graph.add([&] { b_at = clock++; });
+    TaskGraph::Node c = graph.add([&] { c_at = clock++; });
+    TaskGraph::Node d = graph.add([&] { d_at = clock++; });
+    graph.add([&] { e_at = clock++; });
+
+    graph.precede(a, b);
+    graph.precede(a, c);
+    graph.precede(b, d);
+    graph.precede(c, d);
+
+    for(int run = 0; run < 20; ++run) {
+        clock = 0;
+        jobs.run(graph);
+
+        REQUIRE(clock.load() == 5);
+        REQUIRE(a_at < b_at);
+        REQUIRE(a_at < c_at);
+        REQUIRE(b_at < d_at);
+        REQUIRE(c_at < d_at);
+        REQUIRE(e_at >= 0);
+    }
+}
+
+TEST_CASE("Every job thread has its own arena", "[jobs]") {
+    JobSystem jobs(4);
+    std::vector<std::atomic<int>> used(jobs.thread_count());
+
+    jobs.parallel_for(0, 4096, 16, [&](std::size_t first, std::size_t last) {
+        FrameArena &arena = jobs.arena();
+        auto scratch = arena.allocate<uint32_t>(last - first);
+        for(std::size_t i = first; i < last; ++i) {
+            scratch[i - first] = static_cast<uint32_t>(i);
+        }
+        used[jobs.thread_index()].store(1);
+    });
+
+    REQUIRE(jobs.thread_index() == 0);
+    REQUIRE(used[0].load() == 1);
+
+    jobs.reset_arenas();
+    REQUIRE(jobs.arena().used() == 0);
+}
+
+TEST_CASE("Job systems can run on an engine's threads", "[jobs]") {
+    EnginePool pool;
+    std::atomic<std::size_t> sum{0};
+
+    {
+        JobSystem jobs({EnginePool::submit, &pool, 4});
+        REQUIRE(jobs.thread_count() == 4);
+
+        jobs.parallel_for(0, 10000, 10, [&](std::size_t a, std::size_t b) {
+            sum.fetch_add(b - a, std::memory_order_relaxed);
+        });
+
+        // Hierarchies and occlusion buffers take the system too.
+        TransformHierarchy hierarchy(0, jobs);
+        Vec3 one(1.0f, 1.0f, 1.0f);
+        uint32_t root = hierarchy.add_node(TransformHierarchy::no_parent,
+                                           Vec3(1.0f, 0.0f, 0.0f),
+                                           Quat::identity, one);
+        for(uint32_t i = 0; i < 2048; ++i) {
+            hierarchy.add_node(root, Vec3(0.0f, static_cast<float>(i), 0.0f),
+                               Quat::identity, one);
+        }
+        hierarchy.update();
+        REQUIRE(hierarchy.world(2048)._m[1][3] == 2047.0f);
+
+        pool.join();
+    }
+
+    REQUIRE(sum.load() == 10000);
+    REQUIRE(pool.submitted() > 0);
+}
+
+TEST_CASE("Job systems don't pile helpers up on a busy engine", "[jobs]") {
+    HeldPool pool;
+    std::atomic<std::size_t> sum{0};
+
+    JobSystem jobs({HeldPool::submit, &pool, 4});
+    for(int i = 0; i < 16; ++i) {
+        jobs.parallel_for(0, 1000, 10, [&](std::size_t a, std::size_t b) {
+            sum.fetch_add(b - a, std::memory_order_relaxed);
+        });
+    }
+
+    // The caller did it all, and however often it published work, each
+    // other number was handed out once.
+    REQUIRE(sum.load() == 16000);
+    REQUIRE(pool.submitted() == jobs.thread_count() - 1);
+
+    // Run late, the helpers find nothing left and give their numbers back.
+    pool.run();
+    jobs.parallel_for(0, 1000, 10, [&](std::size_t a, std::size_t b) {
+        sum.fetch_add(b - a, std::memory_order_relaxed);
+    });
+    REQUIRE(sum.load() == 17000);
+    REQUIRE(pool.submitted() == 2 * (jobs.thread_count() - 1));
+    pool.run();
+}
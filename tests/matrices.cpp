@@ -2,6 +2,14 @@
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Matrix4.hpp"
 #include "pdmath/Vector4.hpp" 
+#include "pdmath/Matrix4d.hpp"
+#include "pdmath/Matrix.hpp"
+#include "pdmath/Point4.hpp"
+#include "pdmath/Affine3.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/catch_approx.hpp"
@@ -199,4 +207,245 @@ TEST_CASE("Extracting Euler angles from matrices", "[matrices]") {
 
     // REQUIRE(ans1 == Vec3(-3.0892f, -0.1047f, 0.4538f));
     // REQUIRE(ans2 == Vec3(0.0524f, 3.0369f, 2.6878f));
-}
\ No newline at end of file
+}
+TEST_CASE("Euler rotations are built in closed form", "[matrices]") {
+    float tx = 0.7f;
+    float ty = -1.3f;
+    float tz = 2.9f;
+
+    Mat3 rx(1.0f, 0.0f,          0.0f,
+            0.0f, std::cos(tx), -std::sin(tx),
+            0.0f, std::sin(tx),  std::cos(tx));
+    Mat3 ry( std::cos(ty), 0.0f, std::sin(ty),
+             0.0f,         1.0f, 0.0f,
+            -std::sin(ty), 0.0f, std::cos(ty));
+    Mat3 rz(std::cos(tz), -std::sin(tz), 0.0f,
+            std::sin(tz),  std::cos(tz), 0.0f,
+            0.0f,          0.0f,         1.0f);
+
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz) == rx * ry * rz);
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz, RotationOrder::xzy) ==
+            rx * rz * ry);
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz, RotationOrder::yxz) ==
+            ry * rx * rz);
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz, RotationOrder::yzx) ==
+            ry * rz * rx);
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz, RotationOrder::zxy) ==
+            rz * rx * ry);
+    REQUIRE(Mat3::populate_rotation(tx, ty, tz, RotationOrder::zyx) ==
+            rz * ry * rx);
+
+    // A zero angle is an identity, one radian is not.
+    REQUIRE(Mat3::populate_rotation(0.0f, 0.0f, 0.0f) == Mat3::identity);
+    REQUIRE(!(Mat3::populate_rotation(1.0f, 1.0f, 1.0f) == Mat3::identity));
+
+    std::vector<Vec3> thetas;
+    for(int i = 0; i < 37; ++i) {
+        float t = static_cast<float>(i) * 0.37f - 6.0f;
+        thetas.emplace_back(t, -0.5f * t, 0.25f * t + 1.0f);
+    }
+
+    std::array<Accuracy, 3> tiers{Accuracy::exact, Accuracy::high,
+                                  Accuracy::low};
+    std::array<float, 3> tolerances{1.0e-6f, 1.0e-6f, 2.0e-3f};
+
+    for(std::size_t tier = 0; tier < tiers.size(); ++tier) {
+        std::vector<Mat3> batch(thetas.size());
+        Mat3::populate_rotations(thetas, batch, RotationOrder::zxy,
+                                 tiers[tier]);
+
+        float worst = 0.0f;
+        for(std::size_t i = 0; i < thetas.size(); ++i) {
+            Mat3 expected = Mat3::populate_rotation(
+                thetas[i]._x, thetas[i]._y, thetas[i]._z,
+                RotationOrder::zxy);
+
+            for(int r = 0; r < 3; ++r) {
+                for(int c = 0; c < 3; ++c) {
+                    worst = std::max(worst, std::abs(batch[i]._m[r][c] -
+                                                     expected._m[r][c]));
+                }
+            }
+        }
+
+        REQUIRE(worst < tolerances[tier]);
+    }
+}
+
+TEST_CASE("Double precision matrices rebase onto a float origin",
+          "[matrices]") {
+    Mat4d world(Mat4(Mat3::populate_rotation(0.3f, -0.2f, 0.9f)));
+    world.set_translation(Point3d(40000.25, 1200.5, -35000.75));
+
+    Mat4d child(Mat4d::identity);
+    child.set_translation(Point3d(0.5, 0.25, -0.125));
+
+    Mat4d combined = world * child;
+    REQUIRE(combined.get_world_position() ==
+            world * Point3d(0.5, 0.25, -0.125));
+
+    Point3d origin(40000.0, 1200.0, -35000.0);
+    Mat4 relative = world.relative_to(origin);
+
+    REQUIRE(relative.get_world_position() == Vec3(0.25f, 0.5f, -0.75f));
+    REQUIRE(relative._m[0][0] == static_cast<float>(world._m[0][0]));
+    REQUIRE(relative._m[3][3] == 1.0f);
+
+    // rebased float points agree with the double precision transform
+    Point3 local(1.0f, 2.0f, 3.0f);
+    Point3 expected = (world * Point3d(local)).relative_to(origin);
+    REQUIRE((relative * local) == expected);
+
+    std::vector<Mat4d> worlds;
+    for(int i = 0; i < 32; ++i) {
+        Mat4d w(world);
+        w.set_translation(Point3d(40000.0 + i, 1200.0, -35000.0 - i));
+        worlds.push_back(w);
+    }
+
+    std::vector<Mat4> rebased(worlds.size());
+    Mat4d::relative_to(worlds, origin, rebased);
+
+    for(std::size_t i = 0; i < worlds.size(); ++i) {
+        REQUIRE(rebased[i] == worlds[i].relative_to(origin));
+        REQUIRE(rebased[i]._m[0][3] == static_cast<float>(i));
+    }
+}
+
+TEST_CASE("Generic matrices match the fixed size classes", "[matrices]") {
+    constexpr Mat<2, 2, int> m = [] {
+        Mat<2, 2, int> r;
+        r._m[0][0] = 2; r._m[0][1] = 1;
+        r._m[1][0] = 7; r._m[1][1] = 4;
+        return r;
+    }();
+
+    static_assert(m.determinant() == 1);
+    static_assert(m * Mat<2, 2, int>::identity() == m);
+    static_assert(m * Vec2i(1, 1) == Vec2i(3, 11));
+
+    Mat3 m3( 3.0f, -5.0f,  4.0f,
+            -2.0f,  2.0f,  3.0f,
+            -3.0f, -4.0f, -5.0f);
+    REQUIRE(to_mat(m3).determinant() == Catch::Approx(m3.determinant()));
+    REQUIRE(to_mat3(to_mat(m3).inverted()) == m3.inverted());
+
+    Mat4 a(Mat3::populate_rotation(0.3f, -0.2f, 0.9f));
+    a.set_translation(Vec3(1.0f, 2.0f, 3.0f));
+    Mat4 b(Mat3::populate_rotation(-1.1f, 0.4f, 0.2f));
+    b.apply_scale(Vec3(2.0f, 2.0f, 2.0f));
+
+    REQUIRE(to_mat4(to_mat(a) * to_mat(b)) == a * b);
+    REQUIRE(to_mat4(to_mat(a).transposed()) == a.transposed());
+
+    Vec4f p = to_mat(a) * Vec4f(1.0f, -1.0f, 2.0f, 1.0f);
+    Point4 q = a * Point4(1.0f, -1.0f, 2.0f);
+    REQUIRE(p == Vec4f(q._x, q._y, q._z, q._w));
+
+    Mat4x4d wide(to_mat(a));
+    REQUIRE(to_mat4d(wide) == Mat4d(a));
+    REQUIRE((wide * wide.inverted())._m[2][2] == Catch::Approx(1.0));
+}
+
+TEST_CASE("Mat4 products keep the scalar results", "[matrices]") {
+    static_assert(alignof(Mat4) == 16 && alignof(Point4) == 16 &&
+                  alignof(Vec4) == 16);
+
+    Mat4 m(1.0f,  2.0f, -3.0f,  4.5f,
+           0.5f, -1.0f,  2.0f, -2.0f,
+           3.0f,  0.25f, 1.0f,  7.0f,
+           0.0f,  0.0f,  0.5f,  1.0f);
+    Mat4 n = Mat4::identity;
+    n._m[0][1] = 3.0f;
+    n._m[2][3] = -1.5f;
+
+    // Written out by hand so the check doesn't share any code with the
+    // products under test.
+    Mat4 expected;
+    for(int r = 0; r < 4; ++r) {
+        for(int c = 0; c < 4; ++c) {
+            expected._m[r][c] = m._m[r][0] * n._m[0][c] +
+                                m._m[r][1] * n._m[1][c] +
+                                m._m[r][2] * n._m[2][c] +
+                                m._m[r][3] * n._m[3][c];
+        }
+    }
+    REQUIRE(m * n == expected);
+
+    Mat4 product = m;
+    product *= n;
+    REQUIRE(product == expected);
+
+    std::vector<Point4> points;
+    for(int i = 0; i < 9; ++i) {
+        float f = static_cast<float>(i);
+        points.emplace_back(f, 1.0f - f, f * 0.5f, i % 2 ? 1.0f : 0.5f);
+    }
+
+    std::vector<Point4> out(points.size());
+    m.transform(points, out);
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        const Point4 &p = points[i];
+        Point4 single = m * p;
+        Vec4   vec    = m * Vec4(p._x, p._y, p._z, p._w);
+
+        float x = m._m[0][0] * p._x + m._m[0][1] * p._y +
+                  m._m[0][2] * p._z + m._m[0][3] * p._w;
+        float w = m._m[3][0] * p._x + m._m[3][1] * p._y +
+                  m._m[3][2] * p._z + m._m[3][3] * p._w;
+
+        if(!(out[i] == single) || single._x != x || single._w != w ||
+           vec._x != x || vec._w != w) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Affine transforms agree with the Mat4 they came from",
+          "[matrices]") {
+    Mat4 trs(Mat3::populate_rotation(0.4f, -0.9f, 1.3f));
+    trs.apply_scale(Vec3(2.0f, 0.5f, 3.0f));
+    trs.set_translation(Vec3(4.0f, -1.0f, 7.5f));
+
+    Mat4 other(Mat3::populate_rotation(-1.2f, 0.3f, 0.0f));
+    other.set_translation(Vec3(-3.0f, 2.0f, 0.25f));
+
+    Affine3 a(trs);
+    Affine3 b(other);
+
+    REQUIRE(sizeof(Affine3) * 4 == sizeof(Mat4) * 3);
+    REQUIRE(a.to_mat4() == trs);
+    REQUIRE((a * b).to_mat4() == trs * other);
+    REQUIRE(a.inverted_trs().to_mat4() == trs.inverted_trs());
+
+    // The general inverses take different routes, so allow for rounding.
+    Mat4 inverse = a.inverted().to_mat4();
+    Mat4 expected = trs.inverted();
+    std::size_t mismatches = 0;
+    for(std::size_t r = 0; r < 4; ++r) {
+        for(std::size_t c = 0; c < 4; ++c) {
+            if(inverse._m[r][c] !=
+               Catch::Approx(expected._m[r][c]).margin(1e-6)) {
+                ++mismatches;
+            }
+        }
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(a * a.inverted() == Affine3::identity);
+    REQUIRE(Affine3(a.linear(), a.get_world_position()) == a);
+    REQUIRE(a.get_y_scale() == Catch::Approx(trs.get_y_scale()));
+
+    Point3 p(1.5f, -2.0f, 0.75f);
+    Vec3   v(0.5f, 1.0f, -2.0f);
+    REQUIRE(a * p == trs * p);
+    REQUIRE(a * v == trs * v);
+    REQUIRE(a * Point4(p._x, p._y, p._z, 1.0f) ==
+            trs * Point4(p._x, p._y, p._z, 1.0f));
+
+    Mat4 singular = Mat4::identity;
+    singular._m[1][1] = 0.0f;
+    REQUIRE(Affine3(singular).inverted() == Affine3());
+}
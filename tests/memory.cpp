@@ -0,0 +1,280 @@
+#include "pdmath/FrameArena.hpp"
+#include "pdmath/Pool.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/OBBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/ShadowCascades.hpp"
+#include "pdmath/Camera.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numbers>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+/*------------------------------------------------------------------------------
+    Every heap allocation in the test binary goes through here: replacing
+    the global operator new and delete in this file replaces them for the
+    whole executable, every test file and Catch included. Counting is off
+    unless an AllocationCount is alive on the calling thread, so Catch and
+    the other tests aren't affected.
+
+    MSVC has no std::aligned_alloc, and its _aligned_malloc blocks have to go
+    back through _aligned_free, so the aligned deletes hand their alignment
+    to release() to make the same choice counted() did.
+------------------------------------------------------------------------------*/
+namespace {
+
+thread_local bool        counting    = false;
+thread_local std::size_t allocations = 0;
+
+void* counted(const std::size_t bytes, const std::size_t align) {
+    if(counting) {
+        ++allocations;
+    }
+
+    std::size_t size = bytes == 0 ? 1 : bytes;
+    void *p = nullptr;
+    if(align <= alignof(std::max_align_t)) {
+        p = std::malloc(size);
+    }
+    else {
+#if defined(_MSC_VER)
+        p = _aligned_malloc(size, align);
+#else
+        p = std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+#endif
+    }
+    if(!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void release(void *p, const std::align_val_t align) {
+#if defined(_MSC_VER)
+    if(static_cast<std::size_t>(align) > alignof(std::max_align_t)) {
+        _aligned_free(p);
+        return;
+    }
+#else
+    static_cast<void>(align);
+#endif
+    std::free(p);
+}
+
+class AllocationCount {
+public:
+    inline std::size_t value() const { return allocations - _start; }
+
+    AllocationCount() : _start{allocations} { counting = true; }
+    ~AllocationCount() { counting = false; }
+
+private:
+    std::size_t _start;
+};
+
+} // namespace
+
+void* operator new(std::size_t bytes) {
+    return counted(bytes, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t bytes) {
+    return counted(bytes, alignof(std::max_align_t));
+}
+void* operator new(std::size_t bytes, std::align_val_t align) {
+    return counted(bytes, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t bytes, std::align_val_t align) {
+    return counted(bytes, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t align) noexcept {
+    release(p, align);
+}
+void operator delete[](void *p, std::align_val_t align) noexcept {
+    release(p, align);
+}
+void operator delete(void *p, std::size_t, std::align_val_t align) noexcept {
+    release(p, align);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t align) noexcept {
+    release(p, align);
+}
+
+namespace {
+
+struct Pair {
+    uint32_t a;
+    uint32_t b;
+};
+
+Mat4 placed_at(const float x) {
+    Mat4 world = Mat4::identity;
+    world.set_translation(Vec3(x, 0.0f, 0.0f));
+    return world;
+}
+
+} // namespace
+
+TEST_CASE("Pool handles go stale when their object is destroyed",
+          "[memory]") {
+    Pool<AABBox> pool;
+
+    Handle<AABBox> a = pool.create(Point3(0.0f, 0.0f, 0.0f),
+                                   Point3(1.0f, 1.0f, 1.0f));
+    Handle<AABBox> b = pool.create(Point3(2.0f, 2.0f, 2.0f),
+                                   Point3(3.0f, 3.0f, 3.0f));
+    Handle<AABBox> c = pool.create(Point3(4.0f, 4.0f, 4.0f),
+                                   Point3(5.0f, 5.0f, 5.0f));
+    REQUIRE(pool.size() == 3);
+
+    // c moves into a's place; its handle still finds it.
+    pool.destroy(a);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(pool.get(a) == nullptr);
+    REQUIRE(pool.get(c) != nullptr);
+    REQUIRE(pool.get(c)->min()._x == 4.0f);
+    REQUIRE(pool.get(b)->min()._x == 2.0f);
+
+    // The freed slot is reused under a new generation.
+    Handle<AABBox> d = pool.create(Point3(6.0f, 6.0f, 6.0f),
+                                   Point3(7.0f, 7.0f, 7.0f));
+    REQUIRE(d._index == a._index);
+    REQUIRE(d != a);
+    REQUIRE(pool.get(a) == nullptr);
+    REQUIRE(pool.get(d)->min()._x == 6.0f);
+
+    // items() stays packed and handle(i) maps back to each one.
+    REQUIRE(pool.items().size() == 3);
+    for(std::size_t i = 0; i < pool.size(); ++i) {
+        REQUIRE(pool.get(pool.handle(i)) == &pool.items()[i]);
+    }
+
+    pool.destroy(a);
+    REQUIRE(pool.size() == 3);
+
+    pool.clear();
+    REQUIRE(pool.size() == 0);
+    REQUIRE(pool.get(b) == nullptr);
+    REQUIRE(pool.get(Handle<AABBox>()) == nullptr);
+}
+
+TEST_CASE("Frame arenas align, grow and fold back into one block",
+          "[memory]") {
+    FrameArena arena(1024);
+
+    auto bytes  = arena.allocate<uint8_t>(3);
+    auto floats = arena.allocate<float>(5);
+    auto *wide  = arena.allocate(16, 64);
+    REQUIRE(bytes.size() == 3);
+    REQUIRE(reinterpret_cast<uintptr_t>(floats.data()) % alignof(float) == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(wide) % 64 == 0);
+    REQUIRE(arena.block_count() == 1);
+
+    // Past the first block, a second one is taken...
+    arena.allocate<float>(1000);
+    REQUIRE(arena.block_count() == 2);
+    REQUIRE(arena.capacity() > 1024);
+
+    // ...and after a reset, one block holds all of it.
+    std::size_t capacity = arena.capacity();
+    arena.reset();
+    REQUIRE(arena.block_count() == 1);
+    REQUIRE(arena.capacity() == capacity);
+    REQUIRE(arena.used() == 0);
+
+    ArenaVector<Pair> pairs{ArenaAllocator<Pair>(arena)};
+    for(uint32_t i = 0; i < 100; ++i) {
+        pairs.push_back({i, i + 1});
+    }
+    REQUIRE(pairs[99].b == 100);
+    REQUIRE(arena.block_count() == 1);
+}
+
+TEST_CASE("Steady state frames make no heap allocations", "[memory]") {
+    FrameArena    arena(4096);
+    Pool<AABBox>  boxes(64);
+    Pool<OBBox>   oriented(64);
+    Pool<BSphere> spheres(64);
+
+    Camera camera(Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, 0.0f),
+                  Vec3(0.0f, 1.0f, 0.0f));
+    camera.set_persp(1.0f, 200.0f, 1280.0f, 720.0f,
+                     std::numbers::pi_v<float> / 3.0f, 1.0f);
+    ShadowCascades cascades(4, 0.7f, 1024.0f, 50.0f);
+    cascades.fit(camera, Vec3(-1.0f, -2.0f, -0.5f));
+
+    // A frame of churn: objects come and go, a broadphase style pass
+    // collects overlapping pairs into the arena and culling writes its
+    // masks there too.
+    auto frame = [&](const int n) {
+        arena.reset();
+
+        Handle<AABBox> box = boxes.create(Point3(0.0f, 0.0f, 0.0f),
+                                          Point3(1.0f, 1.0f, 1.0f));
+        Handle<BSphere> sphere = spheres.create(Point3(0.0f, 0.0f, 0.0f),
+                                                1.0f, placed_at(0.5f));
+        for(int i = 0; i < 32; ++i) {
+            float x = static_cast<float>((i + n) % 16);
+            oriented.create(Point3(-1.0f, -1.0f, -1.0f),
+                            Point3(1.0f, 1.0f, 1.0f), placed_at(x));
+            spheres.create(Point3(0.0f, 0.0f, 0.0f), 1.0f, placed_at(x));
+        }
+
+        ArenaVector<Pair> pairs{ArenaAllocator<Pair>(arena)};
+        auto obbs = oriented.items();
+        for(uint32_t i = 0; i < obbs.size(); ++i) {
+            for(uint32_t j = i + 1; j < obbs.size(); ++j) {
+                if(obbs[i].collides(obbs[j])) {
+                    pairs.push_back({i, j});
+                }
+            }
+        }
+
+        auto masks = arena.allocate<uint32_t>(spheres.size());
+        cascades.cull(spheres.items(), masks);
+
+        boxes.destroy(box);
+        spheres.destroy(sphere);
+        oriented.clear();
+        while(spheres.size() > 0) {
+            spheres.destroy(spheres.handle(spheres.size() - 1));
+        }
+
+        return pairs.size();
+    };
+
+    // The first frames size the pools and the arena.
+    std::size_t warm = 0;
+    for(int n = 0; n < 3; ++n) {
+        warm += frame(n);
+    }
+    REQUIRE(warm > 0);
+
+    std::size_t pairs = 0;
+    std::size_t count;
+    {
+        AllocationCount allocations;
+        for(int n = 3; n < 20; ++n) {
+            pairs += frame(n);
+        }
+        count = allocations.value();
+    }
+
+    REQUIRE(pairs > 0);
+    REQUIRE(count == 0);
+}
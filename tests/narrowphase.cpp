@@ -0,0 +1,155 @@
+#include "pdmath/Narrowphase.hpp"
+#include "pdmath/FrameArena.hpp"
+#include "pdmath/JobSystem.hpp"
+
+#include "../bench/scene.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <vector>
+
+namespace {
+
+// The plain one-pair-at-a-time version, with the shapes in the order the
+// pair lists them.
+bool reference(const Colliders &c, const ShapeRef &a, const ShapeRef &b) {
+    auto as_obb = [](const AABBox &box) {
+        return OBBox(box.min(), box.max(), Mat4::identity);
+    };
+
+    switch(a.type) {
+        case Shape::sphere: {
+            const BSphere &s = c.spheres[a.index];
+            switch(b.type) {
+                case Shape::sphere: return s.collides(c.spheres[b.index]);
+                case Shape::aabb:   return s.collides(c.aabbs[b.index]);
+                case Shape::obb:    return s.collides(c.obbs[b.index]);
+                case Shape::line:   return s.collides(c.lines[b.index]);
+                case Shape::plane:  return s.collides(c.planes[b.index]);
+            }
+            break;
+        }
+        case Shape::aabb: {
+            const AABBox &box = c.aabbs[a.index];
+            switch(b.type) {
+                case Shape::aabb:  return box.collides(c.aabbs[b.index]);
+                case Shape::obb:   return as_obb(box).collides(c.obbs[b.index]);
+                case Shape::line:  return box.collides(c.lines[b.index]);
+                case Shape::plane:
+                    return as_obb(box).collides(c.planes[b.index]);
+                default: break;
+            }
+            break;
+        }
+        case Shape::obb: {
+            const OBBox &box = c.obbs[a.index];
+            switch(b.type) {
+                case Shape::obb:   return box.collides(c.obbs[b.index]);
+                case Shape::line:  return box.collides(c.lines[b.index]);
+                case Shape::plane: return box.collides(c.planes[b.index]);
+                default: break;
+            }
+            break;
+        }
+        case Shape::line: {
+            const Line &line = c.lines[a.index];
+            switch(b.type) {
+                case Shape::line:  return line.collides(c.lines[b.index]);
+                case Shape::plane: return line.collides(c.planes[b.index]);
+                default: break;
+            }
+            break;
+        }
+        case Shape::plane:
+            break;
+    }
+
+    // Everything else is the same test with the shapes swapped.
+    return reference(c, b, a);
+}
+
+} // namespace
+
+TEST_CASE("Narrowphase matches testing pairs one at a time",
+          "[narrowphase][collisions]") {
+    const bench::Scene scene(128, 11);
+    Colliders colliders{scene.spheres, scene.aabbs, scene.obbs,
+                        scene.lines, scene.planes};
+
+    // Every combination except plane against plane, both ways round,
+    // interleaved the way a broadphase would hand them over.
+    std::vector<CollisionPair> pairs;
+    bench::Lcg lcg(3);
+    for(uint32_t i = 0; i < 20000; ++i) {
+        auto a = static_cast<Shape>(lcg.next() % 5);
+        auto b = static_cast<Shape>(lcg.next() % 5);
+        if(a == Shape::plane && b == Shape::plane) {
+            continue;
+        }
+        pairs.push_back({{a, lcg.next() % 128}, {b, lcg.next() % 128}});
+    }
+
+    JobSystem jobs(4);
+    FrameArena arena(pairs.size());
+    auto hits = arena.allocate<uint8_t>(pairs.size());
+
+    Narrowphase narrowphase(jobs);
+    narrowphase.run(colliders, pairs, hits);
+
+    std::size_t mismatches = 0;
+    std::size_t hit_count  = 0;
+    for(std::size_t i = 0; i < pairs.size(); ++i) {
+        bool expected = reference(colliders, pairs[i].a, pairs[i].b);
+        if(hits[i] != (expected ? 1 : 0)) {
+            ++mismatches;
+        }
+        hit_count += hits[i];
+    }
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(hit_count > 0);
+    REQUIRE(hit_count < pairs.size());
+
+    std::size_t bucketed = 0;
+    for(std::size_t a = 0; a < shape_count; ++a) {
+        for(std::size_t b = a; b < shape_count; ++b) {
+            bucketed += narrowphase.bucket_size(static_cast<Shape>(a),
+                                                static_cast<Shape>(b));
+        }
+    }
+    REQUIRE(bucketed == pairs.size());
+    REQUIRE(narrowphase.bucket_size(Shape::obb, Shape::sphere) ==
+            narrowphase.bucket_size(Shape::sphere, Shape::obb));
+    REQUIRE(narrowphase.bucket_size(Shape::plane, Shape::plane) == 0);
+}
+
+TEST_CASE("Narrowphase planes meet unless parallel and apart",
+          "[narrowphase][collisions]") {
+    std::vector<Plane> planes = {
+        Plane(Point3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)),
+        Plane(Point3(0.0f, 5.0f, 0.0f), Vec3(0.0f, 2.0f, 0.0f)),
+        Plane(Point3(3.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 0.0f)),
+        Plane(Point3(7.0f, 0.0f, 2.0f), Vec3(0.0f, -3.0f, 0.0f))
+    };
+    Colliders colliders;
+    colliders.planes = planes;
+
+    std::vector<CollisionPair> pairs = {
+        {{Shape::plane, 0}, {Shape::plane, 1}},
+        {{Shape::plane, 0}, {Shape::plane, 2}},
+        {{Shape::plane, 0}, {Shape::plane, 3}},
+        {{Shape::plane, 1}, {Shape::plane, 2}}
+    };
+    std::vector<uint8_t> hits(pairs.size(), 2);
+
+    Narrowphase narrowphase;
+    narrowphase.run(colliders, pairs, hits);
+
+    REQUIRE(hits[0] == 0);
+    REQUIRE(hits[1] == 1);
+    REQUIRE(hits[2] == 1);
+    REQUIRE(hits[3] == 1);
+}
@@ -0,0 +1,108 @@
+#include "pdmath/OcclusionBuffer.hpp"
+#include "pdmath/Camera.hpp"
+#include "pdmath/AABBox.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/Point4.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+#include <numbers>
+
+using namespace pdm;
+using namespace Catch;
+
+static Camera occlusion_camera() {
+    Camera camera(Vec3(0.0f, 0.0f, 10.0f),  // position
+                  Vec3(0.0f, 0.0f, 0.0f),   // target
+                  Vec3(0.0f, 1.0f, 0.0f));  // up vector
+    camera.set_persp(1.0f, 100.0f, 1280.0f, 720.0f,
+                     std::numbers::pi_v<float> / 4.0f, 1.0f);
+    return camera;
+}
+
+static void add_wall(OcclusionBuffer &buffer, float half_size, float z) {
+    buffer.add_occluder(Point3(-half_size, -half_size, z),
+                        Point3( half_size, -half_size, z),
+                        Point3( half_size,  half_size, z));
+    buffer.add_occluder(Point3(-half_size, -half_size, z),
+                        Point3( half_size,  half_size, z),
+                        Point3(-half_size,  half_size, z));
+}
+
+TEST_CASE("Occlusion buffer rasterizes occluders", "[occlusion]") {
+    Camera camera = occlusion_camera();
+    OcclusionBuffer buffer(256, 128, 4);
+
+    add_wall(buffer, 2.0f, 0.0f);
+    buffer.rasterize(camera);
+
+    REQUIRE(buffer.occluder_count() == 2);
+
+    // The wall sits in the middle of the view and is 10 units away, so the
+    // center pixel takes its depth while the corners stay empty.
+    float wall_depth = camera.persp_screen(Point4(0.0f, 0.0f, 0.0f))._z;
+    REQUIRE(buffer.depth(128, 64) == Catch::Approx(wall_depth));
+    REQUIRE(buffer.depth(0, 0) > 1.0f);
+    REQUIRE(buffer.tile_depth(0, 0) > 1.0f);
+}
+
+TEST_CASE("Occlusion buffer gives identical results across thread counts",
+          "[occlusion]") {
+    Camera camera = occlusion_camera();
+    OcclusionBuffer single(256, 128, 1);
+    OcclusionBuffer multi(256, 128, 8);
+
+    for(float z = -3.0f; z <= 0.0f; z += 1.0f) {
+        add_wall(single, 1.0f - z * 0.5f, z);
+        add_wall(multi,  1.0f - z * 0.5f, z);
+    }
+
+    single.rasterize(camera);
+    multi.rasterize(camera);
+
+    uint32_t mismatches = 0;
+    for(uint32_t y = 0; y < single.height(); ++y) {
+        for(uint32_t x = 0; x < single.width(); ++x) {
+            if(single.depth(x, y) != multi.depth(x, y)) {
+                ++mismatches;
+            }
+        }
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Occlusion buffer culls boxes and spheres behind occluders",
+          "[occlusion][collisions]") {
+    Camera camera = occlusion_camera();
+    OcclusionBuffer buffer(256, 128);
+
+    add_wall(buffer, 3.0f, 0.0f);
+    buffer.rasterize(camera);
+
+    AABBox hidden(Point3(-0.5f, -0.5f, -3.0f), Point3(0.5f, 0.5f, -2.0f));
+    AABBox in_front(Point3(-0.5f, -0.5f, 2.0f), Point3(0.5f, 0.5f, 3.0f));
+    AABBox beside(Point3(6.0f, -0.5f, -3.0f), Point3(7.0f, 0.5f, -2.0f));
+    AABBox straddling(Point3(2.5f, -0.5f, -3.0f), Point3(4.5f, 0.5f, -2.0f));
+
+    REQUIRE(buffer.visible(camera, hidden) == false);
+    REQUIRE(buffer.visible(camera, in_front) == true);
+    REQUIRE(buffer.visible(camera, beside) == true);
+    REQUIRE(buffer.visible(camera, straddling) == true);
+
+    Mat4 world(Mat4::identity);
+    world.set_translation(Vec3(0.0f, 0.0f, -5.0f));
+    BSphere hidden_sphere(Point3(0.0f, 0.0f, 0.0f), 1.0f, world);
+
+    world.set_translation(Vec3(0.0f, 0.0f, 5.0f));
+    BSphere visible_sphere(Point3(0.0f, 0.0f, 0.0f), 1.0f, world);
+
+    REQUIRE(buffer.visible(camera, hidden_sphere) == false);
+    REQUIRE(buffer.visible(camera, visible_sphere) == true);
+
+    // Anything crossing the near plane can't be bounded, so it stays visible.
+    AABBox around_camera(Point3(-1.0f, -1.0f, 9.0f), Point3(1.0f, 1.0f, 11.0f));
+    REQUIRE(buffer.visible(camera, around_camera) == true);
+}
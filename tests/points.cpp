@@ -1,4 +1,5 @@
 #include "pdmath/Point3.hpp"
+#include "pdmath/Point3d.hpp"
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Line.hpp"
 #include "pdmath/Plane.hpp"
@@ -66,3 +67,23 @@ TEST_CASE("Point3s know how far they are from a plane", "[Point3s]") {
     REQUIRE(test_point.distance_to_plane(plane) ==
             Catch::Approx(-2.0f).margin(float_epsilon));
 }
+
+TEST_CASE("Double precision points keep detail far from the origin",
+          "[points]") {
+    Point3d origin(25000.125, -18000.5, 31000.0);
+    Point3d p = origin + Vec3(0.001f, 0.002f, -0.003f);
+
+    Point3 relative = p.relative_to(origin);
+    REQUIRE(relative._x == Catch::Approx(0.001f).epsilon(1.0e-3));
+    REQUIRE(relative._y == Catch::Approx(0.002f).epsilon(1.0e-3));
+    REQUIRE(relative._z == Catch::Approx(-0.003f).epsilon(1.0e-3));
+
+    // the same offset in float is lost entirely at this distance
+    Point3 origin_f(25000.125f, -18000.5f, 31000.0f);
+    Point3 p_f = origin_f + Vec3(0.001f, 0.002f, -0.003f);
+    REQUIRE((p_f - origin_f)._x != Catch::Approx(0.001f).epsilon(1.0e-3));
+
+    p -= Vec3(0.001f, 0.002f, -0.003f);
+    REQUIRE(Point3d(origin._x, origin._y, origin._z) ==
+            Point3d(p._x, p._y, p._z));
+}
@@ -0,0 +1,82 @@
+#include "pdmath/profile.hpp"
+#include "pdmath/TransformHierarchy.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Quaternion.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::size_t occurrences(const std::string &text, const std::string &what) {
+    std::size_t count = 0;
+    for(std::size_t at = text.find(what); at != std::string::npos;
+        at = text.find(what, at + what.size())) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Profiling zones export as a Chrome trace", "[profile]") {
+    profile::clear();
+    profile::set_thread_name("test main");
+
+    {
+        PDMATH_ZONE("outer");
+        for(int i = 0; i < 3; ++i) {
+            PDMATH_ZONE("inner");
+        }
+    }
+
+    std::thread worker([] {
+        profile::set_thread_name("test worker");
+        PDMATH_ZONE("worker");
+    });
+    worker.join();
+
+    TransformHierarchy hierarchy(1);
+    hierarchy.add_node(TransformHierarchy::no_parent, Vec3(1.0f, 0.0f, 0.0f),
+                       Quat(0.0f, Vec3(0.0f, 1.0f, 0.0f)),
+                       Vec3(1.0f, 1.0f, 1.0f));
+    hierarchy.update();
+
+    // Nothing is recorded while recording is off.
+    profile::set_recording(false);
+    {
+        PDMATH_ZONE("ignored");
+    }
+    profile::set_recording(true);
+
+    std::ostringstream trace;
+    profile::write_chrome_trace(trace);
+    std::string json = trace.str();
+
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.back() == '\n');
+
+    if constexpr(profile::compiled_in) {
+        CHECK(occurrences(json, "\"name\": \"outer\"") == 1);
+        CHECK(occurrences(json, "\"name\": \"inner\"") == 3);
+        CHECK(occurrences(json, "\"name\": \"worker\"") == 1);
+        CHECK(occurrences(json, "\"name\": \"ignored\"") == 0);
+        CHECK(occurrences(json, "TransformHierarchy::update\"") == 1);
+        CHECK(occurrences(json, "\"name\": \"test worker\"") == 1);
+
+        // The worker's zones outlive it until the next clear().
+        profile::clear();
+        std::ostringstream empty;
+        profile::write_chrome_trace(empty);
+        CHECK(occurrences(empty.str(), "\"ph\": \"X\"") == 0);
+    }
+    else {
+        CHECK(occurrences(json, "\"ph\"") == 0);
+    }
+}
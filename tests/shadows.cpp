@@ -0,0 +1,123 @@
+#include "pdmath/ShadowCascades.hpp"
+#include "pdmath/Camera.hpp"
+#include "pdmath/BSphere.hpp"
+#include "pdmath/Point4.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using namespace pdm;
+using namespace Catch;
+
+static Camera shadow_camera(const Vec3 &position) {
+    Camera camera(position,                          // position
+                  position + Vec3(0.0f, 0.0f, -1.0f), // target
+                  Vec3(0.0f, 1.0f, 0.0f));           // up vector
+    camera.set_persp(1.0f, 200.0f, 1280.0f, 720.0f,
+                     std::numbers::pi_v<float> / 3.0f, 1.0f);
+    return camera;
+}
+
+TEST_CASE("Cascade splits blend linear and logarithmic schemes",
+          "[shadows]") {
+    std::array<float, 5> linear;
+    std::array<float, 5> logarithmic;
+    std::array<float, 5> blended;
+
+    ShadowCascades::split_distances(1.0f, 81.0f, 0.0f, linear);
+    ShadowCascades::split_distances(1.0f, 81.0f, 1.0f, logarithmic);
+    ShadowCascades::split_distances(1.0f, 81.0f, 0.5f, blended);
+
+    REQUIRE(linear[1] == Catch::Approx(21.0f));
+    REQUIRE(linear[2] == Catch::Approx(41.0f));
+    REQUIRE(logarithmic[1] == Catch::Approx(3.0f));
+    REQUIRE(logarithmic[2] == Catch::Approx(9.0f));
+    REQUIRE(logarithmic[3] == Catch::Approx(27.0f));
+    REQUIRE(blended[2] == Catch::Approx(25.0f));
+
+    REQUIRE(blended[0] == 1.0f);
+    REQUIRE(blended[4] == 81.0f);
+}
+
+TEST_CASE("Cascades enclose their slice of the view frustum", "[shadows]") {
+    Camera camera = shadow_camera(Vec3(3.0f, 2.0f, 5.0f));
+    ShadowCascades cascades(4, 0.7f, 1024.0f, 50.0f);
+
+    cascades.fit(camera, Vec3(-1.0f, -2.0f, -0.5f));
+    REQUIRE(cascades.count() == 4);
+
+    for(std::size_t i = 0; i < cascades.count(); ++i) {
+        Mat4 light_ndc = cascades.light_ndc(i);
+
+        auto corners = camera.frustum_corners(cascades.split_near(i),
+                                              cascades.split_far(i));
+        for(const Point3 &corner : corners) {
+            Point4 ndc = light_ndc * Point4(corner);
+
+            REQUIRE(std::abs(ndc._x) <= 1.0001f);
+            REQUIRE(std::abs(ndc._y) <= 1.0001f);
+            REQUIRE(std::abs(ndc._z) <= 1.0001f);
+        }
+    }
+}
+
+TEST_CASE("Cascades only move in whole shadow map texels", "[shadows]") {
+    ShadowCascades before(3, 0.5f, 512.0f, 0.0f);
+    ShadowCascades after(3, 0.5f, 512.0f, 0.0f);
+    Vec3 light_dir(0.3f, -1.0f, 0.2f);
+
+    before.fit(shadow_camera(Vec3(0.0f, 0.0f, 0.0f)), light_dir);
+    after.fit(shadow_camera(Vec3(0.37f, 0.0f, 0.11f)), light_dir);
+
+    for(std::size_t i = 0; i < before.count(); ++i) {
+        Mat4 a = before.light(i).ortho_ndc();
+        Mat4 b = after.light(i).ortho_ndc();
+
+        // same box size, so the texel size is unchanged
+        REQUIRE(a._m[0][0] == b._m[0][0]);
+
+        float texel = 2.0f / (a._m[0][0] * 512.0f);
+        float left_a = -(a._m[0][3] + 1.0f) / a._m[0][0];
+        float left_b = -(b._m[0][3] + 1.0f) / b._m[0][0];
+        float shift  = (left_b - left_a) / texel;
+
+        REQUIRE(std::abs(shift - std::round(shift)) < 0.01f);
+    }
+}
+
+TEST_CASE("Shadow casters are culled per cascade in one pass", "[shadows]") {
+    Camera camera = shadow_camera(Vec3(0.0f, 0.0f, 0.0f));
+    ShadowCascades cascades(3, 0.5f, 1024.0f, 100.0f);
+
+    // straight down, so "toward the light" is +y
+    cascades.fit(camera, Vec3(0.0f, -1.0f, 0.0f));
+
+    std::vector<BSphere> casters;
+    Mat4 world(Mat4::identity);
+
+    world.set_translation(Vec3(0.0f, 0.0f, -2.0f));   // first slice
+    casters.emplace_back(Point3(0.0f, 0.0f, 0.0f), 0.5f, world);
+    world.set_translation(Vec3(0.0f, 40.0f, -2.0f));  // above it, in range
+    casters.emplace_back(Point3(0.0f, 0.0f, 0.0f), 0.5f, world);
+    world.set_translation(Vec3(0.0f, 400.0f, -2.0f)); // past the extrusion
+    casters.emplace_back(Point3(0.0f, 0.0f, 0.0f), 0.5f, world);
+    world.set_translation(Vec3(0.0f, 0.0f, 500.0f));  // behind the camera
+    casters.emplace_back(Point3(0.0f, 0.0f, 0.0f), 0.5f, world);
+    world.set_translation(Vec3(0.0f, 0.0f, -150.0f)); // last slice
+    casters.emplace_back(Point3(0.0f, 0.0f, 0.0f), 0.5f, world);
+
+    std::vector<uint32_t> masks(casters.size());
+    cascades.cull(casters, masks);
+
+    REQUIRE((masks[0] & 1u) != 0);
+    REQUIRE((masks[1] & 1u) != 0);
+    REQUIRE(masks[2] == 0);
+    REQUIRE(masks[3] == 0);
+    REQUIRE((masks[4] & 4u) != 0);
+    REQUIRE((masks[4] & 1u) == 0);
+}
@@ -0,0 +1,175 @@
+#include "pdmath/Skinning.hpp"
+#include "pdmath/DualQuaternion.hpp"
+#include "pdmath/Quaternion.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/AABBox.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+// 19 vertices so the last block is a partial one.
+struct Mesh {
+    std::vector<float> x, y, z;
+    std::vector<uint16_t> bones[max_influences];
+    std::vector<float>    weights[max_influences];
+
+    std::vector<float> out_x, out_y, out_z;
+
+    Mesh() {
+        for(int i = 0; i < 19; ++i) {
+            x.push_back(static_cast<float>(i % 5) - 2.0f);
+            y.push_back(static_cast<float>(i) * 0.25f);
+            z.push_back(static_cast<float>(i % 3));
+
+            float blend = static_cast<float>(i) / 18.0f;
+            bones[0].push_back(0);
+            bones[1].push_back(1);
+            bones[2].push_back(0);
+            bones[3].push_back(0);
+            weights[0].push_back(1.0f - blend);
+            weights[1].push_back(blend);
+            weights[2].push_back(0.0f);
+            weights[3].push_back(0.0f);
+        }
+
+        out_x.resize(x.size());
+        out_y.resize(x.size());
+        out_z.resize(x.size());
+    }
+
+    SkinStream in() const {
+        return SkinStream{x, y, z,
+                          {bones[0], bones[1], bones[2], bones[3]},
+                          {weights[0], weights[1], weights[2], weights[3]}};
+    }
+
+    SkinnedStream out() {
+        return SkinnedStream{out_x, out_y, out_z};
+    }
+};
+
+} // namespace
+
+TEST_CASE("Dual quaternions hold rigid transforms", "[skinning]") {
+    Quat rotation(std::numbers::pi_v<float> / 3.0f, Vec3(1.0f, 2.0f, 0.5f));
+    Vec3 translation(3.0f, -1.0f, 2.0f);
+
+    DualQuat d(rotation, translation);
+    REQUIRE(d.translation() == translation);
+
+    Mat4 m = rotation.to_mat4();
+    m.set_translation(translation);
+    REQUIRE(d.to_mat4() == m);
+
+    Point3 p(1.0f, 2.0f, 3.0f);
+    REQUIRE(d.transform(p) == m * p);
+    REQUIRE(DualQuat::identity.transform(p) == p);
+}
+
+TEST_CASE("Linear blend skinning blends the palette", "[skinning]") {
+    Mesh mesh;
+
+    Mat4 bend = Quat(std::numbers::pi_v<float> / 4.0f,
+                     Vec3(0.0f, 0.0f, 1.0f)).to_mat4();
+    bend.set_translation(Vec3(0.0f, 4.0f, 0.0f));
+
+    std::vector<Mat4> palette{Mat4::identity, bend};
+
+    AABBox bounds = skin_linear(mesh.in(), palette, mesh.out());
+
+    int mismatches = 0;
+    float min_x = mesh.out_x[0];
+    float max_y = mesh.out_y[0];
+
+    for(std::size_t i = 0; i < mesh.x.size(); ++i) {
+        Point3 p(mesh.x[i], mesh.y[i], mesh.z[i]);
+        Point3 expected = (mesh.weights[0][i] * Mat4::identity +
+                           mesh.weights[1][i] * bend) * p;
+
+        if(!(Point3(mesh.out_x[i], mesh.out_y[i], mesh.out_z[i]) ==
+             expected)) {
+            ++mismatches;
+        }
+
+        min_x = std::min(min_x, mesh.out_x[i]);
+        max_y = std::max(max_y, mesh.out_y[i]);
+    }
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(bounds.min()._x == Catch::Approx(min_x));
+    REQUIRE(bounds.max()._y == Catch::Approx(max_y));
+}
+
+TEST_CASE("Dual quaternion skinning matches rigid bones", "[skinning]") {
+    Mesh mesh;
+
+    Quat rotation(std::numbers::pi_v<float> / 2.0f, Vec3(0.0f, 1.0f, 0.0f));
+    Vec3 translation(1.0f, 2.0f, 3.0f);
+
+    // Same transform on both bones, with the second one's sign flipped:
+    // the blend has to treat q and -q as the same rotation.
+    DualQuat bone(rotation, translation);
+    DualQuat flipped = bone;
+    flipped._real = Quat(-bone._real._w, -bone._real._v._x,
+                         -bone._real._v._y, -bone._real._v._z);
+    flipped._dual = Quat(-bone._dual._w, -bone._dual._v._x,
+                         -bone._dual._v._y, -bone._dual._v._z);
+
+    std::vector<DualQuat> dq_palette{bone, flipped};
+    std::vector<Mat4>     lbs_palette{bone.to_mat4(), bone.to_mat4()};
+
+    Mesh linear;
+    AABBox dq_bounds  = skin_dual_quat(mesh.in(), dq_palette, mesh.out());
+    AABBox lbs_bounds = skin_linear(linear.in(), lbs_palette, linear.out());
+
+    int mismatches = 0;
+    for(std::size_t i = 0; i < mesh.x.size(); ++i) {
+        Point3 dq(mesh.out_x[i], mesh.out_y[i], mesh.out_z[i]);
+        Point3 lbs(linear.out_x[i], linear.out_y[i], linear.out_z[i]);
+
+        // Two different float paths; allow a few ulps at this magnitude.
+        Vec3 diff = dq - lbs;
+        if(diff.length() > 1.0e-5f) {
+            ++mismatches;
+        }
+    }
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(dq_bounds.min() == lbs_bounds.min());
+    REQUIRE(dq_bounds.max() == lbs_bounds.max());
+}
+
+TEST_CASE("Dual quaternion skinning keeps length through a twist",
+          "[skinning]") {
+    Mesh mesh;
+
+    DualQuat still = DualQuat::identity;
+    DualQuat twist(Quat(std::numbers::pi_v<float>, Vec3(0.0f, 1.0f, 0.0f)),
+                   Vec3(0.0f, 0.0f, 0.0f));
+
+    std::vector<DualQuat> dq_palette{still, twist};
+    std::vector<Mat4>     lbs_palette{still.to_mat4(), twist.to_mat4()};
+
+    Mesh linear;
+    skin_dual_quat(mesh.in(), dq_palette, mesh.out());
+    skin_linear(linear.in(), lbs_palette, linear.out());
+
+    // Halfway through a half turn about y, blended matrices collapse the
+    // vertex toward the axis while the dual quaternion keeps its distance.
+    std::size_t mid = 9;
+    float radius = std::hypot(mesh.x[mid], mesh.z[mid]);
+
+    REQUIRE(std::hypot(mesh.out_x[mid], mesh.out_z[mid]) ==
+            Catch::Approx(radius));
+    REQUIRE(std::hypot(linear.out_x[mid], linear.out_z[mid]) < radius);
+}
@@ -0,0 +1,283 @@
+#include "pdmath/Vec3Stream.hpp"
+#include "pdmath/Vector3.hpp"
+#include "pdmath/Point3.hpp"
+#include "pdmath/Matrix3.hpp"
+#include "pdmath/Matrix4.hpp"
+#include "pdmath/cpu.hpp"
+
+#include "kernels/kernels.hpp"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+using namespace pdm;
+using namespace Catch;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+std::vector<Vec3> make_vectors(const std::size_t count) {
+    std::vector<Vec3> v;
+    for(std::size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        v.emplace_back(std::sin(f) * 4.0f + 0.5f,
+                       std::cos(f * 0.7f) * 3.0f - 1.0f,
+                       f * 0.01f + 0.25f);
+    }
+    return v;
+}
+
+struct Vertex {
+    Vec3  position;
+    Vec3  normal;
+    float u;
+    float v;
+};
+
+} // namespace
+
+TEST_CASE("Streams gather and scatter through strided views",
+          "[streams]") {
+    std::vector<Vertex> vertices;
+    for(int i = 0; i < 11; ++i) {
+        float f = static_cast<float>(i);
+        vertices.push_back({Vec3(f, -f, 2.0f * f), Vec3(0.0f, 1.0f, 0.0f),
+                            f, 1.0f - f});
+    }
+
+    Vec3View positions(std::span<Vertex>(vertices), &Vertex::position);
+    REQUIRE(positions.size() == 11);
+    REQUIRE(positions.get(3) == Vec3(3.0f, -3.0f, 6.0f));
+
+    Vec3Stream stream;
+    stream.gather(positions);
+    REQUIRE(stream.size() == 11);
+    REQUIRE(stream.get(10) == Vec3(10.0f, -10.0f, 20.0f));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(stream.x().data()) %
+            Vec3Stream::alignment == 0);
+
+    stream += Vec3(1.0f, 1.0f, 1.0f);
+    stream.scatter(positions);
+
+    // Only the positions move; the rest of each vertex is left alone.
+    REQUIRE(vertices[4].position == Vec3(5.0f, -3.0f, 9.0f));
+    REQUIRE(vertices[4].normal == Vec3(0.0f, 1.0f, 0.0f));
+    REQUIRE(vertices[4].u == 4.0f);
+
+    std::vector<Vec3> flat(11);
+    stream.scatter(std::span<Vec3>(flat));
+    REQUIRE(flat[4] == vertices[4].position);
+}
+
+TEST_CASE("Stream operations match the Vec3 ones", "[streams]") {
+    std::vector<Vec3> a = make_vectors(37);
+    std::vector<Vec3> b = make_vectors(40);
+    std::reverse(b.begin(), b.end());
+    b.resize(a.size());
+
+    Vec3Stream sa(a);
+    Vec3Stream sb(b);
+
+    std::vector<float> dots(a.size());
+    std::vector<float> lengths(a.size());
+    sa.dot(sb, dots);
+    sa.length(lengths);
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        if(dots[i] != Catch::Approx(a[i].dot(b[i])) ||
+           lengths[i] != Catch::Approx(a[i].length())) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+
+    Vec3Stream crossed = sa;
+    crossed.cross(sb);
+
+    Vec3Stream projected = sa;
+    projected.project_onto(sb);
+
+    Vec3Stream normalized = sa;
+    normalized.normalize();
+
+    Vec3Stream moved = sa;
+    moved.add_scaled(sb, 0.5f);
+
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        if(!(crossed.get(i) == a[i].cross(b[i])) ||
+           !(projected.get(i) == a[i].project_onto(b[i])) ||
+           !(normalized.get(i) == a[i].normalized()) ||
+           !(moved.get(i) == a[i] + b[i] * 0.5f)) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+
+    Vec3Stream fast = sa;
+    fast.normalize(Accuracy::low);
+
+    float worst = 0.0f;
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        worst = std::max(worst, std::abs(fast.get(i).length() - 1.0f));
+    }
+    REQUIRE(worst < 1e-3f);
+}
+
+TEST_CASE("Streams transform like Mat3 and Mat4 do", "[streams]") {
+    std::vector<Vec3> v = make_vectors(21);
+
+    Mat3 rotation = Mat3::populate_rotation(0.3f, -1.1f, 0.7f);
+
+    Mat4 world = Mat4::identity;
+    world._m[0][3] = 5.0f;
+    world._m[1][3] = -2.0f;
+    world._m[2][3] = 1.5f;
+    world._m[0][0] = 2.0f;
+
+    Vec3Stream rotated(v);
+    Vec3Stream directions(v);
+    Vec3Stream points(v);
+    rotated.transform(rotation);
+    directions.transform(world);
+    points.transform_points(world);
+
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        Point3 p = world * Point3(v[i]._x, v[i]._y, v[i]._z);
+        if(!(rotated.get(i) == rotation * v[i]) ||
+           !(directions.get(i) == world * v[i]) ||
+           !(points.get(i) == Vec3(p))) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Every kernel tier the CPU runs matches the scalar one",
+          "[streams]") {
+    REQUIRE(cpu::selected() <= cpu::supported());
+    REQUIRE(kernels::active().isa == cpu::selected());
+
+    // Odd length so the vector loops' remainders get exercised too.
+    std::vector<Vec3> v = make_vectors(77);
+    const float m[3][4] = {
+        { 0.8f, -0.6f, 0.0f,  5.0f},
+        { 0.6f,  0.8f, 0.0f, -2.0f},
+        { 0.0f,  0.0f, 1.0f,  1.5f}
+    };
+
+    auto run = [&](const kernels::Table &k) {
+        Vec3Stream a(v);
+        Vec3Stream b(v);
+        std::vector<float> out(v.size() * 2);
+
+        k.transform(a.x().data(), a.y().data(), a.z().data(), a.size(), m);
+        k.dot(a.x().data(), a.y().data(), a.z().data(),
+              b.x().data(), b.y().data(), b.z().data(), out.data(),
+              a.size());
+        k.add_scaled(a.x().data(), a.y().data(), a.z().data(),
+                     b.x().data(), b.y().data(), b.z().data(), 0.5f,
+                     a.size());
+        k.length(a.x().data(), a.y().data(), a.z().data(),
+                 out.data() + v.size(), a.size());
+        k.normalize_high(a.x().data(), a.y().data(), a.z().data(),
+                         a.size());
+        k.normalize_exact(b.x().data(), b.y().data(), b.z().data(),
+                          b.size());
+
+        for(std::size_t i = 0; i < v.size(); ++i) {
+            Vec3 p = a.get(i);
+            Vec3 q = b.get(i);
+            out.insert(out.end(), {p._x, p._y, p._z, q._x, q._y, q._z});
+        }
+        return out;
+    };
+
+    std::vector<float> expected = run(kernels::table(Isa::scalar));
+
+    for(Isa isa : {Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if(isa > cpu::supported()) {
+            continue;
+        }
+        INFO(cpu::name(isa));
+        // Kernels never contract into FMA, so results are bit for bit equal.
+        REQUIRE(run(kernels::table(isa)) == expected);
+    }
+}
+
+TEST_CASE("Stream throughput against arrays of Vec3",
+          "[streams][!benchmark][.]") {
+    constexpr std::size_t count = 1 << 20;
+
+    std::vector<Vec3> positions  = make_vectors(count);
+    std::vector<Vec3> velocities = make_vectors(count);
+
+    Vec3Stream stream_positions(positions);
+    Vec3Stream stream_velocities(velocities);
+    std::vector<float> out(count);
+
+    Mat4 world = Mat4::identity;
+    world._m[0][3] = 1.0f;
+
+    BENCHMARK("Vec3 integrate") {
+        for(std::size_t i = 0; i < count; ++i) {
+            positions[i] += velocities[i] * 0.016f;
+        }
+        return positions[count / 2]._x;
+    };
+
+    BENCHMARK("Vec3Stream integrate") {
+        stream_positions.add_scaled(stream_velocities, 0.016f);
+        return stream_positions.x()[count / 2];
+    };
+
+    BENCHMARK("Vec3 dot") {
+        for(std::size_t i = 0; i < count; ++i) {
+            out[i] = positions[i].dot(velocities[i]);
+        }
+        return out[count / 2];
+    };
+
+    BENCHMARK("Vec3Stream dot") {
+        stream_positions.dot(stream_velocities, out);
+        return out[count / 2];
+    };
+
+    BENCHMARK("Vec3 normalize") {
+        for(std::size_t i = 0; i < count; ++i) {
+            velocities[i] = velocities[i].normalized();
+        }
+        return velocities[count / 2]._x;
+    };
+
+    BENCHMARK("Vec3Stream normalize") {
+        stream_velocities.normalize();
+        return stream_velocities.x()[count / 2];
+    };
+
+    BENCHMARK("Vec3 transform") {
+        for(std::size_t i = 0; i < count; ++i) {
+            Point3 p = world * Point3(positions[i]._x, positions[i]._y,
+                                      positions[i]._z);
+            positions[i] = Vec3(p);
+        }
+        return positions[count / 2]._x;
+    };
+
+    BENCHMARK("Vec3Stream transform") {
+        stream_positions.transform_points(world);
+        return stream_positions.x()[count / 2];
+    };
+
+    BENCHMARK("gather and scatter") {
+        stream_positions.gather(positions);
+        stream_positions.scatter(std::span<Vec3>(positions));
+        return positions[count / 2]._x;
+    };
+}
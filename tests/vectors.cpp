@@ -1,7 +1,14 @@
 #include "pdmath/Vector3.hpp"
 #include "pdmath/Vector4.hpp"
+#include "pdmath/Vector.hpp"
+#include "pdmath/VecExpr.hpp"
 #include "pdmath/util.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/catch_approx.hpp"
 
@@ -93,6 +100,24 @@ TEST_CASE("Normalized vectors have length 1", "[vectors]") {
     REQUIRE(b.length() == Catch::Approx(1.0f).margin(float_epsilon));
 }
 
+TEST_CASE("Vectors normalize at a chosen accuracy", "[vectors]") {
+    Vec3 v(1.0f, -2.0f, 5.0f);
+
+    REQUIRE(v.normalized(Accuracy::exact) == v.normalized());
+    REQUIRE(v.normalized(Accuracy::high).length() ==
+            Catch::Approx(1.0f).margin(1.0e-5f));
+    REQUIRE(v.normalized(Accuracy::low).length() ==
+            Catch::Approx(1.0f).margin(1.0e-3f));
+
+    std::vector<Vec3> batch{Vec3(3.0f, 0.0f, 4.0f), Vec3(-5.0f, -5.0f, 3.0f),
+                            Vec3(0.0f, 0.1f, 0.0f)};
+    Vec3::normalize(batch, Accuracy::high);
+
+    REQUIRE(batch[0] == Vec3(0.6f, 0.0f, 0.8f));
+    REQUIRE(batch[1].length() == Catch::Approx(1.0f).margin(1.0e-5f));
+    REQUIRE(batch[2] == Vec3(0.0f, 1.0f, 0.0f));
+}
+
 TEST_CASE("Projected vectors are correct", "[vectors]") {
     Vec3 v(-2, 1, -2);
     Vec3 w(-4, 3, -1);
@@ -168,3 +193,109 @@ TEST_CASE("Scalar multiples of vectors are collinear", "[vectors]") {
     REQUIRE(u.is_collinear(v));
 
 }
+
+TEST_CASE("Generic vectors work for any component type", "[vectors]") {
+    constexpr Vec3i a(1, 2, 3);
+    constexpr Vec3i b(-4, 0, 2);
+
+    static_assert(a.dot(b) == 2);
+    static_assert(a.cross(b) == Vec3i(4, -14, 8));
+    static_assert(a + b == Vec3i(-3, 2, 5));
+    static_assert(2 * a == Vec3i(2, 4, 6));
+
+    Vec4f u(1.0f, 2.0f, 3.0f, 4.0f);
+    Vec4f v(0.5f, -1.0f, 2.0f, 0.0f);
+
+    REQUIRE(u + v == Vec4f(1.5f, 1.0f, 5.0f, 4.0f));
+    REQUIRE(u - v == Vec4f(0.5f, 3.0f, 1.0f, 4.0f));
+    REQUIRE(u * 2.0f == Vec4f(2.0f, 4.0f, 6.0f, 8.0f));
+    REQUIRE(u.dot(v) == Catch::Approx(4.5f));
+
+    Vec4d w(1.0, 2.0, 2.0, 0.0);
+    REQUIRE(w.length() == Catch::Approx(3.0));
+    REQUIRE((w + Vec4d(u)) == Vec4d(2.0, 4.0, 5.0, 4.0));
+    REQUIRE((w - Vec4d(v)) == Vec4d(0.5, 3.0, 0.0, 0.0));
+    REQUIRE(w * 0.5 == Vec4d(0.5, 1.0, 1.0, 0.0));
+    REQUIRE(w.dot(Vec4d(u)) == Catch::Approx(11.0));
+    REQUIRE(-w == Vec4d(-1.0, -2.0, -2.0, -0.0));
+
+    Vec3 old(1.0f, -2.0f, 5.0f);
+    REQUIRE(to_vec3(to_vec(old)) == old);
+    REQUIRE(to_vec(old).cross(to_vec(Vec3(0.0f, 1.0f, 0.0f))) ==
+            to_vec(old.cross(Vec3(0.0f, 1.0f, 0.0f))));
+}
+
+TEST_CASE("Lazy expressions match the eager operators", "[vectors]") {
+    using namespace pdm::expr;
+
+    // Rodrigues, as in the homework: rotate z_vec about the up axis.
+    Vec3 z_vec(-1.0f, -3.236068f, 2.618034f);
+    Vec3 axis = Vec3(0.0f, 1.0f, 0.0f);
+
+    float theta     = std::numbers::pi_v<float> / 5.0f;
+    float cos_theta = std::cos(theta);
+    float sin_theta = std::sin(theta);
+
+    Vec3 eager = z_vec * cos_theta + axis.cross(z_vec) * sin_theta +
+                 axis * axis.dot(z_vec) * (1 - cos_theta);
+
+    auto k = lazy(axis);
+    auto v = lazy(z_vec);
+    Vec3 fused = eval(v * cos_theta + cross(k, v) * sin_theta +
+                      k * (dot(k, v) * (1 - cos_theta)));
+
+    REQUIRE(fused == eager);
+    REQUIRE(eval(dot(k, v)) == axis.dot(z_vec));
+    REQUIRE(eval(-(v - k) / 2.0f) == (axis - z_vec) / 2.0f);
+
+    Vec3f g(1.0f, 2.0f, 3.0f);
+    REQUIRE(eval(lazy(g) * 2.0f + lazy(g)) == Vec3f(3.0f, 6.0f, 9.0f));
+}
+
+TEST_CASE("Lazy expressions evaluate over arrays in place", "[vectors]") {
+    using namespace pdm::expr;
+
+    std::vector<Vec3>  points;
+    std::vector<float> angles;
+    for(int i = 0; i < 37; ++i) {
+        float f = static_cast<float>(i);
+        points.emplace_back(f * 0.5f - 4.0f, std::sin(f), 3.0f - f * 0.25f);
+        angles.push_back(f * 0.1f);
+    }
+
+    std::vector<float> cosines(angles.size());
+    std::vector<float> sines(angles.size());
+    for(std::size_t i = 0; i < angles.size(); ++i) {
+        cosines[i] = std::cos(angles[i]);
+        sines[i]   = std::sin(angles[i]);
+    }
+
+    Vec3 axis = Vec3(1.0f, 2.0f, -2.0f).normalized();
+
+    std::vector<Vec3> expected;
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        const Vec3 &p = points[i];
+        expected.push_back(p * cosines[i] + axis.cross(p) * sines[i] +
+                           axis * axis.dot(p) * (1 - cosines[i]));
+    }
+
+    // Rotate every point by its own angle, writing over the input.
+    auto k = lazy(axis);
+    auto v = lazy(std::span<const Vec3>(points));
+    auto c = lazy(std::span<const float>(cosines));
+    auto s = lazy(std::span<const float>(sines));
+    assign(std::span<Vec3>(points),
+           v * c + cross(k, v) * s + k * (dot(k, v) * (1.0f - c)));
+
+    // The fused chain groups k * (dot * (1 - c)) differently, so allow for
+    // a few ulps on the larger points.
+    float worst = 0.0f;
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        worst = std::max(worst, (points[i] - expected[i]).length());
+    }
+    REQUIRE(worst < 1e-5f);
+
+    std::vector<float> lengths(points.size());
+    assign(std::span<float>(lengths), dot(v, v));
+    REQUIRE(lengths[5] == Catch::Approx(points[5].dot(points[5])));
+}